@@ -162,3 +162,53 @@ double bench_hash(BMK_benchFn_t hashfn,
                                nbBlocks, sizef, size,
                                total_time_ms, iter_time_ms);
 }
+
+
+double bench_hash_batch(BMK_benchFn_t batchfn,
+                        size_t keySize, size_t nbKeys,
+                        unsigned total_time_ms, unsigned iter_time_ms)
+{
+    BMK_timedFnState_shell shell;
+    BMK_timedFnState_t* const txf = BMK_initStatic_timedFnState(&shell, sizeof(shell), total_time_ms, iter_time_ms);
+    assert(txf != NULL);
+
+    assert(keySize > 0);
+    assert(nbKeys > 0);
+    size_t srcSize = keySize * nbKeys;
+    void* const srcBuffer = malloc(srcSize);
+    assert(srcBuffer != NULL);
+    initBuffer(srcBuffer, srcSize);
+    size_t dstCapacity = nbKeys * sizeof(unsigned long long);
+    void* const dstBuffer = malloc(dstCapacity);
+    assert(dstBuffer != NULL);
+
+    const void* srcBuffers[1] = { srcBuffer };
+    void* dstBuffers[1] = { dstBuffer };
+
+    BMK_benchParams_t params = {
+        .benchFn = batchfn,
+        .benchPayload = &keySize,
+        .initFn = NULL,
+        .initPayload = NULL,
+        .errorFn = NULL,
+        .blockCount = 1,
+        .srcBuffers = srcBuffers,
+        .srcSizes = &srcSize,
+        .dstBuffers = dstBuffers,
+        .dstCapacities = &dstCapacity,
+        .blockResults = NULL
+    };
+    BMK_runOutcome_t result;
+
+    while (!BMK_isCompleted_TimedFn(txf)) {
+        result = BMK_benchTimedFn(txf, params);
+        assert(BMK_isSuccessful_runOutcome(result));
+    }
+
+    BMK_runTime_t const runTime = BMK_extract_runTime(result);
+
+    free(srcBuffer);
+    free(dstBuffer);
+    assert(runTime.nanoSecPerRun != 0);
+    return (1000000000U / runTime.nanoSecPerRun) * nbKeys;
+}
@@ -58,6 +58,17 @@ double bench_hash(BMK_benchFn_t hashfn,
                   size_t size, BMK_sizeMode sizeMode,
                   unsigned total_time_ms, unsigned iter_time_ms);
 
+/*
+ * bench_hash_batch():
+ * Benchmarks a hash function processing `nbKeys` contiguous keys of `keySize` bytes per call.
+ * `batchfn` receives all keys as `src`, room for one 64-bit result per key as `dst`,
+ * and a pointer to `keySize` as `customPayload`.
+ * Returns speed expressed as nb keys hashed per second.
+ */
+double bench_hash_batch(BMK_benchFn_t batchfn,
+                        size_t keySize, size_t nbKeys,
+                        unsigned total_time_ms, unsigned iter_time_ms);
+
 
 
 #if defined (__cplusplus)
@@ -157,3 +157,25 @@ void bench_latency_randomInputLength(Bench_Entry const* hashDescTable, int nbHas
     for (int i=0; i<nbHashes; i++)
         bench_latency_oneHash_randomInputLength(hashDescTable[i], size_min, size_max);
 }
+
+
+/* ===   Batches of small keys of fixed size   === */
+
+#define BENCH_BATCH_NBKEYS 1000
+static void bench_throughput_oneHash_batchInputs(Bench_Entry batchDesc, size_t size_min, size_t size_max)
+{
+    printf("%-7s", batchDesc.name);
+    for (size_t s=size_min; s<size_max+1; s++) {
+        double const nbkps = bench_hash_batch(batchDesc.hash, s, BENCH_BATCH_NBKEYS,
+                                              BENCH_SMALL_TOTAL_MS, BENCH_SMALL_ITER_MS);
+        printf(",%10.0f", nbkps); fflush(NULL);
+    }
+    printf("\n");
+}
+
+void bench_throughput_batchInputs(Bench_Entry const* batchDescTable, int nbHashes, size_t size_min, size_t size_max)
+{
+    printf("Throughput for batches of %i small keys of fixed size (keys/s) : \n", BENCH_BATCH_NBKEYS);
+    for (int i=0; i<nbHashes; i++)
+        bench_throughput_oneHash_batchInputs(batchDescTable[i], size_min, size_max);
+}
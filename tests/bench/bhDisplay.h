@@ -52,6 +52,8 @@ void bench_throughput_randomInputLength(Bench_Entry const* hashDescTable, int nb
 void bench_latency_smallInputs(Bench_Entry const* hashDescTable, int nbHashes, size_t sizeMin, size_t sizeMax);
 void bench_latency_randomInputLength(Bench_Entry const* hashDescTable, int nbHashes, size_t sizeMin, size_t sizeMax);
 
+void bench_throughput_batchInputs(Bench_Entry const* batchDescTable, int nbHashes, size_t sizeMin, size_t sizeMax);
+
 
 
 #if defined (__cplusplus)
@@ -80,6 +80,22 @@ size_t XXH64_wrapper(const void* src, size_t srcSize, void* dst, size_t dstCapac
 }
 
 
+/* XXH32 single-stream kernels, as selected by xxh_x86dispatch.c */
+size_t XXH32_scalar_wrapper(const void* src, size_t srcSize, void* dst, size_t dstCapacity, void* customPayload)
+{
+    (void)dst; (void)dstCapacity; (void)customPayload;
+    return (size_t) XXH32_stripes_internal((const xxh_u8*)src, srcSize, 0, XXH32_stripes_scalar);
+}
+
+#if (XXH_VECTOR == XXH_AVX2)
+size_t XXH32_avx2_wrapper(const void* src, size_t srcSize, void* dst, size_t dstCapacity, void* customPayload)
+{
+    (void)dst; (void)dstCapacity; (void)customPayload;
+    return (size_t) XXH32_stripes_internal((const xxh_u8*)src, srcSize, 0, XXH32_stripes_avx2);
+}
+#endif
+
+
 size_t xxh3_wrapper(const void* src, size_t srcSize, void* dst, size_t dstCapacity, void* customPayload)
 {
     (void)dst; (void)dstCapacity; (void)customPayload;
@@ -95,16 +111,50 @@ size_t XXH128_wrapper(const void* src, size_t srcSize, void* dst, size_t dstCapa
 
 
 
+/* ===  Batches of keys  === */
+/*
+ * Batch wrappers hash `srcSize / keySize` contiguous keys, with `keySize`
+ * provided through `customPayload`, and write one 64-bit result per key into `dst`.
+ */
+
+size_t xxh3_perKey_wrapper(const void* src, size_t srcSize, void* dst, size_t dstCapacity, void* customPayload)
+{
+    size_t const keySize = *(const size_t*)customPayload;
+    size_t const nbKeys = srcSize / keySize;
+    XXH64_hash_t* const hashes = (XXH64_hash_t*)dst;
+    (void)dstCapacity;
+    for (size_t n = 0; n < nbKeys; n++)
+        hashes[n] = XXH3_64bits((const char*)src + n*keySize, keySize);
+    return (size_t) hashes[0];
+}
+
+
+size_t xxh3_batch_wrapper(const void* src, size_t srcSize, void* dst, size_t dstCapacity, void* customPayload)
+{
+    size_t const keySize = *(const size_t*)customPayload;
+    XXH64_hash_t* const hashes = (XXH64_hash_t*)dst;
+    (void)dstCapacity;
+    XXH3_64bits_batch(hashes, src, keySize, srcSize / keySize);
+    return (size_t) hashes[0];
+}
+
+
 /* ==================================================
  * Table of hashes
  * =============================================== */
 
 #include "bhDisplay.h"   /* Bench_Entry */
 
+#if (XXH_VECTOR == XXH_AVX2)
+#  define NB_XXH32_KERNELS 2
+#else
+#  define NB_XXH32_KERNELS 1
+#endif
+
 #ifndef HARDWARE_SUPPORT
-#  define NB_HASHES 4
+#  define NB_HASHES (4 + NB_XXH32_KERNELS)
 #else
-#  define NB_HASHES 4
+#  define NB_HASHES (4 + NB_XXH32_KERNELS)
 #endif
 
 Bench_Entry const hashCandidates[NB_HASHES] = {
@@ -112,7 +162,19 @@ Bench_Entry const hashCandidates[NB_HASHES] = {
     { "XXH32" , XXH32_wrapper },
     { "XXH64" , XXH64_wrapper },
     { "XXH128", XXH128_wrapper },
+    { "XXH32_scalar", XXH32_scalar_wrapper },
+#if (XXH_VECTOR == XXH_AVX2)
+    { "XXH32_avx2", XXH32_avx2_wrapper },
+#endif
 #ifdef HARDWARE_SUPPORT
     /* list here codecs which require specific hardware support, such SSE4.1, PCLMUL, AVX2, etc. */
 #endif
 };
+
+
+#define NB_BATCH_HASHES 2
+
+Bench_Entry const batchCandidates[NB_BATCH_HASHES] = {
+    { "xxh3"  , xxh3_perKey_wrapper },   /* reference: one XXH3_64bits() call per key */
+    { "xxh3b" , xxh3_batch_wrapper },
+};
@@ -214,6 +214,7 @@ int main(int argc, const char** argv)
         bench_throughput_randomInputLength(hashCandidates+hashNb, nb_h_test, smallTest_size_min, smallTest_size_max);
         bench_latency_smallInputs(hashCandidates+hashNb, nb_h_test, smallTest_size_min, smallTest_size_max);
         bench_latency_randomInputLength(hashCandidates+hashNb, nb_h_test, smallTest_size_min, smallTest_size_max);
+        bench_throughput_batchInputs(batchCandidates, NB_BATCH_HASHES, smallTest_size_min, smallTest_size_max);
     }
 
     return 0;
@@ -720,17 +720,18 @@ XXH3_len_1to3_64b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_h
     }
 }
 
+/*
+ * The 4-8 and 9-16 byte paths are split in two: reading the input, then mixing
+ * the words read. The mixing halves are shared with the integer hash functions,
+ * whose input is already in registers.
+ */
 XXH_FORCE_INLINE XXH64_hash_t
-XXH3_len_4to8_64b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
+XXH3_mix4to8_64b(xxh_u64 input64, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
 {
-    XXH_ASSERT(input != NULL);
     XXH_ASSERT(secret != NULL);
-    XXH_ASSERT(4 <= len && len < 8);
+    XXH_ASSERT(4 <= len && len <= 8);
     seed ^= (xxh_u64)XXH_swap32((xxh_u32)seed) << 32;
-    {   xxh_u32 const input1 = XXH_readLE32(input);
-        xxh_u32 const input2 = XXH_readLE32(input + len - 4);
-        xxh_u64 const bitflip = (XXH_readLE64(secret+8) ^ XXH_readLE64(secret+16)) - seed;
-        xxh_u64 const input64 = input2 + (((xxh_u64)input1) << 32);
+    {   xxh_u64 const bitflip = (XXH_readLE64(secret+8) ^ XXH_readLE64(secret+16)) - seed;
         xxh_u64 x = input64 ^ bitflip;
         /* this mix is inspired by Pelle Evensen's rrmxmx */
         x ^= XXH_rotl64(x, 49) ^ XXH_rotl64(x, 24);
@@ -742,22 +743,42 @@ XXH3_len_4to8_64b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_h
 }
 
 XXH_FORCE_INLINE XXH64_hash_t
-XXH3_len_9to16_64b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
+XXH3_len_4to8_64b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
 {
     XXH_ASSERT(input != NULL);
     XXH_ASSERT(secret != NULL);
-    XXH_ASSERT(8 <= len && len <= 16);
+    XXH_ASSERT(4 <= len && len <= 8);
+    {   xxh_u32 const input1 = XXH_readLE32(input);
+        xxh_u32 const input2 = XXH_readLE32(input + len - 4);
+        xxh_u64 const input64 = input2 + (((xxh_u64)input1) << 32);
+        return XXH3_mix4to8_64b(input64, len, secret, seed);
+    }
+}
+
+/* @input_lo and @input_hi are the first and last 8 bytes of the input */
+XXH_FORCE_INLINE XXH64_hash_t
+XXH3_mix9to16_64b(xxh_u64 input_lo, xxh_u64 input_hi, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
+{
+    XXH_ASSERT(secret != NULL);
     {   xxh_u64 const bitflip1 = (XXH_readLE64(secret+24) ^ XXH_readLE64(secret+32)) + seed;
         xxh_u64 const bitflip2 = (XXH_readLE64(secret+40) ^ XXH_readLE64(secret+48)) - seed;
-        xxh_u64 const input_lo = XXH_readLE64(input)           ^ bitflip1;
-        xxh_u64 const input_hi = XXH_readLE64(input + len - 8) ^ bitflip2;
+        xxh_u64 const lo = input_lo ^ bitflip1;
+        xxh_u64 const hi = input_hi ^ bitflip2;
         xxh_u64 const acc = len
-                          + XXH_swap64(input_lo) + input_hi
-                          + XXH3_mul128_fold64(input_lo, input_hi);
+                          + XXH_swap64(lo) + hi
+                          + XXH3_mul128_fold64(lo, hi);
         return XXH3_avalanche(acc);
     }
 }
 
+XXH_FORCE_INLINE XXH64_hash_t
+XXH3_len_9to16_64b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
+{
+    XXH_ASSERT(input != NULL);
+    XXH_ASSERT(8 <= len && len <= 16);
+    return XXH3_mix9to16_64b(XXH_readLE64(input), XXH_readLE64(input + len - 8), len, secret, seed);
+}
+
 XXH_FORCE_INLINE XXH64_hash_t
 XXH3_len_0to16_64b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
 {
@@ -923,13 +944,12 @@ XXH3_len_129to240_64b(const xxh_u8* XXH_RESTRICT input, size_t len,
 #  define ACC_NB XXH_ACC_NB
 #endif
 
-typedef enum { XXH3_acc_64bits, XXH3_acc_128bits } XXH3_accWidth_e;
-
-XXH_FORCE_INLINE void XXH_writeLE64(void* dst, xxh_u64 v64)
-{
-    if (!XXH_CPU_LITTLE_ENDIAN) v64 = XXH_swap64(v64);
-    memcpy(dst, &v64, sizeof(v64));
-}
+/*
+ * XXH3_acc_dual: both widths at once, for XXH3_dual().
+ * `acc` then holds 2 sets of XXH_ACC_NB accumulators: 64-bit ones, then 128-bit ones.
+ * The input and the product are loaded and computed once for both sets.
+ */
+typedef enum { XXH3_acc_64bits, XXH3_acc_128bits, XXH3_acc_dual } XXH3_accWidth_e;
 
 /* Several intrinsic functions below are supposed to accept __int64 as argument,
  * as documented in https://software.intel.com/sites/landingpage/IntrinsicsGuide/ .
@@ -1001,6 +1021,10 @@ XXH3_accumulate_512_avx512(void* XXH_RESTRICT acc,
             __m512i const sum       = _mm512_add_epi64(*xacc, data_swap);
             /* xacc[0] += product; */
             *xacc = _mm512_add_epi64(product, sum);
+        } else if (accWidth == XXH3_acc_dual) {
+            __m512i const data_swap = _mm512_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+            xacc[0] = _mm512_add_epi64(product, _mm512_add_epi64(xacc[0], data_vec));
+            xacc[1] = _mm512_add_epi64(product, _mm512_add_epi64(xacc[1], data_swap));
         } else {  /* XXH3_acc_64bits */
             /* xacc[0] += data_vec; */
             __m512i const sum = _mm512_add_epi64(*xacc, data_vec);
@@ -1120,6 +1144,11 @@ XXH3_accumulate_512_avx2( void* XXH_RESTRICT acc,
                 __m256i const sum       = _mm256_add_epi64(xacc[i], data_swap);
                 /* xacc[i] += product; */
                 xacc[i] = _mm256_add_epi64(product, sum);
+            } else if (accWidth == XXH3_acc_dual) {
+                __m256i const data_swap = _mm256_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+                size_t const i128 = i + XXH_STRIPE_LEN/sizeof(__m256i);
+                xacc[i]    = _mm256_add_epi64(product, _mm256_add_epi64(xacc[i], data_vec));
+                xacc[i128] = _mm256_add_epi64(product, _mm256_add_epi64(xacc[i128], data_swap));
             } else {  /* XXH3_acc_64bits */
                 /* xacc[i] += data_vec; */
                 __m256i const sum = _mm256_add_epi64(xacc[i], data_vec);
@@ -1235,6 +1264,11 @@ XXH3_accumulate_512_sse2( void* XXH_RESTRICT acc,
                 __m128i const sum       = _mm_add_epi64(xacc[i], data_swap);
                 /* xacc[i] += product; */
                 xacc[i] = _mm_add_epi64(product, sum);
+            } else if (accWidth == XXH3_acc_dual) {
+                __m128i const data_swap = _mm_shuffle_epi32(data_vec, _MM_SHUFFLE(1,0,3,2));
+                size_t const i128 = i + XXH_STRIPE_LEN/sizeof(__m128i);
+                xacc[i]    = _mm_add_epi64(product, _mm_add_epi64(xacc[i], data_vec));
+                xacc[i128] = _mm_add_epi64(product, _mm_add_epi64(xacc[i128], data_swap));
             } else {  /* XXH3_acc_64bits */
                 /* xacc[i] += data_vec; */
                 __m128i const sum = _mm_add_epi64(xacc[i], data_vec);
@@ -1329,14 +1363,20 @@ XXH3_accumulate_512_neon( void* XXH_RESTRICT acc,
             uint8x16_t key_vec     = vld1q_u8(xsecret + (i * 16));
             uint64x2_t data_key;
             uint32x2_t data_key_lo, data_key_hi;
+            size_t const i128 = i + XXH_STRIPE_LEN / sizeof(uint64x2_t);
             if (accWidth == XXH3_acc_64bits) {
                 /* xacc[i] += data_vec; */
                 xacc[i] = vaddq_u64 (xacc[i], vreinterpretq_u64_u8(data_vec));
-            } else {  /* XXH3_acc_128bits */
+            } else if (accWidth == XXH3_acc_128bits) {
                 /* xacc[i] += swap(data_vec); */
                 uint64x2_t const data64  = vreinterpretq_u64_u8(data_vec);
                 uint64x2_t const swapped = vextq_u64(data64, data64, 1);
                 xacc[i] = vaddq_u64 (xacc[i], swapped);
+            } else {  /* XXH3_acc_dual */
+                uint64x2_t const data64  = vreinterpretq_u64_u8(data_vec);
+                uint64x2_t const swapped = vextq_u64(data64, data64, 1);
+                xacc[i]    = vaddq_u64 (xacc[i], data64);
+                xacc[i128] = vaddq_u64 (xacc[i128], swapped);
             }
             /* data_key = data_vec ^ key_vec; */
             data_key = vreinterpretq_u64_u8(veorq_u8(data_vec, key_vec));
@@ -1346,6 +1386,8 @@ XXH3_accumulate_512_neon( void* XXH_RESTRICT acc,
             XXH_SPLIT_IN_PLACE(data_key, data_key_lo, data_key_hi);
             /* xacc[i] += (uint64x2_t) data_key_lo * (uint64x2_t) data_key_hi; */
             xacc[i] = vmlal_u32 (xacc[i], data_key_lo, data_key_hi);
+            if (accWidth == XXH3_acc_dual)
+                xacc[i128] = vmlal_u32 (xacc[i128], data_key_lo, data_key_hi);
 
         }
     }
@@ -1433,14 +1475,20 @@ XXH3_accumulate_512_vsx(  void* XXH_RESTRICT acc,
 
         if (accWidth == XXH3_acc_64bits) {
             xacc[i] += data_vec;
-        } else {  /* XXH3_acc_128bits */
+        } else {  /* XXH3_acc_128bits, XXH3_acc_dual */
             /* swap high and low halves */
 #ifdef __s390x__
             xxh_u64x2 const data_swapped = vec_permi(data_vec, data_vec, 2);
 #else
             xxh_u64x2 const data_swapped = vec_xxpermdi(data_vec, data_vec, 2);
 #endif
-            xacc[i] += data_swapped;
+            if (accWidth == XXH3_acc_dual) {
+                size_t const i128 = i + XXH_STRIPE_LEN / sizeof(xxh_u64x2);
+                xacc[i]    += data_vec;
+                xacc[i128] += product + data_swapped;
+            } else {
+                xacc[i] += data_swapped;
+            }
         }
     }
 }
@@ -1494,12 +1542,18 @@ XXH3_accumulate_512_scalar(void* XXH_RESTRICT acc,
         xxh_u64 const data_val = XXH_readLE64(xinput + 8*i);
         xxh_u64 const data_key = data_val ^ XXH_readLE64(xsecret + i*8);
 
+        xxh_u64 const product  = XXH_mult32to64(data_key & 0xFFFFFFFF, data_key >> 32);
+
         if (accWidth == XXH3_acc_64bits) {
             xacc[i] += data_val;
-        } else {
+        } else if (accWidth == XXH3_acc_128bits) {
             xacc[i ^ 1] += data_val; /* swap adjacent lanes */
+        } else {  /* XXH3_acc_dual */
+            xacc[i] += data_val;
+            xacc[XXH_ACC_NB + (i ^ 1)] += data_val;
+            xacc[XXH_ACC_NB + i] += product;
         }
-        xacc[i] += XXH_mult32to64(data_key & 0xFFFFFFFF, data_key >> 32);
+        xacc[i] += product;
     }
 }
 
@@ -1676,7 +1730,11 @@ XXH3_hashLong_internal_loop(xxh_u64* XXH_RESTRICT acc,
 {
     size_t const nb_rounds = (secretSize - XXH_STRIPE_LEN) / XXH_SECRET_CONSUME_RATE;
     size_t const block_len = XXH_STRIPE_LEN * nb_rounds;
-    size_t const nb_blocks = len / block_len;
+    /*
+     * Inputs shorter than a block (241-1023 bytes with the default secret)
+     * skip the division, which is not a constant with a custom secret.
+     */
+    size_t const nb_blocks = (len < block_len) ? 0 : len / block_len;
 
     size_t n;
 
@@ -1685,6 +1743,7 @@ XXH3_hashLong_internal_loop(xxh_u64* XXH_RESTRICT acc,
     for (n = 0; n < nb_blocks; n++) {
         XXH3_accumulate(acc, input + n*block_len, secret, nb_rounds, accWidth, f_acc512);
         f_scramble(acc, secret + secretSize - XXH_STRIPE_LEN);
+        if (accWidth == XXH3_acc_dual) f_scramble(acc + XXH_ACC_NB, secret + secretSize - XXH_STRIPE_LEN);
     }
 
     /* last partial block */
@@ -1872,871 +1931,5088 @@ XXH3_64bits_withSeed(const void* input, size_t len, XXH64_hash_t seed)
 }
 
 
-/* ===   XXH3 streaming   === */
+/* ===   XXH3 secret and seed   === */
 
 /*
- * Malloc's a pointer that is always aligned to align.
- *
- * This must be freed with `XXH_alignedFree()`.
- *
- * malloc typically guarantees 16 byte alignment on 64-bit systems and 8 byte
- * alignment on 32-bit. This isn't enough for the 32 byte aligned loads in AVX2
- * or on 32-bit, the 16 byte aligned loads in SSE2 and NEON.
- *
- * This underalignment previously caused a rather obvious crash which went
- * completely unnoticed due to XXH3_createState() not actually being tested.
- * Credit to RedSpah for noticing this bug.
+ * Short inputs use the seed, on top of the default secret,
+ * while long inputs use the secret, exactly like XXH3_64bits_withSecret().
+ * Neither path needs to derive anything from the seed.
+ */
+XXH_FORCE_INLINE XXH64_hash_t
+XXH3_64bits_withSecretandSeed_internal(const void* input, size_t len,
+                                       const void* secret, size_t secretSize, XXH64_hash_t seed,
+                                       XXH3_hashLong64_f f_hashLong)
+{
+    if (len <= XXH3_MIDSIZE_MAX)
+        return XXH3_64bits_internal(input, len, seed, XXH3_kSecret, sizeof(XXH3_kSecret), f_hashLong);
+    XXH_ASSERT(secretSize >= XXH3_SECRET_SIZE_MIN);
+    return f_hashLong((const xxh_u8*)input, len, seed, (const xxh_u8*)secret, secretSize);
+}
+
+XXH_PUBLIC_API XXH64_hash_t
+XXH3_64bits_withSecretandSeed(const void* input, size_t len, const void* secret, size_t secretSize, XXH64_hash_t seed)
+{
+    return XXH3_64bits_withSecretandSeed_internal(input, len, secret, secretSize, seed, XXH3_hashLong_64b_withSecret);
+}
+
+
+/* ===   XXH3 seeded context   === */
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_initSeededContext(XXH3_seededContext_t* ctx, XXH64_hash_t seed)
+{
+    if (ctx == NULL) return XXH_ERROR;
+    XXH_STATIC_ASSERT(sizeof(ctx->secret) == XXH_SECRET_DEFAULT_SIZE);
+    XXH3_initCustomSecret(ctx->secret, seed);
+    ctx->seed = seed;
+    return XXH_OK;
+}
+
+/*
+ * The derived secret is what XXH3_hashLong_64b_withSeed() would generate,
+ * so hashing with the secret and the seed is identical to XXH3_64bits_withSeed().
+ */
+XXH_PUBLIC_API XXH64_hash_t
+XXH3_64bits_withSeededContext(const void* input, size_t len, const XXH3_seededContext_t* ctx)
+{
+    XXH_ASSERT(ctx != NULL);
+    return XXH3_64bits_withSecretandSeed(input, len, ctx->secret, sizeof(ctx->secret), ctx->seed);
+}
+
+
+/* ===   XXH3 batch hashing   === */
+
+/*
+ * Batches of equal-length short keys.
  *
- * The alignment is done manually: Functions like posix_memalign or _mm_malloc
- * are avoided: To maintain portability, we would have to write a fallback
- * like this anyways, and besides, testing for the existence of library
- * functions without relying on external build tools is impossible.
+ * XXH3's short-input paths (up to XXH3_MIDSIZE_MAX bytes) are a handful of
+ * 64-bit multiplies on a single key, so the vector units sit idle. When many
+ * keys of the same length are hashed back to back (hash joins, dedup), they can
+ * instead be hashed side by side, one key per 64-bit SIMD lane.
  *
- * The method is simple: Overallocate, manually align, and store the offset
- * to the original behind the returned pointer.
+ * The lane kernels below process 8 keys per call, mirroring the 64-byte stripe
+ * width of XXH3_accumulate_512. As all keys share the same length, every lane
+ * follows the same control flow, and the only scalar work left is gathering
+ * each lane's input words.
  *
- * Align must be a power of 2 and 8 <= align <= 128.
+ * x86 has no 64x64->128 multiply in SIMD, so XXH3_mul128_fold64 is emulated
+ * with four 32x32->64 PMULUDQ, exactly like the portable XXH_mult64to128.
+ * This only pays off with 8 lanes per register: on SSE2 and AVX2, the
+ * emulation costs more than a scalar MULQ per key, so these targets use the
+ * scalar kernel instead.
+ * The result is bit-identical to XXH3_64bits_withSeed().
  */
-static void* XXH_alignedMalloc(size_t s, size_t align)
+
+#define XXH3_BATCH_LANES 8
+
+/*
+ * The lanes of the 1-3 and 4-8 byte paths are built in scalar code:
+ * the loads are tiny and byte-granular, there is nothing to gain in SIMD.
+ */
+XXH_FORCE_INLINE xxh_u64
+XXH3_lanes_input1to3(const xxh_u8* input, size_t len)
 {
-    XXH_ASSERT(align <= 128 && align >= 8); /* range check */
-    XXH_ASSERT((align & (align-1)) == 0);   /* power of 2 */
-    XXH_ASSERT(s != 0 && s < (s + align));  /* empty/overflow */
-    {   /* Overallocate to make room for manual realignment and an offset byte */
-        xxh_u8* base = (xxh_u8*)XXH_malloc(s + align);
-        if (base != NULL) {
-            /*
-             * Get the offset needed to align this pointer.
-             *
-             * Even if the returned pointer is aligned, there will always be
-             * at least one byte to store the offset to the original pointer.
-             */
-            size_t offset = align - ((size_t)base & (align - 1)); /* base % align */
-            /* Add the offset for the now-aligned pointer */
-            xxh_u8* ptr = base + offset;
+    xxh_u8 const c1 = input[0];
+    xxh_u8 const c2 = input[len >> 1];
+    xxh_u8 const c3 = input[len - 1];
+    XXH_ASSERT(1 <= len && len <= 3);
+    return ((xxh_u32)c1 << 16) | ((xxh_u32)c2  << 24)
+         | ((xxh_u32)c3 <<  0) | ((xxh_u32)len << 8);
+}
 
-            XXH_ASSERT((size_t)ptr % align == 0);
+XXH_FORCE_INLINE xxh_u64
+XXH3_lanes_input4to8(const xxh_u8* input, size_t len)
+{
+    xxh_u32 const input1 = XXH_readLE32(input);
+    xxh_u32 const input2 = XXH_readLE32(input + len - 4);
+    XXH_ASSERT(4 <= len && len <= 8);
+    return input2 + (((xxh_u64)input1) << 32);
+}
 
-            /* Store the offset immediately before the returned pointer. */
-            ptr[-1] = (xxh_u8)offset;
-            return ptr;
-        }
-        return NULL;
-    }
+#if (XXH_VECTOR == XXH_AVX512) || defined(XXH_X86DISPATCH)
+
+/*
+ * With @shared, all lanes hash the same input, `inputs[0]`, which is loaded once
+ * and broadcast: the lanes then differ by their seed only.
+ */
+XXH_FORCE_INLINE XXH_TARGET_AVX512 __m512i
+XXH3_lanes_loadLE64_avx512(const xxh_u8* const* XXH_RESTRICT inputs, int shared, size_t offset)
+{
+    if (shared) return _mm512_set1_epi64((xxh_i64)XXH_readLE64(inputs[0] + offset));
+    return _mm512_set_epi64((xxh_i64)XXH_readLE64(inputs[7] + offset),
+                            (xxh_i64)XXH_readLE64(inputs[6] + offset),
+                            (xxh_i64)XXH_readLE64(inputs[5] + offset),
+                            (xxh_i64)XXH_readLE64(inputs[4] + offset),
+                            (xxh_i64)XXH_readLE64(inputs[3] + offset),
+                            (xxh_i64)XXH_readLE64(inputs[2] + offset),
+                            (xxh_i64)XXH_readLE64(inputs[1] + offset),
+                            (xxh_i64)XXH_readLE64(inputs[0] + offset));
 }
+
 /*
- * Frees an aligned pointer allocated by XXH_alignedMalloc(). Don't pass
- * normal malloc'd pointers, XXH_alignedMalloc has a specific data layout.
+ * Loads 16 bytes at @offset from each input with full-width loads,
+ * then transposes them into a vector of low halves and a vector of high halves.
  */
-static void XXH_alignedFree(void* p)
+XXH_FORCE_INLINE XXH_TARGET_AVX512 void
+XXH3_lanes_load16B_avx512(__m512i* XXH_RESTRICT lo, __m512i* XXH_RESTRICT hi,
+                          const xxh_u8* const* XXH_RESTRICT inputs, int shared, size_t offset)
 {
-    if (p != NULL) {
-        xxh_u8* ptr = (xxh_u8*)p;
-        /* Get the offset byte we added in XXH_malloc. */
-        xxh_u8 offset = ptr[-1];
-        /* Free the original malloc'd pointer */
-        xxh_u8* base = ptr - offset;
-        XXH_free(base);
+    __m512i even, odd;
+    if (shared) {
+        *lo = _mm512_set1_epi64((xxh_i64)XXH_readLE64(inputs[0] + offset));
+        *hi = _mm512_set1_epi64((xxh_i64)XXH_readLE64(inputs[0] + offset + 8));
+        return;
     }
+    even = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)(inputs[0] + offset)));
+    odd  = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)(inputs[1] + offset)));
+    even = _mm512_inserti32x4(even, _mm_loadu_si128((const __m128i*)(inputs[2] + offset)), 1);
+    odd  = _mm512_inserti32x4(odd,  _mm_loadu_si128((const __m128i*)(inputs[3] + offset)), 1);
+    even = _mm512_inserti32x4(even, _mm_loadu_si128((const __m128i*)(inputs[4] + offset)), 2);
+    odd  = _mm512_inserti32x4(odd,  _mm_loadu_si128((const __m128i*)(inputs[5] + offset)), 2);
+    even = _mm512_inserti32x4(even, _mm_loadu_si128((const __m128i*)(inputs[6] + offset)), 3);
+    odd  = _mm512_inserti32x4(odd,  _mm_loadu_si128((const __m128i*)(inputs[7] + offset)), 3);
+    /* even = { in0, in2, in4, in6 }, odd = { in1, in3, in5, in7 } */
+    *lo = _mm512_unpacklo_epi64(even, odd);
+    *hi = _mm512_unpackhi_epi64(even, odd);
 }
-XXH_PUBLIC_API XXH3_state_t* XXH3_createState(void)
+
+/* lo64(lhs * rhs) ^ hi64(lhs * rhs), see XXH_mult64to128() */
+XXH_FORCE_INLINE XXH_TARGET_AVX512 __m512i
+XXH3_lanes_mul128_fold64_avx512(__m512i lhs, __m512i rhs)
 {
-    return (XXH3_state_t*)XXH_alignedMalloc(sizeof(XXH3_state_t), 64);
+    __m512i const mask32 = _mm512_set1_epi64(0xFFFFFFFF);
+    __m512i const lhs_hi = _mm512_srli_epi64(lhs, 32);
+    __m512i const rhs_hi = _mm512_srli_epi64(rhs, 32);
+    __m512i const lo_lo  = _mm512_mul_epu32(lhs, rhs);
+    __m512i const hi_lo  = _mm512_mul_epu32(lhs_hi, rhs);
+    __m512i const lo_hi  = _mm512_mul_epu32(lhs, rhs_hi);
+    __m512i const hi_hi  = _mm512_mul_epu32(lhs_hi, rhs_hi);
+    __m512i const cross  = _mm512_add_epi64(_mm512_add_epi64(_mm512_srli_epi64(lo_lo, 32), _mm512_and_si512(hi_lo, mask32)), lo_hi);
+    __m512i const upper  = _mm512_add_epi64(_mm512_add_epi64(_mm512_srli_epi64(hi_lo, 32), _mm512_srli_epi64(cross, 32)), hi_hi);
+    __m512i const lower  = _mm512_or_si512(_mm512_slli_epi64(cross, 32), _mm512_and_si512(lo_lo, mask32));
+    return _mm512_xor_si512(lower, upper);
 }
 
-XXH_PUBLIC_API XXH_errorcode XXH3_freeState(XXH3_state_t* statePtr)
+/* x * prime, modulo 2^64 */
+XXH_FORCE_INLINE XXH_TARGET_AVX512 __m512i
+XXH3_lanes_mult64_avx512(__m512i x, xxh_u64 prime)
 {
-    XXH_alignedFree(statePtr);
-    return XXH_OK;
+    __m512i const prime_lo = _mm512_set1_epi64((xxh_i64)prime);
+    __m512i const prime_hi = _mm512_set1_epi64((xxh_i64)(prime >> 32));
+    __m512i const lo  = _mm512_mul_epu32(x, prime_lo);
+    __m512i const mid = _mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(x, 32), prime_lo), _mm512_mul_epu32(x, prime_hi));
+    return _mm512_add_epi64(lo, _mm512_slli_epi64(mid, 32));
 }
 
-XXH_PUBLIC_API void
-XXH3_copyState(XXH3_state_t* dst_state, const XXH3_state_t* src_state)
+XXH_FORCE_INLINE XXH_TARGET_AVX512 __m512i
+XXH3_lanes_avalanche_avx512(__m512i h64)
 {
-    memcpy(dst_state, src_state, sizeof(*dst_state));
+    h64 = _mm512_xor_si512(h64, _mm512_srli_epi64(h64, 37));
+    h64 = XXH3_lanes_mult64_avx512(h64, 0x165667919E3779F9ULL);
+    return _mm512_xor_si512(h64, _mm512_srli_epi64(h64, 32));
 }
 
-static void
-XXH3_64bits_reset_internal(XXH3_state_t* statePtr,
-                           XXH64_hash_t seed,
-                           const xxh_u8* secret, size_t secretSize)
+XXH_FORCE_INLINE XXH_TARGET_AVX512 __m512i
+XXH3_lanes_swap64_avx512(__m512i x)
 {
-    XXH_ASSERT(statePtr != NULL);
-    memset(statePtr, 0, sizeof(*statePtr));
-    statePtr->acc[0] = XXH_PRIME32_3;
-    statePtr->acc[1] = XXH_PRIME64_1;
-    statePtr->acc[2] = XXH_PRIME64_2;
-    statePtr->acc[3] = XXH_PRIME64_3;
-    statePtr->acc[4] = XXH_PRIME64_4;
-    statePtr->acc[5] = XXH_PRIME32_2;
-    statePtr->acc[6] = XXH_PRIME64_5;
-    statePtr->acc[7] = XXH_PRIME32_1;
-    statePtr->seed = seed;
-    XXH_ASSERT(secret != NULL);
-    statePtr->extSecret = secret;
-    XXH_ASSERT(secretSize >= XXH3_SECRET_SIZE_MIN);
-    statePtr->secretLimit = secretSize - XXH_STRIPE_LEN;
-    statePtr->nbStripesPerBlock = statePtr->secretLimit / XXH_SECRET_CONSUME_RATE;
+    /* AVX512F has no byte shuffle: swap bytes within 32-bit lanes, then swap the halves */
+    __m512i const swap32 = _mm512_or_si512(
+            _mm512_and_si512(_mm512_rol_epi32(x,  8), _mm512_set1_epi32(0x00FF00FF)),
+            _mm512_and_si512(_mm512_rol_epi32(x, 24), _mm512_set1_epi32((int)0xFF00FF00)));
+    return _mm512_rol_epi64(swap32, 32);
 }
 
-XXH_PUBLIC_API XXH_errorcode
-XXH3_64bits_reset(XXH3_state_t* statePtr)
+/* XXH3_mix4to8_64b(), one input word and one seed per lane */
+XXH_FORCE_INLINE XXH_TARGET_AVX512 __m512i
+XXH3_lanes_mix4to8_avx512(__m512i input64, size_t len, const xxh_u8* XXH_RESTRICT secret, __m512i seed)
 {
-    if (statePtr == NULL) return XXH_ERROR;
-    XXH3_64bits_reset_internal(statePtr, 0, XXH3_kSecret, XXH_SECRET_DEFAULT_SIZE);
-    return XXH_OK;
+    /* seed ^ (XXH_swap32((xxh_u32)seed) << 32) */
+    __m512i const seed4to8 = _mm512_xor_si512(seed, _mm512_and_si512(XXH3_lanes_swap64_avx512(seed),
+                                                                     _mm512_set1_epi64((xxh_i64)0xFFFFFFFF00000000ULL)));
+    __m512i const bitflip = _mm512_sub_epi64(_mm512_set1_epi64((xxh_i64)(XXH_readLE64(secret+8) ^ XXH_readLE64(secret+16))), seed4to8);
+    __m512i x = _mm512_xor_si512(input64, bitflip);
+    x = _mm512_xor_si512(x, _mm512_xor_si512(_mm512_rol_epi64(x, 49), _mm512_rol_epi64(x, 24)));
+    x = XXH3_lanes_mult64_avx512(x, 0x9FB21C651E98DF25ULL);
+    x = _mm512_xor_si512(x, _mm512_add_epi64(_mm512_srli_epi64(x, 35), _mm512_set1_epi64((xxh_i64)len)));
+    x = XXH3_lanes_mult64_avx512(x, 0x9FB21C651E98DF25ULL);
+    return _mm512_xor_si512(x, _mm512_srli_epi64(x, 28));
 }
 
-XXH_PUBLIC_API XXH_errorcode
-XXH3_64bits_reset_withSecret(XXH3_state_t* statePtr, const void* secret, size_t secretSize)
+/* XXH3_mix9to16_64b(), with the first and last 8 input bytes of each lane */
+XXH_FORCE_INLINE XXH_TARGET_AVX512 __m512i
+XXH3_lanes_mix9to16_avx512(__m512i input_lo, __m512i input_hi, size_t len, const xxh_u8* XXH_RESTRICT secret, __m512i seed)
 {
-    if (statePtr == NULL) return XXH_ERROR;
-    XXH3_64bits_reset_internal(statePtr, 0, (const xxh_u8*)secret, secretSize);
-    if (secret == NULL) return XXH_ERROR;
-    if (secretSize < XXH3_SECRET_SIZE_MIN) return XXH_ERROR;
-    return XXH_OK;
+    __m512i const bitflip1 = _mm512_add_epi64(_mm512_set1_epi64((xxh_i64)(XXH_readLE64(secret+24) ^ XXH_readLE64(secret+32))), seed);
+    __m512i const bitflip2 = _mm512_sub_epi64(_mm512_set1_epi64((xxh_i64)(XXH_readLE64(secret+40) ^ XXH_readLE64(secret+48))), seed);
+    __m512i const lo = _mm512_xor_si512(input_lo, bitflip1);
+    __m512i const hi = _mm512_xor_si512(input_hi, bitflip2);
+    __m512i const acc = _mm512_add_epi64(_mm512_add_epi64(_mm512_set1_epi64((xxh_i64)len), XXH3_lanes_swap64_avx512(lo)),
+                                         _mm512_add_epi64(hi, XXH3_lanes_mul128_fold64_avx512(lo, hi)));
+    return XXH3_lanes_avalanche_avx512(acc);
 }
 
-XXH_PUBLIC_API XXH_errorcode
-XXH3_64bits_reset_withSeed(XXH3_state_t* statePtr, XXH64_hash_t seed)
+XXH_FORCE_INLINE XXH_TARGET_AVX512 __m512i
+XXH3_lanes_mix16B_avx512(const xxh_u8* const* XXH_RESTRICT inputs, int shared, size_t offset,
+                         const xxh_u8* XXH_RESTRICT secret, __m512i seed)
 {
-    if (statePtr == NULL) return XXH_ERROR;
-    XXH3_64bits_reset_internal(statePtr, seed, XXH3_kSecret, XXH_SECRET_DEFAULT_SIZE);
-    XXH3_initCustomSecret(statePtr->customSecret, seed);
-    statePtr->extSecret = NULL;
-    return XXH_OK;
+    __m512i const key_lo = _mm512_add_epi64(_mm512_set1_epi64((xxh_i64)XXH_readLE64(secret)),   seed);
+    __m512i const key_hi = _mm512_sub_epi64(_mm512_set1_epi64((xxh_i64)XXH_readLE64(secret+8)), seed);
+    __m512i input_lo, input_hi;
+    XXH3_lanes_load16B_avx512(&input_lo, &input_hi, inputs, shared, offset);
+    return XXH3_lanes_mul128_fold64_avx512(_mm512_xor_si512(input_lo, key_lo),
+                                           _mm512_xor_si512(input_hi, key_hi));
 }
 
-XXH_FORCE_INLINE void
-XXH3_consumeStripes(xxh_u64* XXH_RESTRICT acc,
-                    size_t* XXH_RESTRICT nbStripesSoFarPtr, size_t nbStripesPerBlock,
-                    const xxh_u8* XXH_RESTRICT input, size_t nbStripes,
-                    const xxh_u8* XXH_RESTRICT secret, size_t secretLimit,
-                    XXH3_accWidth_e accWidth,
-                    XXH3_f_accumulate_512 f_acc512,
-                    XXH3_f_scrambleAcc f_scramble)
+/* hashes 8 inputs of @len bytes, or the same one if @shared, with one seed per 64-bit lane */
+XXH_FORCE_INLINE XXH_TARGET_AVX512 void
+XXH3_hashShort_lanes_avx512(xxh_u64* XXH_RESTRICT dst,
+                            const xxh_u8* const* XXH_RESTRICT inputs, int shared, size_t len,
+                            const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
+                            __m512i seed)
 {
-    XXH_ASSERT(nbStripes <= nbStripesPerBlock);  /* can handle max 1 scramble per invocation */
-    XXH_ASSERT(*nbStripesSoFarPtr < nbStripesPerBlock);
-    if (nbStripesPerBlock - *nbStripesSoFarPtr <= nbStripes) {
-        /* need a scrambling operation */
-        size_t const nbStripesToEndofBlock = nbStripesPerBlock - *nbStripesSoFarPtr;
-        size_t const nbStripesAfterBlock = nbStripes - nbStripesToEndofBlock;
-        XXH3_accumulate(acc, input, secret + nbStripesSoFarPtr[0] * XXH_SECRET_CONSUME_RATE, nbStripesToEndofBlock, accWidth, f_acc512);
-        f_scramble(acc, secret + secretLimit);
-        XXH3_accumulate(acc, input + nbStripesToEndofBlock * XXH_STRIPE_LEN, secret, nbStripesAfterBlock, accWidth, f_acc512);
-        *nbStripesSoFarPtr = nbStripesAfterBlock;
+    __m512i acc;
+    XXH_ASSERT(len <= XXH3_MIDSIZE_MAX);
+    XXH_ASSERT(secretSize >= XXH3_SECRET_SIZE_MIN); (void)secretSize;
+
+    if (len <= 16) {
+        if (len > 8) {
+            /* XXH3_len_9to16_64b */
+            acc = XXH3_lanes_mix9to16_avx512(XXH3_lanes_loadLE64_avx512(inputs, shared, 0),
+                                             XXH3_lanes_loadLE64_avx512(inputs, shared, len - 8),
+                                             len, secret, seed);
+        } else if (len >= 4) {
+            /* XXH3_len_4to8_64b */
+            __m512i const input64 = shared ? _mm512_set1_epi64((xxh_i64)XXH3_lanes_input4to8(inputs[0], len)) :
+                                    _mm512_set_epi64((xxh_i64)XXH3_lanes_input4to8(inputs[7], len),
+                                                     (xxh_i64)XXH3_lanes_input4to8(inputs[6], len),
+                                                     (xxh_i64)XXH3_lanes_input4to8(inputs[5], len),
+                                                     (xxh_i64)XXH3_lanes_input4to8(inputs[4], len),
+                                                     (xxh_i64)XXH3_lanes_input4to8(inputs[3], len),
+                                                     (xxh_i64)XXH3_lanes_input4to8(inputs[2], len),
+                                                     (xxh_i64)XXH3_lanes_input4to8(inputs[1], len),
+                                                     (xxh_i64)XXH3_lanes_input4to8(inputs[0], len));
+            acc = XXH3_lanes_mix4to8_avx512(input64, len, secret, seed);
+        } else if (len) {
+            /* XXH3_len_1to3_64b */
+            __m512i const combined = shared ? _mm512_set1_epi64((xxh_i64)XXH3_lanes_input1to3(inputs[0], len)) :
+                                     _mm512_set_epi64((xxh_i64)XXH3_lanes_input1to3(inputs[7], len),
+                                                      (xxh_i64)XXH3_lanes_input1to3(inputs[6], len),
+                                                      (xxh_i64)XXH3_lanes_input1to3(inputs[5], len),
+                                                      (xxh_i64)XXH3_lanes_input1to3(inputs[4], len),
+                                                      (xxh_i64)XXH3_lanes_input1to3(inputs[3], len),
+                                                      (xxh_i64)XXH3_lanes_input1to3(inputs[2], len),
+                                                      (xxh_i64)XXH3_lanes_input1to3(inputs[1], len),
+                                                      (xxh_i64)XXH3_lanes_input1to3(inputs[0], len));
+            __m512i const bitflip = _mm512_add_epi64(_mm512_set1_epi64((xxh_i64)(XXH_readLE32(secret) ^ XXH_readLE32(secret+4))), seed);
+            acc = XXH3_lanes_mult64_avx512(_mm512_xor_si512(combined, bitflip), XXH_PRIME64_1);
+            acc = XXH3_lanes_avalanche_avx512(acc);
+        } else {
+            acc = _mm512_xor_si512(_mm512_add_epi64(_mm512_set1_epi64((xxh_i64)XXH_PRIME64_1), seed),
+                                   _mm512_set1_epi64((xxh_i64)(XXH_readLE64(secret+56) ^ XXH_readLE64(secret+64))));
+            acc = XXH3_lanes_avalanche_avx512(acc);
+        }
+    } else if (len <= 128) {
+        /* XXH3_len_17to128_64b */
+        acc = _mm512_set1_epi64((xxh_i64)(len * XXH_PRIME64_1));
+        if (len > 32) {
+            if (len > 64) {
+                if (len > 96) {
+                    acc = _mm512_add_epi64(acc, XXH3_lanes_mix16B_avx512(inputs, shared, 48, secret+96, seed));
+                    acc = _mm512_add_epi64(acc, XXH3_lanes_mix16B_avx512(inputs, shared, len-64, secret+112, seed));
+                }
+                acc = _mm512_add_epi64(acc, XXH3_lanes_mix16B_avx512(inputs, shared, 32, secret+64, seed));
+                acc = _mm512_add_epi64(acc, XXH3_lanes_mix16B_avx512(inputs, shared, len-48, secret+80, seed));
+            }
+            acc = _mm512_add_epi64(acc, XXH3_lanes_mix16B_avx512(inputs, shared, 16, secret+32, seed));
+            acc = _mm512_add_epi64(acc, XXH3_lanes_mix16B_avx512(inputs, shared, len-32, secret+48, seed));
+        }
+        acc = _mm512_add_epi64(acc, XXH3_lanes_mix16B_avx512(inputs, shared, 0, secret+0, seed));
+        acc = _mm512_add_epi64(acc, XXH3_lanes_mix16B_avx512(inputs, shared, len-16, secret+16, seed));
+        acc = XXH3_lanes_avalanche_avx512(acc);
     } else {
-        XXH3_accumulate(acc, input, secret + nbStripesSoFarPtr[0] * XXH_SECRET_CONSUME_RATE, nbStripes, accWidth, f_acc512);
-        *nbStripesSoFarPtr += nbStripes;
+        /* XXH3_len_129to240_64b */
+        size_t const nbRounds = len / 16;
+        size_t i;
+        acc = _mm512_set1_epi64((xxh_i64)(len * XXH_PRIME64_1));
+        for (i = 0; i < 8; i++) {
+            acc = _mm512_add_epi64(acc, XXH3_lanes_mix16B_avx512(inputs, shared, 16*i, secret + 16*i, seed));
+        }
+        acc = XXH3_lanes_avalanche_avx512(acc);
+        for (i = 8; i < nbRounds; i++) {
+            acc = _mm512_add_epi64(acc, XXH3_lanes_mix16B_avx512(inputs, shared, 16*i, secret + 16*(i-8) + XXH3_MIDSIZE_STARTOFFSET, seed));
+        }
+        acc = _mm512_add_epi64(acc, XXH3_lanes_mix16B_avx512(inputs, shared, len-16, secret + XXH3_SECRET_SIZE_MIN - XXH3_MIDSIZE_LASTOFFSET, seed));
+        acc = XXH3_lanes_avalanche_avx512(acc);
     }
+    _mm512_storeu_si512(dst, acc);
 }
 
-/*
- * Both XXH3_64bits_update and XXH3_128bits_update use this routine.
- */
-XXH_FORCE_INLINE XXH_errorcode
-XXH3_update(XXH3_state_t* state,
-            const xxh_u8* input, size_t len,
-            XXH3_accWidth_e accWidth,
-            XXH3_f_accumulate_512 f_acc512,
-            XXH3_f_scrambleAcc f_scramble)
+/* hashes 8 keys of @len bytes, one per 64-bit lane */
+XXH_FORCE_INLINE XXH_TARGET_AVX512 void
+XXH3_hashShort_x8_avx512(xxh_u64* XXH_RESTRICT dst,
+                         const xxh_u8* const* XXH_RESTRICT inputs, size_t len,
+                         const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
+                         xxh_u64 seed64)
 {
-    if (input==NULL)
-#if defined(XXH_ACCEPT_NULL_INPUT_POINTER) && (XXH_ACCEPT_NULL_INPUT_POINTER>=1)
-        return XXH_OK;
-#else
-        return XXH_ERROR;
-#endif
+    XXH3_hashShort_lanes_avx512(dst, inputs, 0, len, secret, secretSize, _mm512_set1_epi64((xxh_i64)seed64));
+}
 
-    {   const xxh_u8* const bEnd = input + len;
-        const unsigned char* const secret = (state->extSecret == NULL) ? state->customSecret : state->extSecret;
+/* hashes one input of @len bytes with 8 seeds, one per 64-bit lane */
+XXH_FORCE_INLINE XXH_TARGET_AVX512 void
+XXH3_hashShort_seeds_x8_avx512(xxh_u64* XXH_RESTRICT dst,
+                               const xxh_u8* XXH_RESTRICT input, size_t len,
+                               const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
+                               const xxh_u64* XXH_RESTRICT seeds)
+{
+    const xxh_u8* inputs[1];
+    inputs[0] = input;
+    XXH3_hashShort_lanes_avx512(dst, inputs, 1, len, secret, secretSize, _mm512_loadu_si512(seeds));
+}
 
-        state->totalLen += len;
+#endif
 
-        if (state->bufferedSize + len <= XXH3_INTERNALBUFFER_SIZE) {  /* fill in tmp buffer */
-            XXH_memcpy(state->buffer + state->bufferedSize, input, len);
-            state->bufferedSize += (XXH32_hash_t)len;
-            return XXH_OK;
-        }
-        /* input is now > XXH3_INTERNALBUFFER_SIZE */
+/* scalar variant - universal */
 
-        #define XXH3_INTERNALBUFFER_STRIPES (XXH3_INTERNALBUFFER_SIZE / XXH_STRIPE_LEN)
-        XXH_STATIC_ASSERT(XXH3_INTERNALBUFFER_SIZE % XXH_STRIPE_LEN == 0);   /* clean multiple */
+XXH_FORCE_INLINE void
+XXH3_hashShort_x8_scalar(xxh_u64* XXH_RESTRICT dst,
+                         const xxh_u8* const* XXH_RESTRICT inputs, size_t len,
+                         const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
+                         xxh_u64 seed)
+{
+    size_t i;
+    XXH_ASSERT(len <= XXH3_MIDSIZE_MAX);
+    /* the length class is shared by all keys: branch once, not once per key */
+    if (len <= 16) {
+        for (i = 0; i < XXH3_BATCH_LANES; i++)
+            dst[i] = XXH3_len_0to16_64b(inputs[i], len, secret, seed);
+    } else if (len <= 128) {
+        for (i = 0; i < XXH3_BATCH_LANES; i++)
+            dst[i] = XXH3_len_17to128_64b(inputs[i], len, secret, secretSize, seed);
+    } else {
+        for (i = 0; i < XXH3_BATCH_LANES; i++)
+            dst[i] = XXH3_len_129to240_64b(inputs[i], len, secret, secretSize, seed);
+    }
+}
 
-        /*
-         * There is some input left inside the internal buffer.
-         * Fill it, then consume it.
-         */
-        if (state->bufferedSize) {
-            size_t const loadSize = XXH3_INTERNALBUFFER_SIZE - state->bufferedSize;
-            XXH_memcpy(state->buffer + state->bufferedSize, input, loadSize);
-            input += loadSize;
-            XXH3_consumeStripes(state->acc,
-                               &state->nbStripesSoFar, state->nbStripesPerBlock,
-                                state->buffer, XXH3_INTERNALBUFFER_STRIPES,
-                                secret, state->secretLimit,
-                                accWidth, f_acc512, f_scramble);
-            state->bufferedSize = 0;
-        }
+/* one input, 8 seeds */
+XXH_FORCE_INLINE void
+XXH3_hashShort_seeds_x8_scalar(xxh_u64* XXH_RESTRICT dst,
+                               const xxh_u8* XXH_RESTRICT input, size_t len,
+                               const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
+                               const xxh_u64* XXH_RESTRICT seeds)
+{
+    size_t i;
+    XXH_ASSERT(len <= XXH3_MIDSIZE_MAX);
+    if (len <= 16) {
+        for (i = 0; i < XXH3_BATCH_LANES; i++)
+            dst[i] = XXH3_len_0to16_64b(input, len, secret, seeds[i]);
+    } else if (len <= 128) {
+        for (i = 0; i < XXH3_BATCH_LANES; i++)
+            dst[i] = XXH3_len_17to128_64b(input, len, secret, secretSize, seeds[i]);
+    } else {
+        for (i = 0; i < XXH3_BATCH_LANES; i++)
+            dst[i] = XXH3_len_129to240_64b(input, len, secret, secretSize, seeds[i]);
+    }
+}
 
-        /* Consume input by a multiple of internal buffer size */
-        if (input+XXH3_INTERNALBUFFER_SIZE <= bEnd) {
-            const xxh_u8* const limit = bEnd - XXH3_INTERNALBUFFER_SIZE;
-            do {
-                XXH3_consumeStripes(state->acc,
-                                   &state->nbStripesSoFar, state->nbStripesPerBlock,
-                                    input, XXH3_INTERNALBUFFER_STRIPES,
-                                    secret, state->secretLimit,
-                                    accWidth, f_acc512, f_scramble);
-                input += XXH3_INTERNALBUFFER_SIZE;
-            } while (input<=limit);
-            /* for last partial stripe */
-            memcpy(state->buffer + sizeof(state->buffer) - XXH_STRIPE_LEN, input - XXH_STRIPE_LEN, XXH_STRIPE_LEN);
-        }
+typedef void (*XXH3_f_hashShort_x8)(xxh_u64* XXH_RESTRICT, const xxh_u8* const* XXH_RESTRICT, size_t,
+                                    const xxh_u8* XXH_RESTRICT, size_t, xxh_u64);
+typedef void (*XXH3_f_hashShort_seeds_x8)(xxh_u64* XXH_RESTRICT, const xxh_u8* XXH_RESTRICT, size_t,
+                                          const xxh_u8* XXH_RESTRICT, size_t, const xxh_u64* XXH_RESTRICT);
 
-        if (input < bEnd) { /* Some remaining input: buffer it */
-            XXH_memcpy(state->buffer, input, (size_t)(bEnd-input));
-            state->bufferedSize = (XXH32_hash_t)(bEnd-input);
+#if (XXH_VECTOR == XXH_AVX512)
+#  define XXH3_hashShort_x8 XXH3_hashShort_x8_avx512
+#  define XXH3_hashShort_seeds_x8 XXH3_hashShort_seeds_x8_avx512
+#else
+#  define XXH3_hashShort_x8 XXH3_hashShort_x8_scalar
+#  define XXH3_hashShort_seeds_x8 XXH3_hashShort_seeds_x8_scalar
+#endif
+
+/*
+ * XXH3_64bits_batch_short():
+ * Hashes @nbKeys contiguous keys of @keySize bytes (<= XXH3_MIDSIZE_MAX),
+ * 8 at a time. The last group is padded by repeating the last key.
+ */
+XXH_FORCE_INLINE void
+XXH3_64bits_batch_short(XXH64_hash_t* XXH_RESTRICT dst,
+                        const xxh_u8* XXH_RESTRICT keys, size_t keySize, size_t nbKeys,
+                        XXH64_hash_t seed, XXH3_f_hashShort_x8 f_x8)
+{
+    const xxh_u8* inputs[XXH3_BATCH_LANES];
+    size_t n, i;
+    XXH_ASSERT(keySize <= XXH3_MIDSIZE_MAX);
+
+    for (n = 0; n + XXH3_BATCH_LANES <= nbKeys; n += XXH3_BATCH_LANES) {
+        for (i = 0; i < XXH3_BATCH_LANES; i++) inputs[i] = keys + (n+i) * keySize;
+        f_x8(dst + n, inputs, keySize, XXH3_kSecret, sizeof(XXH3_kSecret), seed);
+    }
+    if (n < nbKeys) {
+        XXH_ALIGN(64) xxh_u64 results[XXH3_BATCH_LANES];
+        for (i = 0; i < XXH3_BATCH_LANES; i++) {
+            size_t const k = (n+i < nbKeys) ? n+i : nbKeys-1;
+            inputs[i] = keys + k * keySize;
         }
+        f_x8(results, inputs, keySize, XXH3_kSecret, sizeof(XXH3_kSecret), seed);
+        for (i = 0; n+i < nbKeys; i++) dst[n+i] = results[i];
     }
+}
 
-    return XXH_OK;
+XXH_FORCE_INLINE void
+XXH3_64bits_batch_internal(XXH64_hash_t* XXH_RESTRICT dst,
+                           const void* XXH_RESTRICT keys, size_t keySize, size_t nbKeys,
+                           XXH64_hash_t seed,
+                           XXH3_f_hashShort_x8 f_x8, XXH3_hashLong64_f f_hashLong)
+{
+    if (nbKeys == 0) return;
+    XXH_ASSERT(dst != NULL);
+    if (keySize == 0) {
+        /* all keys are the empty string */
+        XXH64_hash_t const h = XXH3_len_0to16_64b(NULL, 0, XXH3_kSecret, seed);
+        size_t n;
+        for (n = 0; n < nbKeys; n++) dst[n] = h;
+        return;
+    }
+    XXH_ASSERT(keys != NULL);
+    if (keySize <= XXH3_MIDSIZE_MAX) {
+        XXH3_64bits_batch_short(dst, (const xxh_u8*)keys, keySize, nbKeys, seed, f_x8);
+    } else {
+        size_t n;
+        for (n = 0; n < nbKeys; n++)
+            dst[n] = f_hashLong((const xxh_u8*)keys + n*keySize, keySize, seed, XXH3_kSecret, sizeof(XXH3_kSecret));
+    }
 }
 
-XXH_PUBLIC_API XXH_errorcode
-XXH3_64bits_update(XXH3_state_t* state, const void* input, size_t len)
+XXH_PUBLIC_API void
+XXH3_64bits_batch(XXH64_hash_t* dst, const void* keys, size_t keySize, size_t nbKeys)
 {
-    return XXH3_update(state, (const xxh_u8*)input, len,
-                       XXH3_acc_64bits, XXH3_accumulate_512, XXH3_scrambleAcc);
+    XXH3_64bits_batch_internal(dst, keys, keySize, nbKeys, 0, XXH3_hashShort_x8, XXH3_hashLong_64b_default);
+}
+
+XXH_PUBLIC_API void
+XXH3_64bits_withSeed_batch(XXH64_hash_t* dst, const void* keys, size_t keySize, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_64bits_batch_internal(dst, keys, keySize, nbKeys, seed, XXH3_hashShort_x8, XXH3_hashLong_64b_withSeed);
 }
 
 
+/* ===   XXH3 multi-seed hashing   === */
+
+/*
+ * Hashes one input with several seeds, as needed by bloom filters,
+ * count-min sketches or cuckoo tables.
+ *
+ * Short inputs (<= XXH3_MIDSIZE_MAX) are hashed 8 seeds at a time, one seed
+ * per lane, with the input loaded once and broadcast.
+ *
+ * Long inputs keep one set of accumulators and one derived secret per seed,
+ * both set up once per call. The input is walked one block at a time, and
+ * each block is accumulated into all the sets while it is still in L1,
+ * so that the input is read from memory once, instead of once per seed.
+ */
+
+/* accumulates @input into @nbSeeds (<= XXH3_BATCH_LANES) sets of accumulators */
 XXH_FORCE_INLINE void
-XXH3_digest_long (XXH64_hash_t* acc,
-                  const XXH3_state_t* state,
-                  const unsigned char* secret,
-                  XXH3_accWidth_e accWidth)
+XXH3_hashLong_64b_seeds_internal(XXH64_hash_t* XXH_RESTRICT dst,
+                                 const xxh_u8* XXH_RESTRICT input, size_t len,
+                                 const XXH64_hash_t* XXH_RESTRICT seeds, size_t nbSeeds,
+                                 XXH3_f_accumulate_512 f_acc512,
+                                 XXH3_f_scrambleAcc f_scramble,
+                                 XXH3_f_initCustomSecret f_initSec)
 {
-    /*
-     * Digest on a local copy. This way, the state remains unaltered, and it can
-     * continue ingesting more input afterwards.
-     */
-    memcpy(acc, state->acc, sizeof(state->acc));
-    if (state->bufferedSize >= XXH_STRIPE_LEN) {
-        size_t const nbStripes = state->bufferedSize / XXH_STRIPE_LEN;
-        size_t nbStripesSoFar = state->nbStripesSoFar;
-        XXH3_consumeStripes(acc,
-                           &nbStripesSoFar, state->nbStripesPerBlock,
-                            state->buffer, nbStripes,
-                            secret, state->secretLimit,
-                            accWidth, XXH3_accumulate_512, XXH3_scrambleAcc);
-        if (state->bufferedSize % XXH_STRIPE_LEN) {  /* one last partial stripe */
-            XXH3_accumulate_512(acc,
-                                state->buffer + state->bufferedSize - XXH_STRIPE_LEN,
-                                secret + state->secretLimit - XXH_SECRET_LASTACC_START,
-                                accWidth);
+    size_t const nb_rounds = (XXH_SECRET_DEFAULT_SIZE - XXH_STRIPE_LEN) / XXH_SECRET_CONSUME_RATE;
+    size_t const block_len = XXH_STRIPE_LEN * nb_rounds;
+    XXH_ALIGN(XXH_ACC_ALIGN) xxh_u64 acc[XXH3_BATCH_LANES][XXH_ACC_NB];
+    XXH_ALIGN(XXH_SEC_ALIGN) xxh_u8 customSecrets[XXH3_BATCH_LANES][XXH_SECRET_DEFAULT_SIZE];
+    const xxh_u8* secrets[XXH3_BATCH_LANES];
+    size_t n, k;
+
+    XXH_STATIC_ASSERT(sizeof(XXH3_kSecret) == XXH_SECRET_DEFAULT_SIZE);
+    XXH_ASSERT(len > XXH3_MIDSIZE_MAX);
+    XXH_ASSERT(nbSeeds <= XXH3_BATCH_LANES);
+
+    for (k = 0; k < nbSeeds; k++) {
+        static const xxh_u64 initAcc[XXH_ACC_NB] = XXH3_INIT_ACC;
+        memcpy(acc[k], initAcc, sizeof(initAcc));
+        if (seeds[k] == 0) {
+            secrets[k] = XXH3_kSecret;
+        } else {
+            f_initSec(customSecrets[k], seeds[k]);
+            secrets[k] = customSecrets[k];
         }
-    } else {  /* bufferedSize < XXH_STRIPE_LEN */
-        if (state->bufferedSize) { /* one last stripe */
-            xxh_u8 lastStripe[XXH_STRIPE_LEN];
-            size_t const catchupSize = XXH_STRIPE_LEN - state->bufferedSize;
-            memcpy(lastStripe, state->buffer + sizeof(state->buffer) - catchupSize, catchupSize);
-            memcpy(lastStripe + catchupSize, state->buffer, state->bufferedSize);
-            XXH3_accumulate_512(acc,
-                                lastStripe,
-                                secret + state->secretLimit - XXH_SECRET_LASTACC_START,
-                                accWidth);
-    }   }
-}
+    }
 
-XXH_PUBLIC_API XXH64_hash_t XXH3_64bits_digest (const XXH3_state_t* state)
-{
-    const unsigned char* const secret = (state->extSecret == NULL) ? state->customSecret : state->extSecret;
-    if (state->totalLen > XXH3_MIDSIZE_MAX) {
-        XXH_ALIGN(XXH_ACC_ALIGN) XXH64_hash_t acc[XXH_ACC_NB];
-        XXH3_digest_long(acc, state, secret, XXH3_acc_64bits);
-        return XXH3_mergeAccs(acc,
-                              secret + XXH_SECRET_MERGEACCS_START,
-                              (xxh_u64)state->totalLen * XXH_PRIME64_1);
+    /* full blocks; at least one block is left for XXH3_hashLong_internal_loop() */
+    for (n = 0; len - n*block_len >= 2*block_len; n++) {
+        for (k = 0; k < nbSeeds; k++) {
+            XXH3_accumulate(acc[k], input + n*block_len, secrets[k], nb_rounds, XXH3_acc_64bits, f_acc512);
+            f_scramble(acc[k], secrets[k] + XXH_SECRET_DEFAULT_SIZE - XXH_STRIPE_LEN);
+        }
+    }
+
+    /* last block(s), last stripe and merge */
+    for (k = 0; k < nbSeeds; k++) {
+        XXH3_hashLong_internal_loop(acc[k], input + n*block_len, len - n*block_len,
+                                    secrets[k], XXH_SECRET_DEFAULT_SIZE, XXH3_acc_64bits, f_acc512, f_scramble);
+        dst[k] = XXH3_mergeAccs(acc[k], secrets[k] + XXH_SECRET_MERGEACCS_START, (xxh_u64)len * XXH_PRIME64_1);
     }
-    /* totalLen <= XXH3_MIDSIZE_MAX: digesting a short input */
-    if (state->seed)
-        return XXH3_64bits_withSeed(state->buffer, (size_t)state->totalLen, state->seed);
-    return XXH3_64bits_withSecret(state->buffer, (size_t)(state->totalLen),
-                                  secret, state->secretLimit + XXH_STRIPE_LEN);
 }
 
+XXH_NO_INLINE void
+XXH3_hashLong_64b_seeds(XXH64_hash_t* XXH_RESTRICT dst,
+                        const xxh_u8* XXH_RESTRICT input, size_t len,
+                        const XXH64_hash_t* XXH_RESTRICT seeds, size_t nbSeeds)
+{
+    XXH3_hashLong_64b_seeds_internal(dst, input, len, seeds, nbSeeds,
+                XXH3_accumulate_512, XXH3_scrambleAcc, XXH3_initCustomSecret);
+}
 
-#define XXH_MIN(x, y) (((x) > (y)) ? (y) : (x))
+typedef void (*XXH3_hashLong64_seeds_f)(XXH64_hash_t* XXH_RESTRICT, const xxh_u8* XXH_RESTRICT, size_t,
+                                        const XXH64_hash_t* XXH_RESTRICT, size_t);
 
-XXH_PUBLIC_API void
-XXH3_generateSecret(void* secretBuffer, const void* customSeed, size_t customSeedSize)
+XXH_FORCE_INLINE void
+XXH3_64bits_withSeeds_internal(XXH64_hash_t* XXH_RESTRICT dst,
+                               const void* XXH_RESTRICT input, size_t len,
+                               const XXH64_hash_t* XXH_RESTRICT seeds, size_t nbSeeds,
+                               XXH3_f_hashShort_seeds_x8 f_x8, XXH3_hashLong64_seeds_f f_hashLong)
 {
-    XXH_ASSERT(secretBuffer != NULL);
-    if (customSeedSize == 0) {
-        memcpy(secretBuffer, XXH3_kSecret, XXH_SECRET_DEFAULT_SIZE);
+    size_t n, i;
+    if (nbSeeds == 0) return;
+    XXH_ASSERT(dst != NULL && seeds != NULL);
+    XXH_ASSERT(input != NULL || len == 0);
+
+    if (len > XXH3_MIDSIZE_MAX) {
+        for (n = 0; n < nbSeeds; n += XXH3_BATCH_LANES) {
+            size_t const nb = (nbSeeds - n < XXH3_BATCH_LANES) ? nbSeeds - n : XXH3_BATCH_LANES;
+            f_hashLong(dst + n, (const xxh_u8*)input, len, seeds + n, nb);
+        }
         return;
     }
-    XXH_ASSERT(customSeed != NULL);
-
-    {   size_t const segmentSize = sizeof(XXH128_hash_t);
-        size_t const nbSegments = XXH_SECRET_DEFAULT_SIZE / segmentSize;
-        XXH128_canonical_t scrambler;
-        XXH64_hash_t seeds[12];
-        size_t segnb;
-        XXH_ASSERT(nbSegments == 12);
-        XXH_ASSERT(segmentSize * nbSegments == XXH_SECRET_DEFAULT_SIZE); /* exact multiple */
-        XXH128_canonicalFromHash(&scrambler, XXH128(customSeed, customSeedSize, 0));
 
-        /*
-        * Copy customSeed to seeds[], truncating or repeating as necessary.
-        */
-        {   size_t toFill = XXH_MIN(customSeedSize, sizeof(seeds));
-            size_t filled = toFill;
-            memcpy(seeds, customSeed, toFill);
-            while (filled < sizeof(seeds)) {
-                toFill = XXH_MIN(filled, sizeof(seeds) - filled);
-                memcpy((char*)seeds + filled, seeds, toFill);
-                filled += toFill;
-        }   }
+    for (n = 0; n + XXH3_BATCH_LANES <= nbSeeds; n += XXH3_BATCH_LANES) {
+        f_x8(dst + n, (const xxh_u8*)input, len, XXH3_kSecret, sizeof(XXH3_kSecret), seeds + n);
+    }
+    if (n < nbSeeds) {
+        /* last group is padded by repeating the last seed */
+        XXH_ALIGN(64) xxh_u64 lastSeeds[XXH3_BATCH_LANES];
+        XXH_ALIGN(64) xxh_u64 results[XXH3_BATCH_LANES];
+        for (i = 0; i < XXH3_BATCH_LANES; i++) {
+            lastSeeds[i] = seeds[(n+i < nbSeeds) ? n+i : nbSeeds-1];
+        }
+        f_x8(results, (const xxh_u8*)input, len, XXH3_kSecret, sizeof(XXH3_kSecret), lastSeeds);
+        for (i = 0; n+i < nbSeeds; i++) dst[n+i] = results[i];
+    }
+}
 
-        /* generate secret */
-        memcpy(secretBuffer, &scrambler, sizeof(scrambler));
-        for (segnb=1; segnb < nbSegments; segnb++) {
-            size_t const segmentStart = segnb * segmentSize;
-            XXH128_canonical_t segment;
-            XXH128_canonicalFromHash(&segment,
-                XXH128(&scrambler, sizeof(scrambler), XXH_readLE64(seeds + segnb) + segnb) );
-            memcpy((char*)secretBuffer + segmentStart, &segment, sizeof(segment));
-    }   }
+XXH_PUBLIC_API void
+XXH3_64bits_withSeeds(XXH64_hash_t* dst, const void* input, size_t len,
+                      const XXH64_hash_t* seeds, size_t nbSeeds)
+{
+    XXH3_64bits_withSeeds_internal(dst, input, len, seeds, nbSeeds,
+                                   XXH3_hashShort_seeds_x8, XXH3_hashLong_64b_seeds);
 }
 
 
-/* ==========================================
- * XXH3 128 bits (a.k.a XXH128)
- * ==========================================
- * XXH3's 128-bit variant has better mixing and strength than the 64-bit variant,
- * even without counting the significantly larger output size.
- *
- * For example, extra steps are taken to avoid the seed-dependent collisions
- * in 17-240 byte inputs (See XXH3_mix16B and XXH128_mix32B).
+/* ===   XXH3 gather hashing   === */
+
+/*
+ * Batches of variable-length keys stored out of line.
  *
- * This strength naturally comes at the cost of some speed, especially on short
- * lengths. Note that longer hashes are about as fast as the 64-bit version
- * due to it using only a slight modification of the 64-bit loop.
+ * When keys live behind pointers (hash table probes), hashing them one by one
+ * is bound by memory latency: each key costs a cache miss before XXH3 starts.
+ * Instead, keys are processed in groups, and the keys of the next group are
+ * prefetched while the current one is hashed.
  *
- * XXH128 is also more oriented towards 64-bit machines. It is still extremely
- * fast for a _128-bit_ hash on 32-bit (it usually clears XXH64).
+ * Within a group, keys are sorted by length class (0-16, 17-128, 129-240, long),
+ * so that each class runs its XXH3_len_* kernel in a tight loop, instead of
+ * going through the length dispatch of XXH3_64bits_internal() for every key.
  */
 
-XXH_FORCE_INLINE XXH128_hash_t
-XXH3_len_1to3_128b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
+/* in the order of the number of outstanding L1 misses a core can track */
+#define XXH3_GATHER_GROUP 16
+
+XXH_FORCE_INLINE void
+XXH3_gather_prefetch(const void* key, size_t len)
 {
-    /* A doubled version of 1to3_64b with different constants. */
-    XXH_ASSERT(input != NULL);
-    XXH_ASSERT(1 <= len && len <= 3);
-    XXH_ASSERT(secret != NULL);
-    /*
-     * len = 1: combinedl = { input[0], 0x01, input[0], input[0] }
-     * len = 2: combinedl = { input[1], 0x02, input[0], input[1] }
-     * len = 3: combinedl = { input[2], 0x03, input[0], input[1] }
-     */
-    {   xxh_u8 const c1 = input[0];
-        xxh_u8 const c2 = input[len >> 1];
-        xxh_u8 const c3 = input[len - 1];
-        xxh_u32 const combinedl = ((xxh_u32)c1 <<16) | ((xxh_u32)c2 << 24)
-                                | ((xxh_u32)c3 << 0) | ((xxh_u32)len << 8);
-        xxh_u32 const combinedh = XXH_rotl32(XXH_swap32(combinedl), 13);
-        xxh_u64 const bitflipl = (XXH_readLE32(secret) ^ XXH_readLE32(secret+4)) + seed;
-        xxh_u64 const bitfliph = (XXH_readLE32(secret+8) ^ XXH_readLE32(secret+12)) - seed;
-        xxh_u64 const keyed_lo = (xxh_u64)combinedl ^ bitflipl;
-        xxh_u64 const keyed_hi = (xxh_u64)combinedh ^ bitfliph;
-        xxh_u64 const mixedl = keyed_lo * XXH_PRIME64_1;
-        xxh_u64 const mixedh = keyed_hi * XXH_PRIME64_5;
-        XXH128_hash_t h128;
-        h128.low64  = XXH3_avalanche(mixedl);
-        h128.high64 = XXH3_avalanche(mixedh);
-        return h128;
+    /* short keys are read entirely, long keys get prefetched by XXH3_hashLong */
+    size_t const span = (len < XXH3_MIDSIZE_MAX) ? len : XXH3_MIDSIZE_MAX;
+    size_t offset;
+    for (offset = 0; offset < span; offset += 64) {
+        XXH_PREFETCH((const xxh_u8*)key + offset);
     }
+    if (span) XXH_PREFETCH((const xxh_u8*)key + span - 1);
 }
 
-XXH_FORCE_INLINE XXH128_hash_t
-XXH3_len_4to8_128b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
+XXH_FORCE_INLINE void
+XXH3_64bits_gather_internal(XXH64_hash_t* XXH_RESTRICT dst,
+                            const void* const* XXH_RESTRICT keys, const size_t* XXH_RESTRICT lengths,
+                            size_t nbKeys, XXH64_hash_t seed, XXH3_hashLong64_f f_hashLong)
 {
-    XXH_ASSERT(input != NULL);
-    XXH_ASSERT(secret != NULL);
-    XXH_ASSERT(4 <= len && len <= 8);
-    seed ^= (xxh_u64)XXH_swap32((xxh_u32)seed) << 32;
-    {   xxh_u32 const input_lo = XXH_readLE32(input);
-        xxh_u32 const input_hi = XXH_readLE32(input + len - 4);
-        xxh_u64 const input_64 = input_lo + ((xxh_u64)input_hi << 32);
-        xxh_u64 const bitflip = (XXH_readLE64(secret+16) ^ XXH_readLE64(secret+24)) + seed;
-        xxh_u64 const keyed = input_64 ^ bitflip;
+    size_t n, i;
+    if (nbKeys == 0) return;
+    XXH_ASSERT(dst != NULL && keys != NULL && lengths != NULL);
 
-        /* Shift len to the left to ensure it is even, this avoids even multiplies. */
-        XXH128_hash_t m128 = XXH_mult64to128(keyed, XXH_PRIME64_1 + (len << 2));
+    for (i = 0; i < nbKeys && i < XXH3_GATHER_GROUP; i++) {
+        XXH3_gather_prefetch(keys[i], lengths[i]);
+    }
+    for (n = 0; n < nbKeys; n += XXH3_GATHER_GROUP) {
+        size_t const groupEnd = (nbKeys - n > XXH3_GATHER_GROUP) ? n + XXH3_GATHER_GROUP : nbKeys;
+        size_t byClass[4][XXH3_GATHER_GROUP];
+        size_t nbInClass[4] = { 0, 0, 0, 0 };
 
-        m128.high64 += (m128.low64 << 1);
-        m128.low64  ^= (m128.high64 >> 3);
+        for (i = groupEnd; i < nbKeys && i < groupEnd + XXH3_GATHER_GROUP; i++) {
+            XXH3_gather_prefetch(keys[i], lengths[i]);
+        }
+        for (i = n; i < groupEnd; i++) {
+            size_t const len = lengths[i];
+            size_t const lenClass = (size_t)(len > 16) + (size_t)(len > 128) + (size_t)(len > XXH3_MIDSIZE_MAX);
+            byClass[lenClass][nbInClass[lenClass]++] = i;
+        }
 
-        m128.low64   = XXH_xorshift64(m128.low64, 35);
-        m128.low64  *= 0x9FB21C651E98DF25ULL;
-        m128.low64   = XXH_xorshift64(m128.low64, 28);
-        m128.high64  = XXH3_avalanche(m128.high64);
-        return m128;
+        for (i = 0; i < nbInClass[0]; i++) {
+            size_t const k = byClass[0][i];
+            dst[k] = XXH3_len_0to16_64b((const xxh_u8*)keys[k], lengths[k], XXH3_kSecret, seed);
+        }
+        for (i = 0; i < nbInClass[1]; i++) {
+            size_t const k = byClass[1][i];
+            dst[k] = XXH3_len_17to128_64b((const xxh_u8*)keys[k], lengths[k], XXH3_kSecret, sizeof(XXH3_kSecret), seed);
+        }
+        for (i = 0; i < nbInClass[2]; i++) {
+            size_t const k = byClass[2][i];
+            dst[k] = XXH3_len_129to240_64b((const xxh_u8*)keys[k], lengths[k], XXH3_kSecret, sizeof(XXH3_kSecret), seed);
+        }
+        for (i = 0; i < nbInClass[3]; i++) {
+            size_t const k = byClass[3][i];
+            dst[k] = f_hashLong((const xxh_u8*)keys[k], lengths[k], seed, XXH3_kSecret, sizeof(XXH3_kSecret));
+        }
     }
 }
 
-XXH_FORCE_INLINE XXH128_hash_t
-XXH3_len_9to16_128b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
+XXH_PUBLIC_API void
+XXH3_64bits_gather(XXH64_hash_t* dst, const void* const* keys, const size_t* lengths, size_t nbKeys)
 {
-    XXH_ASSERT(input != NULL);
-    XXH_ASSERT(secret != NULL);
-    XXH_ASSERT(9 <= len && len <= 16);
-    {   xxh_u64 const bitflipl = (XXH_readLE64(secret+32) ^ XXH_readLE64(secret+40)) - seed;
-        xxh_u64 const bitfliph = (XXH_readLE64(secret+48) ^ XXH_readLE64(secret+56)) + seed;
-        xxh_u64 const input_lo = XXH_readLE64(input);
-        xxh_u64       input_hi = XXH_readLE64(input + len - 8);
-        XXH128_hash_t m128 = XXH_mult64to128(input_lo ^ input_hi ^ bitflipl, XXH_PRIME64_1);
-        /*
-         * Put len in the middle of m128 to ensure that the length gets mixed to
-         * both the low and high bits in the 128x64 multiply below.
-         */
-        m128.low64 += (xxh_u64)(len - 1) << 54;
-        input_hi   ^= bitfliph;
-        /*
-         * Add the high 32 bits of input_hi to the high 32 bits of m128, then
-         * add the long product of the low 32 bits of input_hi and XXH_PRIME32_2 to
-         * the high 64 bits of m128.
-         *
-         * The best approach to this operation is different on 32-bit and 64-bit.
-         */
-        if (sizeof(void *) < sizeof(xxh_u64)) { /* 32-bit */
-            /*
-             * 32-bit optimized version, which is more readable.
-             *
-             * On 32-bit, it removes an ADC and delays a dependency between the two
-             * halves of m128.high64, but it generates an extra mask on 64-bit.
-             */
-            m128.high64 += (input_hi & 0xFFFFFFFF00000000) + XXH_mult32to64((xxh_u32)input_hi, XXH_PRIME32_2);
-        } else {
+    XXH3_64bits_gather_internal(dst, keys, lengths, nbKeys, 0, XXH3_hashLong_64b_default);
+}
+
+XXH_PUBLIC_API void
+XXH3_64bits_withSeed_gather(XXH64_hash_t* dst, const void* const* keys, const size_t* lengths, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_64bits_gather_internal(dst, keys, lengths, nbKeys, seed, XXH3_hashLong_64b_withSeed);
+}
+
+
+/* ===   XXH32 and XXH64 multi-lane hashing   === */
+
+/*
+ * Independent XXH32 and XXH64 computations, side by side in SIMD lanes,
+ * for formats which checksum many frames or blocks with the classic hashes.
+ *
+ * Each lane runs the exact XXH32_round() or XXH64_round() chain of one input.
+ * Lanes are processed in groups, 16 for XXH32 and 8 for XXH64, whose
+ * accumulators are stored as a structure of arrays: accumulator `k` of lane `i`
+ * is at `acc[k * GROUP + i]`, so that a vector of accumulators is one load.
+ * Each lane has its own input pointer, and kernels transpose one stripe of
+ * every lane into vectors of words, which is the only extra work compared
+ * with scalar rounds.
+ * Merging the accumulators and the tail of each input stay scalar.
+ *
+ * AVX2 has a native 32-bit multiply, but no 64-bit one: emulated with PMULUDQ,
+ * 4 XXH64 lanes are no faster than scalar rounds, so XXH64 lanes need AVX512.
+ * Without a SIMD kernel, batches are simply a loop of one-shot hashes,
+ * which is also used for inputs shorter than a stripe.
+ */
+
+#define XXH32_LANES_GROUP 16
+#define XXH64_LANES_GROUP 8
+#define XXH32_STRIPE_LEN 16
+#define XXH64_STRIPE_LEN 32
+
+typedef void (*XXH32_f_lanes)(xxh_u32* XXH_RESTRICT acc, const xxh_u8* const* XXH_RESTRICT inputs, size_t nbStripes);
+typedef void (*XXH64_f_lanes)(xxh_u64* XXH_RESTRICT acc, const xxh_u8* const* XXH_RESTRICT inputs, size_t nbStripes);
+
+#if (XXH_VECTOR == XXH_AVX512) || defined(XXH_X86DISPATCH)
+
+/* one stripe of 16 lanes, transposed 4x4 within each 128-bit block */
+XXH_FORCE_INLINE XXH_TARGET_AVX512 __m512i
+XXH32_lanes_load4x128_avx512(const xxh_u8* const* XXH_RESTRICT inputs, size_t first, size_t offset)
+{
+    __m512i v = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)(inputs[first] + offset)));
+    v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(inputs[first + 4] + offset)), 1);
+    v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(inputs[first + 8] + offset)), 2);
+    return _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(inputs[first + 12] + offset)), 3);
+}
+
+XXH_FORCE_INLINE XXH_TARGET_AVX512 __m512i
+XXH32_lanes_round_avx512(__m512i acc, __m512i input)
+{
+    acc = _mm512_add_epi32(acc, _mm512_mullo_epi32(input, _mm512_set1_epi32((int)XXH_PRIME32_2)));
+    acc = _mm512_rol_epi32(acc, 13);
+    return _mm512_mullo_epi32(acc, _mm512_set1_epi32((int)XXH_PRIME32_1));
+}
+
+XXH_FORCE_INLINE XXH_TARGET_AVX512 void
+XXH32_lanes_avx512(xxh_u32* XXH_RESTRICT acc, const xxh_u8* const* XXH_RESTRICT inputs, size_t nbStripes)
+{
+    __m512i v1 = _mm512_loadu_si512(acc);
+    __m512i v2 = _mm512_loadu_si512(acc + XXH32_LANES_GROUP);
+    __m512i v3 = _mm512_loadu_si512(acc + 2 * XXH32_LANES_GROUP);
+    __m512i v4 = _mm512_loadu_si512(acc + 3 * XXH32_LANES_GROUP);
+    size_t s;
+    for (s = 0; s < nbStripes; s++) {
+        size_t const offset = s * XXH32_STRIPE_LEN;
+        /* row i holds the stripes of lanes { i, i+4, i+8, i+12 } */
+        __m512i const r0 = XXH32_lanes_load4x128_avx512(inputs, 0, offset);
+        __m512i const r1 = XXH32_lanes_load4x128_avx512(inputs, 1, offset);
+        __m512i const r2 = XXH32_lanes_load4x128_avx512(inputs, 2, offset);
+        __m512i const r3 = XXH32_lanes_load4x128_avx512(inputs, 3, offset);
+        __m512i const t0 = _mm512_unpacklo_epi32(r0, r1);
+        __m512i const t1 = _mm512_unpackhi_epi32(r0, r1);
+        __m512i const t2 = _mm512_unpacklo_epi32(r2, r3);
+        __m512i const t3 = _mm512_unpackhi_epi32(r2, r3);
+        v1 = XXH32_lanes_round_avx512(v1, _mm512_unpacklo_epi64(t0, t2));
+        v2 = XXH32_lanes_round_avx512(v2, _mm512_unpackhi_epi64(t0, t2));
+        v3 = XXH32_lanes_round_avx512(v3, _mm512_unpacklo_epi64(t1, t3));
+        v4 = XXH32_lanes_round_avx512(v4, _mm512_unpackhi_epi64(t1, t3));
+    }
+    _mm512_storeu_si512(acc, v1);
+    _mm512_storeu_si512(acc + XXH32_LANES_GROUP, v2);
+    _mm512_storeu_si512(acc + 2 * XXH32_LANES_GROUP, v3);
+    _mm512_storeu_si512(acc + 3 * XXH32_LANES_GROUP, v4);
+}
+
+XXH_FORCE_INLINE XXH_TARGET_AVX512 __m512i
+XXH64_lanes_round_avx512(__m512i acc, __m512i input)
+{
+    acc = _mm512_add_epi64(acc, XXH3_lanes_mult64_avx512(input, XXH_PRIME64_2));
+    acc = _mm512_rol_epi64(acc, 31);
+    return XXH3_lanes_mult64_avx512(acc, XXH_PRIME64_1);
+}
+
+XXH_FORCE_INLINE XXH_TARGET_AVX512 __m512i
+XXH64_lanes_load2x256_avx512(const xxh_u8* const* XXH_RESTRICT inputs, size_t first, size_t offset)
+{
+    __m512i const v = _mm512_castsi256_si512(_mm256_loadu_si256((const __m256i*)(inputs[first] + offset)));
+    return _mm512_inserti64x4(v, _mm256_loadu_si256((const __m256i*)(inputs[first + 4] + offset)), 1);
+}
+
+XXH_FORCE_INLINE XXH_TARGET_AVX512 void
+XXH64_lanes_avx512(xxh_u64* XXH_RESTRICT acc, const xxh_u8* const* XXH_RESTRICT inputs, size_t nbStripes)
+{
+    /* gathers 128-bit blocks 0 and 2 (or 1 and 3) of two vectors, interleaved */
+    __m512i const even = _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0);
+    __m512i const odd  = _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2);
+    __m512i v1 = _mm512_loadu_si512(acc);
+    __m512i v2 = _mm512_loadu_si512(acc + XXH64_LANES_GROUP);
+    __m512i v3 = _mm512_loadu_si512(acc + 2 * XXH64_LANES_GROUP);
+    __m512i v4 = _mm512_loadu_si512(acc + 3 * XXH64_LANES_GROUP);
+    size_t s;
+    for (s = 0; s < nbStripes; s++) {
+        size_t const offset = s * XXH64_STRIPE_LEN;
+        /* row i holds the stripes of lanes { i, i+4 } */
+        __m512i const r0 = XXH64_lanes_load2x256_avx512(inputs, 0, offset);
+        __m512i const r1 = XXH64_lanes_load2x256_avx512(inputs, 1, offset);
+        __m512i const r2 = XXH64_lanes_load2x256_avx512(inputs, 2, offset);
+        __m512i const r3 = XXH64_lanes_load2x256_avx512(inputs, 3, offset);
+        __m512i const t0 = _mm512_unpacklo_epi64(r0, r1);
+        __m512i const t1 = _mm512_unpackhi_epi64(r0, r1);
+        __m512i const t2 = _mm512_unpacklo_epi64(r2, r3);
+        __m512i const t3 = _mm512_unpackhi_epi64(r2, r3);
+        v1 = XXH64_lanes_round_avx512(v1, _mm512_permutex2var_epi64(t0, even, t2));
+        v2 = XXH64_lanes_round_avx512(v2, _mm512_permutex2var_epi64(t1, even, t3));
+        v3 = XXH64_lanes_round_avx512(v3, _mm512_permutex2var_epi64(t0, odd, t2));
+        v4 = XXH64_lanes_round_avx512(v4, _mm512_permutex2var_epi64(t1, odd, t3));
+    }
+    _mm512_storeu_si512(acc, v1);
+    _mm512_storeu_si512(acc + XXH64_LANES_GROUP, v2);
+    _mm512_storeu_si512(acc + 2 * XXH64_LANES_GROUP, v3);
+    _mm512_storeu_si512(acc + 3 * XXH64_LANES_GROUP, v4);
+}
+
+#endif
+
+#if (XXH_VECTOR == XXH_AVX2) || defined(XXH_X86DISPATCH)
+
+XXH_FORCE_INLINE XXH_TARGET_AVX2 __m256i
+XXH32_lanes_round_avx2(__m256i acc, __m256i input)
+{
+    acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(input, _mm256_set1_epi32((int)XXH_PRIME32_2)));
+    acc = _mm256_or_si256(_mm256_slli_epi32(acc, 13), _mm256_srli_epi32(acc, 19));
+    return _mm256_mullo_epi32(acc, _mm256_set1_epi32((int)XXH_PRIME32_1));
+}
+
+XXH_FORCE_INLINE XXH_TARGET_AVX2 __m256i
+XXH32_lanes_load2x128_avx2(const xxh_u8* const* XXH_RESTRICT inputs, size_t first, size_t offset)
+{
+    __m256i const v = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(inputs[first] + offset)));
+    return _mm256_inserti128_si256(v, _mm_loadu_si128((const __m128i*)(inputs[first + 4] + offset)), 1);
+}
+
+/* one stripe of the 8 lanes starting at @inputs */
+XXH_FORCE_INLINE XXH_TARGET_AVX2 void
+XXH32_lanes_stripe_avx2(__m256i* XXH_RESTRICT v1, __m256i* XXH_RESTRICT v2,
+                        __m256i* XXH_RESTRICT v3, __m256i* XXH_RESTRICT v4,
+                        const xxh_u8* const* XXH_RESTRICT inputs, size_t offset)
+{
+    /* row i holds the stripes of lanes { i, i+4 } */
+    __m256i const r0 = XXH32_lanes_load2x128_avx2(inputs, 0, offset);
+    __m256i const r1 = XXH32_lanes_load2x128_avx2(inputs, 1, offset);
+    __m256i const r2 = XXH32_lanes_load2x128_avx2(inputs, 2, offset);
+    __m256i const r3 = XXH32_lanes_load2x128_avx2(inputs, 3, offset);
+    __m256i const t0 = _mm256_unpacklo_epi32(r0, r1);
+    __m256i const t1 = _mm256_unpackhi_epi32(r0, r1);
+    __m256i const t2 = _mm256_unpacklo_epi32(r2, r3);
+    __m256i const t3 = _mm256_unpackhi_epi32(r2, r3);
+    *v1 = XXH32_lanes_round_avx2(*v1, _mm256_unpacklo_epi64(t0, t2));
+    *v2 = XXH32_lanes_round_avx2(*v2, _mm256_unpackhi_epi64(t0, t2));
+    *v3 = XXH32_lanes_round_avx2(*v3, _mm256_unpacklo_epi64(t1, t3));
+    *v4 = XXH32_lanes_round_avx2(*v4, _mm256_unpackhi_epi64(t1, t3));
+}
+
+XXH_FORCE_INLINE XXH_TARGET_AVX2 void
+XXH32_lanes_avx2(xxh_u32* XXH_RESTRICT acc, const xxh_u8* const* XXH_RESTRICT inputs, size_t nbStripes)
+{
+    /* two independent halves of 8 lanes, to hide the latency of VPMULLD */
+    __m256i a1 = _mm256_loadu_si256((const __m256i*)acc);
+    __m256i a2 = _mm256_loadu_si256((const __m256i*)(acc + XXH32_LANES_GROUP));
+    __m256i a3 = _mm256_loadu_si256((const __m256i*)(acc + 2 * XXH32_LANES_GROUP));
+    __m256i a4 = _mm256_loadu_si256((const __m256i*)(acc + 3 * XXH32_LANES_GROUP));
+    __m256i b1 = _mm256_loadu_si256((const __m256i*)(acc + 8));
+    __m256i b2 = _mm256_loadu_si256((const __m256i*)(acc + XXH32_LANES_GROUP + 8));
+    __m256i b3 = _mm256_loadu_si256((const __m256i*)(acc + 2 * XXH32_LANES_GROUP + 8));
+    __m256i b4 = _mm256_loadu_si256((const __m256i*)(acc + 3 * XXH32_LANES_GROUP + 8));
+    size_t s;
+    for (s = 0; s < nbStripes; s++) {
+        XXH32_lanes_stripe_avx2(&a1, &a2, &a3, &a4, inputs, s * XXH32_STRIPE_LEN);
+        XXH32_lanes_stripe_avx2(&b1, &b2, &b3, &b4, inputs + 8, s * XXH32_STRIPE_LEN);
+    }
+    _mm256_storeu_si256((__m256i*)acc, a1);
+    _mm256_storeu_si256((__m256i*)(acc + XXH32_LANES_GROUP), a2);
+    _mm256_storeu_si256((__m256i*)(acc + 2 * XXH32_LANES_GROUP), a3);
+    _mm256_storeu_si256((__m256i*)(acc + 3 * XXH32_LANES_GROUP), a4);
+    _mm256_storeu_si256((__m256i*)(acc + 8), b1);
+    _mm256_storeu_si256((__m256i*)(acc + XXH32_LANES_GROUP + 8), b2);
+    _mm256_storeu_si256((__m256i*)(acc + 2 * XXH32_LANES_GROUP + 8), b3);
+    _mm256_storeu_si256((__m256i*)(acc + 3 * XXH32_LANES_GROUP + 8), b4);
+}
+
+#endif
+
+/* scalar variants - universal */
+
+XXH_FORCE_INLINE void
+XXH32_lanes_scalar(xxh_u32* XXH_RESTRICT acc, const xxh_u8* const* XXH_RESTRICT inputs, size_t nbStripes)
+{
+    size_t i, s;
+    for (i = 0; i < XXH32_LANES_GROUP; i++) {
+        const xxh_u8* p = inputs[i];
+        xxh_u32 v1 = acc[i];
+        xxh_u32 v2 = acc[XXH32_LANES_GROUP + i];
+        xxh_u32 v3 = acc[2 * XXH32_LANES_GROUP + i];
+        xxh_u32 v4 = acc[3 * XXH32_LANES_GROUP + i];
+        for (s = 0; s < nbStripes; s++) {
+            v1 = XXH32_round(v1, XXH_readLE32(p));
+            v2 = XXH32_round(v2, XXH_readLE32(p + 4));
+            v3 = XXH32_round(v3, XXH_readLE32(p + 8));
+            v4 = XXH32_round(v4, XXH_readLE32(p + 12));
+            p += XXH32_STRIPE_LEN;
+        }
+        acc[i] = v1;
+        acc[XXH32_LANES_GROUP + i] = v2;
+        acc[2 * XXH32_LANES_GROUP + i] = v3;
+        acc[3 * XXH32_LANES_GROUP + i] = v4;
+    }
+}
+
+XXH_FORCE_INLINE void
+XXH64_lanes_scalar(xxh_u64* XXH_RESTRICT acc, const xxh_u8* const* XXH_RESTRICT inputs, size_t nbStripes)
+{
+    size_t i, s;
+    for (i = 0; i < XXH64_LANES_GROUP; i++) {
+        const xxh_u8* p = inputs[i];
+        xxh_u64 v1 = acc[i];
+        xxh_u64 v2 = acc[XXH64_LANES_GROUP + i];
+        xxh_u64 v3 = acc[2 * XXH64_LANES_GROUP + i];
+        xxh_u64 v4 = acc[3 * XXH64_LANES_GROUP + i];
+        for (s = 0; s < nbStripes; s++) {
+            v1 = XXH64_round(v1, XXH_readLE64(p));
+            v2 = XXH64_round(v2, XXH_readLE64(p + 8));
+            v3 = XXH64_round(v3, XXH_readLE64(p + 16));
+            v4 = XXH64_round(v4, XXH_readLE64(p + 24));
+            p += XXH64_STRIPE_LEN;
+        }
+        acc[i] = v1;
+        acc[XXH64_LANES_GROUP + i] = v2;
+        acc[2 * XXH64_LANES_GROUP + i] = v3;
+        acc[3 * XXH64_LANES_GROUP + i] = v4;
+    }
+}
+
+#if (XXH_VECTOR == XXH_AVX512)
+#  define XXH32_lanes XXH32_lanes_avx512
+#  define XXH64_lanes XXH64_lanes_avx512
+#elif (XXH_VECTOR == XXH_AVX2)
+#  define XXH32_lanes XXH32_lanes_avx2
+#  define XXH64_lanes XXH64_lanes_scalar
+#else
+#  define XXH32_lanes XXH32_lanes_scalar
+#  define XXH64_lanes XXH64_lanes_scalar
+#endif
+
+/* sets one group of lanes as XXH32_reset() and XXH64_reset() do */
+static void XXH32_lanes_init(xxh_u32* acc, xxh_u32 seed)
+{
+    size_t i;
+    for (i = 0; i < XXH32_LANES_GROUP; i++) {
+        acc[i] = seed + XXH_PRIME32_1 + XXH_PRIME32_2;
+        acc[XXH32_LANES_GROUP + i] = seed + XXH_PRIME32_2;
+        acc[2 * XXH32_LANES_GROUP + i] = seed;
+        acc[3 * XXH32_LANES_GROUP + i] = seed - XXH_PRIME32_1;
+    }
+}
+
+static void XXH64_lanes_init(xxh_u64* acc, xxh_u64 seed)
+{
+    size_t i;
+    for (i = 0; i < XXH64_LANES_GROUP; i++) {
+        acc[i] = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+        acc[XXH64_LANES_GROUP + i] = seed + XXH_PRIME64_2;
+        acc[2 * XXH64_LANES_GROUP + i] = seed;
+        acc[3 * XXH64_LANES_GROUP + i] = seed - XXH_PRIME64_1;
+    }
+}
+
+/* digest of lane @i of a group, @tail being its last totalLen % stripe bytes */
+static xxh_u32
+XXH32_lanes_digestLane(const xxh_u32* acc, size_t i, xxh_u64 totalLen, const xxh_u8* tail)
+{
+    xxh_u32 h32;
+    if (totalLen >= XXH32_STRIPE_LEN) {
+        h32 = XXH_rotl32(acc[i], 1) + XXH_rotl32(acc[XXH32_LANES_GROUP + i], 7)
+            + XXH_rotl32(acc[2 * XXH32_LANES_GROUP + i], 12) + XXH_rotl32(acc[3 * XXH32_LANES_GROUP + i], 18);
+    } else {
+        h32 = acc[2 * XXH32_LANES_GROUP + i] /* seed */ + XXH_PRIME32_5;
+    }
+    h32 += (xxh_u32)totalLen;
+    return XXH32_finalize(h32, tail, (size_t)totalLen & (XXH32_STRIPE_LEN - 1), XXH_unaligned);
+}
+
+static xxh_u64
+XXH64_lanes_digestLane(const xxh_u64* acc, size_t i, xxh_u64 totalLen, const xxh_u8* tail)
+{
+    xxh_u64 h64;
+    if (totalLen >= XXH64_STRIPE_LEN) {
+        xxh_u64 const v1 = acc[i];
+        xxh_u64 const v2 = acc[XXH64_LANES_GROUP + i];
+        xxh_u64 const v3 = acc[2 * XXH64_LANES_GROUP + i];
+        xxh_u64 const v4 = acc[3 * XXH64_LANES_GROUP + i];
+        h64 = XXH_rotl64(v1, 1) + XXH_rotl64(v2, 7) + XXH_rotl64(v3, 12) + XXH_rotl64(v4, 18);
+        h64 = XXH64_mergeRound(h64, v1);
+        h64 = XXH64_mergeRound(h64, v2);
+        h64 = XXH64_mergeRound(h64, v3);
+        h64 = XXH64_mergeRound(h64, v4);
+    } else {
+        h64 = acc[2 * XXH64_LANES_GROUP + i] /* seed */ + XXH_PRIME64_5;
+    }
+    h64 += totalLen;
+    return XXH64_finalize(h64, tail, (size_t)totalLen & (XXH64_STRIPE_LEN - 1), XXH_unaligned);
+}
+
+static void
+XXH32_batch_loop(XXH32_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs, XXH32_hash_t seed)
+{
+    size_t n;
+    for (n = 0; n < nbInputs; n++)
+        dst[n] = XXH32((const xxh_u8*)inputs + n * inputSize, inputSize, seed);
+}
+
+static void
+XXH64_batch_loop(XXH64_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs, XXH64_hash_t seed)
+{
+    size_t n;
+    for (n = 0; n < nbInputs; n++)
+        dst[n] = XXH64((const xxh_u8*)inputs + n * inputSize, inputSize, seed);
+}
+
+/*
+ * Hashes @nbInputs contiguous inputs, one group of lanes at a time.
+ * The last group is padded by repeating the last input.
+ */
+XXH_FORCE_INLINE void
+XXH32_batch_internal(XXH32_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs,
+                     XXH32_hash_t seed, XXH32_f_lanes f_lanes)
+{
+    size_t const nbStripes = inputSize / XXH32_STRIPE_LEN;
+    size_t n;
+    if (nbInputs == 0) return;
+    XXH_ASSERT(dst != NULL);
+    XXH_ASSERT(inputs != NULL || inputSize == 0);
+    if (nbStripes == 0) {
+        XXH32_batch_loop(dst, inputs, inputSize, nbInputs, seed);
+        return;
+    }
+    for (n = 0; n < nbInputs; n += XXH32_LANES_GROUP) {
+        const xxh_u8* lanes[XXH32_LANES_GROUP];
+        xxh_u32 acc[4 * XXH32_LANES_GROUP];
+        size_t i;
+        for (i = 0; i < XXH32_LANES_GROUP; i++) {
+            size_t const k = (n+i < nbInputs) ? n+i : nbInputs-1;
+            lanes[i] = (const xxh_u8*)inputs + k * inputSize;
+        }
+        XXH32_lanes_init(acc, seed);
+        if (nbStripes) f_lanes(acc, lanes, nbStripes);
+        for (i = 0; i < XXH32_LANES_GROUP && n+i < nbInputs; i++)
+            dst[n+i] = XXH32_lanes_digestLane(acc, i, inputSize, lanes[i] + nbStripes * XXH32_STRIPE_LEN);
+    }
+}
+
+XXH_FORCE_INLINE void
+XXH64_batch_internal(XXH64_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs,
+                     XXH64_hash_t seed, XXH64_f_lanes f_lanes)
+{
+    size_t const nbStripes = inputSize / XXH64_STRIPE_LEN;
+    size_t n;
+    if (nbInputs == 0) return;
+    XXH_ASSERT(dst != NULL);
+    XXH_ASSERT(inputs != NULL || inputSize == 0);
+    if (nbStripes == 0) {
+        XXH64_batch_loop(dst, inputs, inputSize, nbInputs, seed);
+        return;
+    }
+    for (n = 0; n < nbInputs; n += XXH64_LANES_GROUP) {
+        const xxh_u8* lanes[XXH64_LANES_GROUP];
+        xxh_u64 acc[4 * XXH64_LANES_GROUP];
+        size_t i;
+        for (i = 0; i < XXH64_LANES_GROUP; i++) {
+            size_t const k = (n+i < nbInputs) ? n+i : nbInputs-1;
+            lanes[i] = (const xxh_u8*)inputs + k * inputSize;
+        }
+        XXH64_lanes_init(acc, seed);
+        if (nbStripes) f_lanes(acc, lanes, nbStripes);
+        for (i = 0; i < XXH64_LANES_GROUP && n+i < nbInputs; i++)
+            dst[n+i] = XXH64_lanes_digestLane(acc, i, inputSize, lanes[i] + nbStripes * XXH64_STRIPE_LEN);
+    }
+}
+
+/* the number of lanes, rounded up to whole groups, padded with the last lane */
+static size_t
+XXH_lanes_pad(const xxh_u8** lanes, size_t nbLanes, size_t groupSize)
+{
+    size_t const nbPadded = (nbLanes + groupSize - 1) / groupSize * groupSize;
+    size_t i;
+    XXH_ASSERT(nbPadded <= XXH_LANES_MAX);
+    for (i = nbLanes; i < nbPadded; i++) lanes[i] = lanes[nbLanes - 1];
+    return nbPadded;
+}
+
+/*
+ * Lockstep streaming: every update appends @len bytes to each stream.
+ * As all streams have the same length, they share a single buffer fill level,
+ * and the stripes of all streams are consumed together.
+ */
+XXH_FORCE_INLINE XXH_errorcode
+XXH32_lanes_update_internal(XXH32_lanesState_t* state, const void* const* inputs, size_t len,
+                            XXH32_f_lanes f_lanes)
+{
+    size_t const nbLanes = state->nbLanes;
+    const xxh_u8* lanes[XXH_LANES_MAX];
+    size_t consumed = 0;
+    size_t nbStripes, nbPadded, tailLen, i, g;
+
+    if (len == 0) return XXH_OK;
+    if (inputs == NULL) return XXH_ERROR;
+    for (i = 0; i < nbLanes; i++)
+        if (inputs[i] == NULL) return XXH_ERROR;
+    state->totalLen += len;
+
+    if (state->memSize + len < XXH32_STRIPE_LEN) {
+        for (i = 0; i < nbLanes; i++)
+            XXH_memcpy(state->mem[i] + state->memSize, inputs[i], len);
+        state->memSize += (unsigned)len;
+        return XXH_OK;
+    }
+
+    if (state->memSize) {
+        consumed = XXH32_STRIPE_LEN - state->memSize;
+        for (i = 0; i < nbLanes; i++) {
+            XXH_memcpy(state->mem[i] + state->memSize, inputs[i], consumed);
+            lanes[i] = state->mem[i];
+        }
+        nbPadded = XXH_lanes_pad(lanes, nbLanes, XXH32_LANES_GROUP);
+        for (g = 0; g < nbPadded; g += XXH32_LANES_GROUP)
+            f_lanes(state->acc + 4 * g, lanes + g, 1);
+    }
+
+    nbStripes = (len - consumed) / XXH32_STRIPE_LEN;
+    for (i = 0; i < nbLanes; i++) lanes[i] = (const xxh_u8*)inputs[i] + consumed;
+    nbPadded = XXH_lanes_pad(lanes, nbLanes, XXH32_LANES_GROUP);
+    if (nbStripes) {
+        for (g = 0; g < nbPadded; g += XXH32_LANES_GROUP)
+            f_lanes(state->acc + 4 * g, lanes + g, nbStripes);
+    }
+
+    tailLen = len - consumed - nbStripes * XXH32_STRIPE_LEN;
+    for (i = 0; i < nbLanes; i++)
+        XXH_memcpy(state->mem[i], lanes[i] + nbStripes * XXH32_STRIPE_LEN, tailLen);
+    state->memSize = (unsigned)tailLen;
+    return XXH_OK;
+}
+
+XXH_FORCE_INLINE XXH_errorcode
+XXH64_lanes_update_internal(XXH64_lanesState_t* state, const void* const* inputs, size_t len,
+                            XXH64_f_lanes f_lanes)
+{
+    size_t const nbLanes = state->nbLanes;
+    const xxh_u8* lanes[XXH_LANES_MAX];
+    size_t consumed = 0;
+    size_t nbStripes, nbPadded, tailLen, i, g;
+
+    if (len == 0) return XXH_OK;
+    if (inputs == NULL) return XXH_ERROR;
+    for (i = 0; i < nbLanes; i++)
+        if (inputs[i] == NULL) return XXH_ERROR;
+    state->totalLen += len;
+
+    if (state->memSize + len < XXH64_STRIPE_LEN) {
+        for (i = 0; i < nbLanes; i++)
+            XXH_memcpy(state->mem[i] + state->memSize, inputs[i], len);
+        state->memSize += (unsigned)len;
+        return XXH_OK;
+    }
+
+    if (state->memSize) {
+        consumed = XXH64_STRIPE_LEN - state->memSize;
+        for (i = 0; i < nbLanes; i++) {
+            XXH_memcpy(state->mem[i] + state->memSize, inputs[i], consumed);
+            lanes[i] = state->mem[i];
+        }
+        nbPadded = XXH_lanes_pad(lanes, nbLanes, XXH64_LANES_GROUP);
+        for (g = 0; g < nbPadded; g += XXH64_LANES_GROUP)
+            f_lanes(state->acc + 4 * g, lanes + g, 1);
+    }
+
+    nbStripes = (len - consumed) / XXH64_STRIPE_LEN;
+    for (i = 0; i < nbLanes; i++) lanes[i] = (const xxh_u8*)inputs[i] + consumed;
+    nbPadded = XXH_lanes_pad(lanes, nbLanes, XXH64_LANES_GROUP);
+    if (nbStripes) {
+        for (g = 0; g < nbPadded; g += XXH64_LANES_GROUP)
+            f_lanes(state->acc + 4 * g, lanes + g, nbStripes);
+    }
+
+    tailLen = len - consumed - nbStripes * XXH64_STRIPE_LEN;
+    for (i = 0; i < nbLanes; i++)
+        XXH_memcpy(state->mem[i], lanes[i] + nbStripes * XXH64_STRIPE_LEN, tailLen);
+    state->memSize = (unsigned)tailLen;
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API void
+XXH32_batch(XXH32_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs, XXH32_hash_t seed)
+{
+#if (XXH_VECTOR == XXH_AVX512) || (XXH_VECTOR == XXH_AVX2)
+    XXH32_batch_internal(dst, inputs, inputSize, nbInputs, seed, XXH32_lanes);
+#else
+    XXH32_batch_loop(dst, inputs, inputSize, nbInputs, seed);
+#endif
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH32_lanes_reset(XXH32_lanesState_t* statePtr, size_t nbLanes, XXH32_hash_t seed)
+{
+    size_t g;
+    if (statePtr == NULL) return XXH_ERROR;
+    if (nbLanes == 0 || nbLanes > XXH_LANES_MAX) return XXH_ERROR;
+    for (g = 0; g < XXH_LANES_MAX; g += XXH32_LANES_GROUP)
+        XXH32_lanes_init(statePtr->acc + 4 * g, seed);
+    statePtr->totalLen = 0;
+    statePtr->nbLanes = (unsigned)nbLanes;
+    statePtr->memSize = 0;
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH32_lanes_update(XXH32_lanesState_t* statePtr, const void* const* inputs, size_t len)
+{
+    return XXH32_lanes_update_internal(statePtr, inputs, len, XXH32_lanes);
+}
+
+XXH_PUBLIC_API void XXH32_lanes_digest(const XXH32_lanesState_t* statePtr, XXH32_hash_t* dst)
+{
+    size_t i;
+    for (i = 0; i < statePtr->nbLanes; i++) {
+        size_t const g = i / XXH32_LANES_GROUP * XXH32_LANES_GROUP;
+        dst[i] = XXH32_lanes_digestLane(statePtr->acc + 4 * g, i - g, statePtr->totalLen, statePtr->mem[i]);
+    }
+}
+
+XXH_PUBLIC_API void
+XXH64_batch(XXH64_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs, XXH64_hash_t seed)
+{
+#if (XXH_VECTOR == XXH_AVX512)
+    XXH64_batch_internal(dst, inputs, inputSize, nbInputs, seed, XXH64_lanes);
+#else
+    XXH64_batch_loop(dst, inputs, inputSize, nbInputs, seed);
+#endif
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH64_lanes_reset(XXH64_lanesState_t* statePtr, size_t nbLanes, XXH64_hash_t seed)
+{
+    size_t g;
+    if (statePtr == NULL) return XXH_ERROR;
+    if (nbLanes == 0 || nbLanes > XXH_LANES_MAX) return XXH_ERROR;
+    for (g = 0; g < XXH_LANES_MAX; g += XXH64_LANES_GROUP)
+        XXH64_lanes_init(statePtr->acc + 4 * g, seed);
+    statePtr->totalLen = 0;
+    statePtr->nbLanes = (unsigned)nbLanes;
+    statePtr->memSize = 0;
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH64_lanes_update(XXH64_lanesState_t* statePtr, const void* const* inputs, size_t len)
+{
+    return XXH64_lanes_update_internal(statePtr, inputs, len, XXH64_lanes);
+}
+
+XXH_PUBLIC_API void XXH64_lanes_digest(const XXH64_lanesState_t* statePtr, XXH64_hash_t* dst)
+{
+    size_t i;
+    for (i = 0; i < statePtr->nbLanes; i++) {
+        size_t const g = i / XXH64_LANES_GROUP * XXH64_LANES_GROUP;
+        dst[i] = XXH64_lanes_digestLane(statePtr->acc + 4 * g, i - g, statePtr->totalLen, statePtr->mem[i]);
+    }
+}
+
+
+/* ===   XXH32 single-stream kernels   === */
+
+/*
+ * The 4 accumulators of a single XXH32 stream fit in one vector,
+ * but as explained in XXH32_round(), each round would then wait for PMULLD,
+ * and measured slower than scalar code (3.2 GB/s with AVX512 VPROLD, vs 4.9).
+ * However, in `acc += input * PRIME32_2`, the product doesn't depend on acc:
+ * the AVX2 kernel computes these products for 2 stripes at once, and leaves
+ * only an add, a rotate and a multiply on each scalar chain,
+ * halving scalar multiplies.
+ * XXH64 has no equivalent: VPMULLQ products were measured slower than scalar.
+ * Only used by xxh_x86dispatch.c, XXH32() itself stays unchanged.
+ * tests/bench measures each kernel.
+ */
+
+typedef void (*XXH32_f_stripes)(xxh_u32* XXH_RESTRICT acc, const xxh_u8* XXH_RESTRICT input, size_t nbStripes);
+
+XXH_FORCE_INLINE void
+XXH32_stripes_scalar(xxh_u32* XXH_RESTRICT acc, const xxh_u8* XXH_RESTRICT input, size_t nbStripes)
+{
+    xxh_u32 v1 = acc[0], v2 = acc[1], v3 = acc[2], v4 = acc[3];
+    size_t s;
+    for (s = 0; s < nbStripes; s++) {
+        v1 = XXH32_round(v1, XXH_readLE32(input));
+        v2 = XXH32_round(v2, XXH_readLE32(input + 4));
+        v3 = XXH32_round(v3, XXH_readLE32(input + 8));
+        v4 = XXH32_round(v4, XXH_readLE32(input + 12));
+        input += 16;
+    }
+    acc[0] = v1; acc[1] = v2; acc[2] = v3; acc[3] = v4;
+}
+
+#if (XXH_VECTOR == XXH_AVX2) || defined(XXH_X86DISPATCH)
+
+/* XXH32_round(), with `input * PRIME32_2` already computed */
+XXH_FORCE_INLINE xxh_u32 XXH32_roundProduct(xxh_u32 acc, xxh_u32 product)
+{
+    acc += product;
+    acc  = XXH_rotl32(acc, 13);
+    acc *= XXH_PRIME32_1;
+#if defined(__GNUC__)
+    __asm__("" : "+r" (acc));   /* keeps chains scalar, see XXH32_round() */
+#endif
+    return acc;
+}
+
+XXH_FORCE_INLINE XXH_TARGET_AVX2 void
+XXH32_stripes_avx2(xxh_u32* XXH_RESTRICT acc, const xxh_u8* XXH_RESTRICT input, size_t nbStripes)
+{
+    __m256i const prime2 = _mm256_set1_epi32((int)XXH_PRIME32_2);
+    xxh_u32 v1 = acc[0], v2 = acc[1], v3 = acc[2], v4 = acc[3];
+    size_t s;
+    for (s = 0; s + 2 <= nbStripes; s += 2) {
+        xxh_u32 products[8];
+        __m256i const data = _mm256_loadu_si256((const __m256i*)(input + 16 * s));
+        _mm256_storeu_si256((__m256i*)products, _mm256_mullo_epi32(data, prime2));
+        v1 = XXH32_roundProduct(v1, products[0]);
+        v2 = XXH32_roundProduct(v2, products[1]);
+        v3 = XXH32_roundProduct(v3, products[2]);
+        v4 = XXH32_roundProduct(v4, products[3]);
+        v1 = XXH32_roundProduct(v1, products[4]);
+        v2 = XXH32_roundProduct(v2, products[5]);
+        v3 = XXH32_roundProduct(v3, products[6]);
+        v4 = XXH32_roundProduct(v4, products[7]);
+    }
+    acc[0] = v1; acc[1] = v2; acc[2] = v3; acc[3] = v4;
+    if (s < nbStripes) XXH32_stripes_scalar(acc, input + 16 * s, 1);
+}
+
+#endif
+
+/* XXH32(), consuming stripes with @f_stripes */
+XXH_FORCE_INLINE xxh_u32
+XXH32_stripes_internal(const xxh_u8* input, size_t len, xxh_u32 seed, XXH32_f_stripes f_stripes)
+{
+    xxh_u32 h32;
+
+#if defined(XXH_ACCEPT_NULL_INPUT_POINTER) && (XXH_ACCEPT_NULL_INPUT_POINTER>=1)
+    if (input==NULL) {
+        len=0;
+        input=(const xxh_u8*)(size_t)16;
+    }
+#endif
+
+    if (len>=16) {
+        size_t const nbStripes = len / 16;
+        xxh_u32 acc[4];
+        acc[0] = seed + XXH_PRIME32_1 + XXH_PRIME32_2;
+        acc[1] = seed + XXH_PRIME32_2;
+        acc[2] = seed + 0;
+        acc[3] = seed - XXH_PRIME32_1;
+        f_stripes(acc, input, nbStripes);
+        input += nbStripes * 16;
+        h32 = XXH_rotl32(acc[0], 1)  + XXH_rotl32(acc[1], 7)
+            + XXH_rotl32(acc[2], 12) + XXH_rotl32(acc[3], 18);
+    } else {
+        h32  = seed + XXH_PRIME32_5;
+    }
+
+    h32 += (xxh_u32)len;
+
+    return XXH32_finalize(h32, input, len&15, XXH_unaligned);
+}
+
+/* XXH32_update(), consuming whole stripes of the input with @f_stripes */
+XXH_FORCE_INLINE XXH_errorcode
+XXH32_update_stripes(XXH32_state_t* state, const xxh_u8* input, size_t len, XXH32_f_stripes f_stripes)
+{
+    if (input==NULL)
+#if defined(XXH_ACCEPT_NULL_INPUT_POINTER) && (XXH_ACCEPT_NULL_INPUT_POINTER>=1)
+        return XXH_OK;
+#else
+        return XXH_ERROR;
+#endif
+
+    /* updates which only fill the buffer are left to the scalar version */
+    if (state->memsize + len < 16) return XXH32_update(state, input, len);
+
+    {   const xxh_u8* p = input;
+        const xxh_u8* const bEnd = p + len;
+        xxh_u32 acc[4];
+
+        state->total_len_32 += (XXH32_hash_t)len;
+        state->large_len |= (XXH32_hash_t)((len>=16) | (state->total_len_32>=16));
+
+        acc[0] = state->v1; acc[1] = state->v2; acc[2] = state->v3; acc[3] = state->v4;
+        if (state->memsize) {   /* some data left from previous update */
+            XXH_memcpy((xxh_u8*)(state->mem32) + state->memsize, input, 16-state->memsize);
+            XXH32_stripes_scalar(acc, (const xxh_u8*)state->mem32, 1);
+            p += 16-state->memsize;
+            state->memsize = 0;
+        }
+        {   size_t const nbStripes = (size_t)(bEnd - p) / 16;
+            f_stripes(acc, p, nbStripes);
+            p += nbStripes * 16;
+        }
+        state->v1 = acc[0]; state->v2 = acc[1]; state->v3 = acc[2]; state->v4 = acc[3];
+
+        if (p < bEnd) {
+            XXH_memcpy(state->mem32, p, (size_t)(bEnd-p));
+            state->memsize = (unsigned)(bEnd-p);
+        }
+    }
+
+    return XXH_OK;
+}
+
+
+/* ===   XXH3 streaming   === */
+
+/*
+ * Malloc's a pointer that is always aligned to align.
+ *
+ * This must be freed with `XXH_alignedFree()`.
+ *
+ * malloc typically guarantees 16 byte alignment on 64-bit systems and 8 byte
+ * alignment on 32-bit. This isn't enough for the 32 byte aligned loads in AVX2
+ * or on 32-bit, the 16 byte aligned loads in SSE2 and NEON.
+ *
+ * This underalignment previously caused a rather obvious crash which went
+ * completely unnoticed due to XXH3_createState() not actually being tested.
+ * Credit to RedSpah for noticing this bug.
+ *
+ * The alignment is done manually: Functions like posix_memalign or _mm_malloc
+ * are avoided: To maintain portability, we would have to write a fallback
+ * like this anyways, and besides, testing for the existence of library
+ * functions without relying on external build tools is impossible.
+ *
+ * The method is simple: Overallocate, manually align, and store the offset
+ * to the original behind the returned pointer.
+ *
+ * Align must be a power of 2 and 8 <= align <= 128.
+ */
+static void* XXH_alignedMalloc(size_t s, size_t align)
+{
+    XXH_ASSERT(align <= 128 && align >= 8); /* range check */
+    XXH_ASSERT((align & (align-1)) == 0);   /* power of 2 */
+    XXH_ASSERT(s != 0 && s < (s + align));  /* empty/overflow */
+    {   /* Overallocate to make room for manual realignment and an offset byte */
+        xxh_u8* base = (xxh_u8*)XXH_malloc(s + align);
+        if (base != NULL) {
+            /*
+             * Get the offset needed to align this pointer.
+             *
+             * Even if the returned pointer is aligned, there will always be
+             * at least one byte to store the offset to the original pointer.
+             */
+            size_t offset = align - ((size_t)base & (align - 1)); /* base % align */
+            /* Add the offset for the now-aligned pointer */
+            xxh_u8* ptr = base + offset;
+
+            XXH_ASSERT((size_t)ptr % align == 0);
+
+            /* Store the offset immediately before the returned pointer. */
+            ptr[-1] = (xxh_u8)offset;
+            return ptr;
+        }
+        return NULL;
+    }
+}
+/*
+ * Frees an aligned pointer allocated by XXH_alignedMalloc(). Don't pass
+ * normal malloc'd pointers, XXH_alignedMalloc has a specific data layout.
+ */
+static void XXH_alignedFree(void* p)
+{
+    if (p != NULL) {
+        xxh_u8* ptr = (xxh_u8*)p;
+        /* Get the offset byte we added in XXH_malloc. */
+        xxh_u8 offset = ptr[-1];
+        /* Free the original malloc'd pointer */
+        xxh_u8* base = ptr - offset;
+        XXH_free(base);
+    }
+}
+
+/*
+ * XXH3_STATE_ALLOC, XXH3_STATE_FREE:
+ * Allocator of `XXH3_createState()` and `XXH3_freeState()`.
+ * Both can be defined to draw states from a pool instead of the heap,
+ * e.g. a per-thread free list: `XXH3_STATE_ALLOC()` must return storage of
+ * `XXH3_sizeofState()` bytes aligned on `XXH3_alignofState()`, or NULL,
+ * and `XXH3_STATE_FREE(p)` takes it back (it is never given NULL).
+ */
+#if defined(XXH3_STATE_ALLOC) != defined(XXH3_STATE_FREE)
+#  error "XXH3_STATE_ALLOC and XXH3_STATE_FREE must be defined together"
+#endif
+#ifndef XXH3_STATE_ALLOC
+#  define XXH3_STATE_ALLOC()  XXH_alignedMalloc(sizeof(XXH3_state_t), 64)
+#  define XXH3_STATE_FREE(p)  XXH_alignedFree(p)
+#endif
+
+XXH_PUBLIC_API XXH3_state_t* XXH3_createState(void)
+{
+    return (XXH3_state_t*)XXH3_STATE_ALLOC();
+}
+
+XXH_PUBLIC_API XXH_errorcode XXH3_freeState(XXH3_state_t* statePtr)
+{
+    if (statePtr != NULL) XXH3_STATE_FREE(statePtr);
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API size_t XXH3_sizeofState(void)
+{
+    return sizeof(XXH3_state_t);
+}
+
+XXH_PUBLIC_API size_t XXH3_alignofState(void)
+{
+    return 64;
+}
+
+XXH_PUBLIC_API void
+XXH3_copyState(XXH3_state_t* dst_state, const XXH3_state_t* src_state)
+{
+    memcpy(dst_state, src_state, sizeof(*dst_state));
+}
+
+static void
+XXH3_64bits_reset_internal(XXH3_state_t* statePtr,
+                           XXH64_hash_t seed,
+                           const xxh_u8* secret, size_t secretSize)
+{
+    XXH_ASSERT(statePtr != NULL);
+    memset(statePtr, 0, sizeof(*statePtr));
+    statePtr->acc[0] = XXH_PRIME32_3;
+    statePtr->acc[1] = XXH_PRIME64_1;
+    statePtr->acc[2] = XXH_PRIME64_2;
+    statePtr->acc[3] = XXH_PRIME64_3;
+    statePtr->acc[4] = XXH_PRIME64_4;
+    statePtr->acc[5] = XXH_PRIME32_2;
+    statePtr->acc[6] = XXH_PRIME64_5;
+    statePtr->acc[7] = XXH_PRIME32_1;
+    statePtr->seed = seed;
+    XXH_ASSERT(secret != NULL);
+    statePtr->extSecret = secret;
+    XXH_ASSERT(secretSize >= XXH3_SECRET_SIZE_MIN);
+    statePtr->secretLimit = secretSize - XXH_STRIPE_LEN;
+    statePtr->nbStripesPerBlock = statePtr->secretLimit / XXH_SECRET_CONSUME_RATE;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_reset(XXH3_state_t* statePtr)
+{
+    if (statePtr == NULL) return XXH_ERROR;
+    XXH3_64bits_reset_internal(statePtr, 0, XXH3_kSecret, XXH_SECRET_DEFAULT_SIZE);
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH3_state_t* XXH3_initStaticState(void* workspace, size_t workspaceSize)
+{
+    XXH3_state_t* const statePtr = (XXH3_state_t*)
+        XXH_alignWorkspace(workspace, workspaceSize, sizeof(XXH3_state_t), XXH3_alignofState());
+    if (statePtr != NULL) (void)XXH3_64bits_reset(statePtr);
+    return statePtr;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_reset_withSecret(XXH3_state_t* statePtr, const void* secret, size_t secretSize)
+{
+    if (statePtr == NULL) return XXH_ERROR;
+    XXH3_64bits_reset_internal(statePtr, 0, (const xxh_u8*)secret, secretSize);
+    if (secret == NULL) return XXH_ERROR;
+    if (secretSize < XXH3_SECRET_SIZE_MIN) return XXH_ERROR;
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_reset_withSeed(XXH3_state_t* statePtr, XXH64_hash_t seed)
+{
+    if (statePtr == NULL) return XXH_ERROR;
+    XXH3_64bits_reset_internal(statePtr, seed, XXH3_kSecret, XXH_SECRET_DEFAULT_SIZE);
+    XXH3_initCustomSecret(statePtr->customSecret, seed);
+    statePtr->extSecret = NULL;
+    statePtr->useSeed = 1;
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_reset_withSecretandSeed(XXH3_state_t* statePtr, const void* secret, size_t secretSize, XXH64_hash_t seed)
+{
+    if (statePtr == NULL) return XXH_ERROR;
+    if (secret == NULL) return XXH_ERROR;
+    if (secretSize < XXH3_SECRET_SIZE_MIN) return XXH_ERROR;
+    XXH3_64bits_reset_internal(statePtr, seed, (const xxh_u8*)secret, secretSize);
+    statePtr->useSeed = 1;
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_reset_withSeededContext(XXH3_state_t* statePtr, const XXH3_seededContext_t* ctx)
+{
+    if (ctx == NULL) return XXH_ERROR;
+    return XXH3_64bits_reset_withSecretandSeed(statePtr, ctx->secret, sizeof(ctx->secret), ctx->seed);
+}
+
+/*
+ * Consumes any number of stripes: the end of the current block,
+ * whole blocks, as in XXH3_hashLong_internal_loop(), then the start of the next block.
+ */
+#define XXH3_DEFAULT_STRIPES_PER_BLOCK ((XXH3_SECRET_DEFAULT_SIZE - XXH_STRIPE_LEN) / XXH_SECRET_CONSUME_RATE)
+
+XXH_FORCE_INLINE void
+XXH3_consumeStripes(xxh_u64* XXH_RESTRICT acc,
+                    size_t* XXH_RESTRICT nbStripesSoFarPtr, size_t nbStripesPerBlock,
+                    const xxh_u8* XXH_RESTRICT input, size_t nbStripes,
+                    const xxh_u8* XXH_RESTRICT secret, size_t secretLimit,
+                    XXH3_accWidth_e accWidth,
+                    XXH3_f_accumulate_512 f_acc512,
+                    XXH3_f_scrambleAcc f_scramble)
+{
+    size_t const nbStripesToEndofBlock = nbStripesPerBlock - *nbStripesSoFarPtr;
+    XXH_ASSERT(*nbStripesSoFarPtr < nbStripesPerBlock);
+    if (nbStripes >= nbStripesToEndofBlock) {
+        XXH3_accumulate(acc, input, secret + nbStripesSoFarPtr[0] * XXH_SECRET_CONSUME_RATE, nbStripesToEndofBlock, accWidth, f_acc512);
+        f_scramble(acc, secret + secretLimit);
+        if (accWidth == XXH3_acc_dual) f_scramble(acc + XXH_ACC_NB, secret + secretLimit);
+        input += nbStripesToEndofBlock * XXH_STRIPE_LEN;
+        nbStripes -= nbStripesToEndofBlock;
+        if (nbStripesPerBlock == XXH3_DEFAULT_STRIPES_PER_BLOCK) {
+            /* a constant stripe count lets the compiler unroll, as in one-shot mode */
+            while (nbStripes >= XXH3_DEFAULT_STRIPES_PER_BLOCK) {
+                XXH3_accumulate(acc, input, secret, XXH3_DEFAULT_STRIPES_PER_BLOCK, accWidth, f_acc512);
+                f_scramble(acc, secret + secretLimit);
+                if (accWidth == XXH3_acc_dual) f_scramble(acc + XXH_ACC_NB, secret + secretLimit);
+                input += XXH3_DEFAULT_STRIPES_PER_BLOCK * XXH_STRIPE_LEN;
+                nbStripes -= XXH3_DEFAULT_STRIPES_PER_BLOCK;
+        }   }
+        while (nbStripes >= nbStripesPerBlock) {
+            XXH3_accumulate(acc, input, secret, nbStripesPerBlock, accWidth, f_acc512);
+            f_scramble(acc, secret + secretLimit);
+            if (accWidth == XXH3_acc_dual) f_scramble(acc + XXH_ACC_NB, secret + secretLimit);
+            input += nbStripesPerBlock * XXH_STRIPE_LEN;
+            nbStripes -= nbStripesPerBlock;
+        }
+        *nbStripesSoFarPtr = 0;
+    }
+    XXH3_accumulate(acc, input, secret + nbStripesSoFarPtr[0] * XXH_SECRET_CONSUME_RATE, nbStripes, accWidth, f_acc512);
+    *nbStripesSoFarPtr += nbStripes;
+}
+
+/*
+ * Consumes the internal buffer, completed to a whole stripe, then whole
+ * stripes straight from @input, and keeps the last stripe for the digest.
+ * Returns the remaining input, shorter than a stripe.
+ */
+XXH_FORCE_INLINE const xxh_u8*
+XXH3_consumeInput(XXH3_state_t* state, xxh_u64* XXH_RESTRICT acc,
+                  const xxh_u8* input, const xxh_u8* bEnd,
+                  const xxh_u8* XXH_RESTRICT secret,
+                  XXH3_accWidth_e accWidth,
+                  XXH3_f_accumulate_512 f_acc512,
+                  XXH3_f_scrambleAcc f_scramble)
+{
+    const xxh_u8* lastStripe = NULL;
+
+    /*
+     * There is some input left inside the internal buffer.
+     * Complete its last stripe, then consume it.
+     */
+    if (state->bufferedSize) {
+        size_t const loadSize = (XXH_STRIPE_LEN - state->bufferedSize % XXH_STRIPE_LEN) % XXH_STRIPE_LEN;
+        size_t const nbStripes = (state->bufferedSize + loadSize) / XXH_STRIPE_LEN;
+        XXH_memcpy(state->buffer + state->bufferedSize, input, loadSize);
+        input += loadSize;
+        XXH3_consumeStripes(acc,
+                           &state->nbStripesSoFar, state->nbStripesPerBlock,
+                           state->buffer, nbStripes,
+                           secret, state->secretLimit,
+                           accWidth, f_acc512, f_scramble);
+        lastStripe = state->buffer + (nbStripes - 1) * XXH_STRIPE_LEN;
+        state->bufferedSize = 0;
+    }
+
+    /* Consume whole stripes directly from input */
+    {   size_t const nbStripes = (size_t)(bEnd - input) / XXH_STRIPE_LEN;
+        if (nbStripes) {
+            XXH3_consumeStripes(acc,
+                               &state->nbStripesSoFar, state->nbStripesPerBlock,
+                               input, nbStripes,
+                               secret, state->secretLimit,
+                               accWidth, f_acc512, f_scramble);
+            input += nbStripes * XXH_STRIPE_LEN;
+            lastStripe = input - XXH_STRIPE_LEN;
+    }   }
+
+    /* for last partial stripe */
+    XXH_ASSERT(lastStripe != NULL);
+    if (lastStripe != state->buffer + sizeof(state->buffer) - XXH_STRIPE_LEN)
+        memcpy(state->buffer + sizeof(state->buffer) - XXH_STRIPE_LEN, lastStripe, XXH_STRIPE_LEN);
+    return input;
+}
+
+/*
+ * Accumulates into @acc, which is `state->acc`,
+ * or the 2 sets of accumulators of a XXH3_dualState_t.
+ *
+ * Once the internal buffer overflows, whole stripes are consumed straight
+ * from @input, and only the last partial stripe is buffered:
+ * stripe-aligned input is never copied, besides its last stripe.
+ */
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_update_accs(XXH3_state_t* state, xxh_u64* XXH_RESTRICT acc,
+                 const xxh_u8* input, size_t len,
+                 XXH3_accWidth_e accWidth,
+                 XXH3_f_accumulate_512 f_acc512,
+                 XXH3_f_scrambleAcc f_scramble)
+{
+    if (input==NULL)
+#if defined(XXH_ACCEPT_NULL_INPUT_POINTER) && (XXH_ACCEPT_NULL_INPUT_POINTER>=1)
+        return XXH_OK;
+#else
+        return XXH_ERROR;
+#endif
+
+    {   const xxh_u8* const bEnd = input + len;
+        const unsigned char* const secret = (state->extSecret == NULL) ? state->customSecret : state->extSecret;
+
+        state->totalLen += len;
+
+        if (state->bufferedSize + len <= XXH3_INTERNALBUFFER_SIZE) {  /* fill in tmp buffer */
+            XXH_memcpy(state->buffer + state->bufferedSize, input, len);
+            state->bufferedSize += (XXH32_hash_t)len;
+            return XXH_OK;
+        }
+        /* input is now > XXH3_INTERNALBUFFER_SIZE */
+
+        #define XXH3_INTERNALBUFFER_STRIPES (XXH3_INTERNALBUFFER_SIZE / XXH_STRIPE_LEN)
+        XXH_STATIC_ASSERT(XXH3_INTERNALBUFFER_SIZE % XXH_STRIPE_LEN == 0);   /* clean multiple */
+
+        if (accWidth == XXH3_acc_dual) {
+            input = XXH3_consumeInput(state, acc, input, bEnd, secret, accWidth, f_acc512, f_scramble);
+        } else {
+            /* on a local copy, the compiler can keep the accumulators in registers */
+            XXH_ALIGN(XXH_ACC_ALIGN) xxh_u64 localAcc[XXH_ACC_NB];
+            memcpy(localAcc, acc, sizeof(localAcc));
+            input = XXH3_consumeInput(state, localAcc, input, bEnd, secret, accWidth, f_acc512, f_scramble);
+            memcpy(acc, localAcc, sizeof(localAcc));
+        }
+
+        if (input < bEnd) { /* Some remaining input: buffer it */
+            XXH_memcpy(state->buffer, input, (size_t)(bEnd-input));
+            state->bufferedSize = (XXH32_hash_t)(bEnd-input);
+        }
+    }
+
+    return XXH_OK;
+}
+
+/*
+ * Both XXH3_64bits_update and XXH3_128bits_update use this routine.
+ */
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_update(XXH3_state_t* state,
+            const xxh_u8* input, size_t len,
+            XXH3_accWidth_e accWidth,
+            XXH3_f_accumulate_512 f_acc512,
+            XXH3_f_scrambleAcc f_scramble)
+{
+    return XXH3_update_accs(state, state->acc, input, len, accWidth, f_acc512, f_scramble);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_update(XXH3_state_t* state, const void* input, size_t len)
+{
+    return XXH3_update(state, (const xxh_u8*)input, len,
+                       XXH3_acc_64bits, XXH3_accumulate_512, XXH3_scrambleAcc);
+}
+
+
+XXH_FORCE_INLINE void
+XXH3_digest_long (XXH64_hash_t* acc,
+                  const XXH64_hash_t* stateAcc,
+                  const XXH3_state_t* state,
+                  const unsigned char* secret,
+                  XXH3_accWidth_e accWidth)
+{
+    /*
+     * Digest on a local copy. This way, the state remains unaltered, and it can
+     * continue ingesting more input afterwards.
+     */
+    memcpy(acc, stateAcc, (accWidth == XXH3_acc_dual) ? 2 * sizeof(state->acc) : sizeof(state->acc));
+    if (state->bufferedSize >= XXH_STRIPE_LEN) {
+        size_t const nbStripes = state->bufferedSize / XXH_STRIPE_LEN;
+        size_t nbStripesSoFar = state->nbStripesSoFar;
+        XXH3_consumeStripes(acc,
+                           &nbStripesSoFar, state->nbStripesPerBlock,
+                            state->buffer, nbStripes,
+                            secret, state->secretLimit,
+                            accWidth, XXH3_accumulate_512, XXH3_scrambleAcc);
+        if (state->bufferedSize % XXH_STRIPE_LEN) {  /* one last partial stripe */
+            XXH3_accumulate_512(acc,
+                                state->buffer + state->bufferedSize - XXH_STRIPE_LEN,
+                                secret + state->secretLimit - XXH_SECRET_LASTACC_START,
+                                accWidth);
+        }
+    } else {  /* bufferedSize < XXH_STRIPE_LEN */
+        if (state->bufferedSize) { /* one last stripe */
+            xxh_u8 lastStripe[XXH_STRIPE_LEN];
+            size_t const catchupSize = XXH_STRIPE_LEN - state->bufferedSize;
+            memcpy(lastStripe, state->buffer + sizeof(state->buffer) - catchupSize, catchupSize);
+            memcpy(lastStripe + catchupSize, state->buffer, state->bufferedSize);
+            XXH3_accumulate_512(acc,
+                                lastStripe,
+                                secret + state->secretLimit - XXH_SECRET_LASTACC_START,
+                                accWidth);
+    }   }
+}
+
+XXH_PUBLIC_API XXH64_hash_t XXH3_64bits_digest (const XXH3_state_t* state)
+{
+    const unsigned char* const secret = (state->extSecret == NULL) ? state->customSecret : state->extSecret;
+    if (state->totalLen > XXH3_MIDSIZE_MAX) {
+        XXH_ALIGN(XXH_ACC_ALIGN) XXH64_hash_t acc[XXH_ACC_NB];
+        XXH3_digest_long(acc, state->acc, state, secret, XXH3_acc_64bits);
+        return XXH3_mergeAccs(acc,
+                              secret + XXH_SECRET_MERGEACCS_START,
+                              (xxh_u64)state->totalLen * XXH_PRIME64_1);
+    }
+    /* totalLen <= XXH3_MIDSIZE_MAX: digesting a short input */
+    if (state->useSeed)
+        return XXH3_64bits_withSeed(state->buffer, (size_t)state->totalLen, state->seed);
+    return XXH3_64bits_withSecret(state->buffer, (size_t)(state->totalLen),
+                                  secret, state->secretLimit + XXH_STRIPE_LEN);
+}
+
+
+#define XXH_MIN(x, y) (((x) > (y)) ? (y) : (x))
+
+XXH_PUBLIC_API void
+XXH3_generateSecret(void* secretBuffer, const void* customSeed, size_t customSeedSize)
+{
+    XXH_ASSERT(secretBuffer != NULL);
+    if (customSeedSize == 0) {
+        memcpy(secretBuffer, XXH3_kSecret, XXH_SECRET_DEFAULT_SIZE);
+        return;
+    }
+    XXH_ASSERT(customSeed != NULL);
+
+    {   size_t const segmentSize = sizeof(XXH128_hash_t);
+        size_t const nbSegments = XXH_SECRET_DEFAULT_SIZE / segmentSize;
+        XXH128_canonical_t scrambler;
+        XXH64_hash_t seeds[12];
+        size_t segnb;
+        XXH_ASSERT(nbSegments == 12);
+        XXH_ASSERT(segmentSize * nbSegments == XXH_SECRET_DEFAULT_SIZE); /* exact multiple */
+        XXH128_canonicalFromHash(&scrambler, XXH128(customSeed, customSeedSize, 0));
+
+        /*
+        * Copy customSeed to seeds[], truncating or repeating as necessary.
+        */
+        {   size_t toFill = XXH_MIN(customSeedSize, sizeof(seeds));
+            size_t filled = toFill;
+            memcpy(seeds, customSeed, toFill);
+            while (filled < sizeof(seeds)) {
+                toFill = XXH_MIN(filled, sizeof(seeds) - filled);
+                memcpy((char*)seeds + filled, seeds, toFill);
+                filled += toFill;
+        }   }
+
+        /* generate secret */
+        memcpy(secretBuffer, &scrambler, sizeof(scrambler));
+        for (segnb=1; segnb < nbSegments; segnb++) {
+            size_t const segmentStart = segnb * segmentSize;
+            XXH128_canonical_t segment;
+            XXH128_canonicalFromHash(&segment,
+                XXH128(&scrambler, sizeof(scrambler), XXH_readLE64(seeds + segnb) + segnb) );
+            memcpy((char*)secretBuffer + segmentStart, &segment, sizeof(segment));
+    }   }
+}
+
+
+/* ==========================================
+ * XXH3 128 bits (a.k.a XXH128)
+ * ==========================================
+ * XXH3's 128-bit variant has better mixing and strength than the 64-bit variant,
+ * even without counting the significantly larger output size.
+ *
+ * For example, extra steps are taken to avoid the seed-dependent collisions
+ * in 17-240 byte inputs (See XXH3_mix16B and XXH128_mix32B).
+ *
+ * This strength naturally comes at the cost of some speed, especially on short
+ * lengths. Note that longer hashes are about as fast as the 64-bit version
+ * due to it using only a slight modification of the 64-bit loop.
+ *
+ * XXH128 is also more oriented towards 64-bit machines. It is still extremely
+ * fast for a _128-bit_ hash on 32-bit (it usually clears XXH64).
+ */
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_len_1to3_128b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
+{
+    /* A doubled version of 1to3_64b with different constants. */
+    XXH_ASSERT(input != NULL);
+    XXH_ASSERT(1 <= len && len <= 3);
+    XXH_ASSERT(secret != NULL);
+    /*
+     * len = 1: combinedl = { input[0], 0x01, input[0], input[0] }
+     * len = 2: combinedl = { input[1], 0x02, input[0], input[1] }
+     * len = 3: combinedl = { input[2], 0x03, input[0], input[1] }
+     */
+    {   xxh_u8 const c1 = input[0];
+        xxh_u8 const c2 = input[len >> 1];
+        xxh_u8 const c3 = input[len - 1];
+        xxh_u32 const combinedl = ((xxh_u32)c1 <<16) | ((xxh_u32)c2 << 24)
+                                | ((xxh_u32)c3 << 0) | ((xxh_u32)len << 8);
+        xxh_u32 const combinedh = XXH_rotl32(XXH_swap32(combinedl), 13);
+        xxh_u64 const bitflipl = (XXH_readLE32(secret) ^ XXH_readLE32(secret+4)) + seed;
+        xxh_u64 const bitfliph = (XXH_readLE32(secret+8) ^ XXH_readLE32(secret+12)) - seed;
+        xxh_u64 const keyed_lo = (xxh_u64)combinedl ^ bitflipl;
+        xxh_u64 const keyed_hi = (xxh_u64)combinedh ^ bitfliph;
+        xxh_u64 const mixedl = keyed_lo * XXH_PRIME64_1;
+        xxh_u64 const mixedh = keyed_hi * XXH_PRIME64_5;
+        XXH128_hash_t h128;
+        h128.low64  = XXH3_avalanche(mixedl);
+        h128.high64 = XXH3_avalanche(mixedh);
+        return h128;
+    }
+}
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_len_4to8_128b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
+{
+    XXH_ASSERT(input != NULL);
+    XXH_ASSERT(secret != NULL);
+    XXH_ASSERT(4 <= len && len <= 8);
+    seed ^= (xxh_u64)XXH_swap32((xxh_u32)seed) << 32;
+    {   xxh_u32 const input_lo = XXH_readLE32(input);
+        xxh_u32 const input_hi = XXH_readLE32(input + len - 4);
+        xxh_u64 const input_64 = input_lo + ((xxh_u64)input_hi << 32);
+        xxh_u64 const bitflip = (XXH_readLE64(secret+16) ^ XXH_readLE64(secret+24)) + seed;
+        xxh_u64 const keyed = input_64 ^ bitflip;
+
+        /* Shift len to the left to ensure it is even, this avoids even multiplies. */
+        XXH128_hash_t m128 = XXH_mult64to128(keyed, XXH_PRIME64_1 + (len << 2));
+
+        m128.high64 += (m128.low64 << 1);
+        m128.low64  ^= (m128.high64 >> 3);
+
+        m128.low64   = XXH_xorshift64(m128.low64, 35);
+        m128.low64  *= 0x9FB21C651E98DF25ULL;
+        m128.low64   = XXH_xorshift64(m128.low64, 28);
+        m128.high64  = XXH3_avalanche(m128.high64);
+        return m128;
+    }
+}
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_len_9to16_128b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
+{
+    XXH_ASSERT(input != NULL);
+    XXH_ASSERT(secret != NULL);
+    XXH_ASSERT(9 <= len && len <= 16);
+    {   xxh_u64 const bitflipl = (XXH_readLE64(secret+32) ^ XXH_readLE64(secret+40)) - seed;
+        xxh_u64 const bitfliph = (XXH_readLE64(secret+48) ^ XXH_readLE64(secret+56)) + seed;
+        xxh_u64 const input_lo = XXH_readLE64(input);
+        xxh_u64       input_hi = XXH_readLE64(input + len - 8);
+        XXH128_hash_t m128 = XXH_mult64to128(input_lo ^ input_hi ^ bitflipl, XXH_PRIME64_1);
+        /*
+         * Put len in the middle of m128 to ensure that the length gets mixed to
+         * both the low and high bits in the 128x64 multiply below.
+         */
+        m128.low64 += (xxh_u64)(len - 1) << 54;
+        input_hi   ^= bitfliph;
+        /*
+         * Add the high 32 bits of input_hi to the high 32 bits of m128, then
+         * add the long product of the low 32 bits of input_hi and XXH_PRIME32_2 to
+         * the high 64 bits of m128.
+         *
+         * The best approach to this operation is different on 32-bit and 64-bit.
+         */
+        if (sizeof(void *) < sizeof(xxh_u64)) { /* 32-bit */
+            /*
+             * 32-bit optimized version, which is more readable.
+             *
+             * On 32-bit, it removes an ADC and delays a dependency between the two
+             * halves of m128.high64, but it generates an extra mask on 64-bit.
+             */
+            m128.high64 += (input_hi & 0xFFFFFFFF00000000) + XXH_mult32to64((xxh_u32)input_hi, XXH_PRIME32_2);
+        } else {
+            /*
+             * 64-bit optimized (albeit more confusing) version.
+             *
+             * Uses some properties of addition and multiplication to remove the mask:
+             *
+             * Let:
+             *    a = input_hi.lo = (input_hi & 0x00000000FFFFFFFF)
+             *    b = input_hi.hi = (input_hi & 0xFFFFFFFF00000000)
+             *    c = XXH_PRIME32_2
+             *
+             *    a + (b * c)
+             * Inverse Property: x + y - x == y
+             *    a + (b * (1 + c - 1))
+             * Distributive Property: x * (y + z) == (x * y) + (x * z)
+             *    a + (b * 1) + (b * (c - 1))
+             * Identity Property: x * 1 == x
+             *    a + b + (b * (c - 1))
+             *
+             * Substitute a, b, and c:
+             *    input_hi.hi + input_hi.lo + ((xxh_u64)input_hi.lo * (XXH_PRIME32_2 - 1))
+             *
+             * Since input_hi.hi + input_hi.lo == input_hi, we get this:
+             *    input_hi + ((xxh_u64)input_hi.lo * (XXH_PRIME32_2 - 1))
+             */
+            m128.high64 += input_hi + XXH_mult32to64((xxh_u32)input_hi, XXH_PRIME32_2 - 1);
+        }
+        /* m128 ^= XXH_swap64(m128 >> 64); */
+        m128.low64  ^= XXH_swap64(m128.high64);
+
+        {   /* 128x64 multiply: h128 = m128 * XXH_PRIME64_2; */
+            XXH128_hash_t h128 = XXH_mult64to128(m128.low64, XXH_PRIME64_2);
+            h128.high64 += m128.high64 * XXH_PRIME64_2;
+
+            h128.low64   = XXH3_avalanche(h128.low64);
+            h128.high64  = XXH3_avalanche(h128.high64);
+            return h128;
+    }   }
+}
+
+/*
+ * Assumption: `secret` size is >= XXH3_SECRET_SIZE_MIN
+ */
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_len_0to16_128b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
+{
+    XXH_ASSERT(len <= 16);
+    {   if (len > 8) return XXH3_len_9to16_128b(input, len, secret, seed);
+        if (len >= 4) return XXH3_len_4to8_128b(input, len, secret, seed);
+        if (len) return XXH3_len_1to3_128b(input, len, secret, seed);
+        {   XXH128_hash_t h128;
+            xxh_u64 const bitflipl = XXH_readLE64(secret+64) ^ XXH_readLE64(secret+72);
+            xxh_u64 const bitfliph = XXH_readLE64(secret+80) ^ XXH_readLE64(secret+88);
+            h128.low64 = XXH3_avalanche((XXH_PRIME64_1 + seed) ^ bitflipl);
+            h128.high64 = XXH3_avalanche((XXH_PRIME64_2 - seed) ^ bitfliph);
+            return h128;
+    }   }
+}
+
+/*
+ * A bit slower than XXH3_mix16B, but handles multiply by zero better.
+ */
+XXH_FORCE_INLINE XXH128_hash_t
+XXH128_mix32B(XXH128_hash_t acc, const xxh_u8* input_1, const xxh_u8* input_2,
+              const xxh_u8* secret, XXH64_hash_t seed)
+{
+    acc.low64  += XXH3_mix16B (input_1, secret+0, seed);
+    acc.low64  ^= XXH_readLE64(input_2) + XXH_readLE64(input_2 + 8);
+    acc.high64 += XXH3_mix16B (input_2, secret+16, seed);
+    acc.high64 ^= XXH_readLE64(input_1) + XXH_readLE64(input_1 + 8);
+    return acc;
+}
+
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_len_17to128_128b(const xxh_u8* XXH_RESTRICT input, size_t len,
+                      const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
+                      XXH64_hash_t seed)
+{
+    XXH_ASSERT(secretSize >= XXH3_SECRET_SIZE_MIN); (void)secretSize;
+    XXH_ASSERT(16 < len && len <= 128);
+
+    {   XXH128_hash_t acc;
+        acc.low64 = len * XXH_PRIME64_1;
+        acc.high64 = 0;
+        if (len > 32) {
+            if (len > 64) {
+                if (len > 96) {
+                    acc = XXH128_mix32B(acc, input+48, input+len-64, secret+96, seed);
+                }
+                acc = XXH128_mix32B(acc, input+32, input+len-48, secret+64, seed);
+            }
+            acc = XXH128_mix32B(acc, input+16, input+len-32, secret+32, seed);
+        }
+        acc = XXH128_mix32B(acc, input, input+len-16, secret, seed);
+        {   XXH128_hash_t h128;
+            h128.low64  = acc.low64 + acc.high64;
+            h128.high64 = (acc.low64    * XXH_PRIME64_1)
+                        + (acc.high64   * XXH_PRIME64_4)
+                        + ((len - seed) * XXH_PRIME64_2);
+            h128.low64  = XXH3_avalanche(h128.low64);
+            h128.high64 = (XXH64_hash_t)0 - XXH3_avalanche(h128.high64);
+            return h128;
+        }
+    }
+}
+
+XXH_NO_INLINE XXH128_hash_t
+XXH3_len_129to240_128b(const xxh_u8* XXH_RESTRICT input, size_t len,
+                       const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
+                       XXH64_hash_t seed)
+{
+    XXH_ASSERT(secretSize >= XXH3_SECRET_SIZE_MIN); (void)secretSize;
+    XXH_ASSERT(128 < len && len <= XXH3_MIDSIZE_MAX);
+
+    {   XXH128_hash_t acc;
+        int const nbRounds = (int)len / 32;
+        int i;
+        acc.low64 = len * XXH_PRIME64_1;
+        acc.high64 = 0;
+        for (i=0; i<4; i++) {
+            acc = XXH128_mix32B(acc,
+                                input  + (32 * i),
+                                input  + (32 * i) + 16,
+                                secret + (32 * i),
+                                seed);
+        }
+        acc.low64 = XXH3_avalanche(acc.low64);
+        acc.high64 = XXH3_avalanche(acc.high64);
+        XXH_ASSERT(nbRounds >= 4);
+        for (i=4 ; i < nbRounds; i++) {
+            acc = XXH128_mix32B(acc,
+                                input + (32 * i),
+                                input + (32 * i) + 16,
+                                secret + XXH3_MIDSIZE_STARTOFFSET + (32 * (i - 4)),
+                                seed);
+        }
+        /* last bytes */
+        acc = XXH128_mix32B(acc,
+                            input + len - 16,
+                            input + len - 32,
+                            secret + XXH3_SECRET_SIZE_MIN - XXH3_MIDSIZE_LASTOFFSET - 16,
+                            0ULL - seed);
+
+        {   XXH128_hash_t h128;
+            h128.low64  = acc.low64 + acc.high64;
+            h128.high64 = (acc.low64    * XXH_PRIME64_1)
+                        + (acc.high64   * XXH_PRIME64_4)
+                        + ((len - seed) * XXH_PRIME64_2);
+            h128.low64  = XXH3_avalanche(h128.low64);
+            h128.high64 = (XXH64_hash_t)0 - XXH3_avalanche(h128.high64);
+            return h128;
+        }
+    }
+}
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_hashLong_128b_internal(const xxh_u8* XXH_RESTRICT input, size_t len,
+                            const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
+                            XXH3_f_accumulate_512 f_acc512,
+                            XXH3_f_scrambleAcc f_scramble)
+{
+    XXH_ALIGN(XXH_ACC_ALIGN) xxh_u64 acc[XXH_ACC_NB] = XXH3_INIT_ACC;
+
+    XXH3_hashLong_internal_loop(acc, input, len, secret, secretSize, XXH3_acc_128bits, f_acc512, f_scramble);
+
+    /* converge into final hash */
+    XXH_STATIC_ASSERT(sizeof(acc) == 64);
+    XXH_ASSERT(secretSize >= sizeof(acc) + XXH_SECRET_MERGEACCS_START);
+    {   XXH128_hash_t h128;
+        h128.low64  = XXH3_mergeAccs(acc,
+                                     secret + XXH_SECRET_MERGEACCS_START,
+                                     (xxh_u64)len * XXH_PRIME64_1);
+        h128.high64 = XXH3_mergeAccs(acc,
+                                     secret + secretSize
+                                            - sizeof(acc) - XXH_SECRET_MERGEACCS_START,
+                                     ~((xxh_u64)len * XXH_PRIME64_2));
+        return h128;
+    }
+}
+
+/*
+ * It's important for performance that XXH3_hashLong is not inlined.
+ */
+XXH_NO_INLINE XXH128_hash_t
+XXH3_hashLong_128b_default(const xxh_u8* XXH_RESTRICT input, size_t len,
+                           XXH64_hash_t seed64,
+                           const xxh_u8* XXH_RESTRICT secret, size_t secretLen)
+{
+    (void)seed64; (void)secret; (void)secretLen;
+    return XXH3_hashLong_128b_internal(input, len, XXH3_kSecret, sizeof(XXH3_kSecret),
+                                       XXH3_accumulate_512, XXH3_scrambleAcc);
+}
+
+/*
+ * It's important for performance that XXH3_hashLong is not inlined.
+ */
+XXH_NO_INLINE XXH128_hash_t
+XXH3_hashLong_128b_withSecret(const xxh_u8* XXH_RESTRICT input, size_t len,
+                              XXH64_hash_t seed64,
+                              const xxh_u8* XXH_RESTRICT secret, size_t secretLen)
+{
+    (void)seed64;
+    return XXH3_hashLong_128b_internal(input, len, secret, secretLen,
+                                       XXH3_accumulate_512, XXH3_scrambleAcc);
+}
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_hashLong_128b_withSeed_internal(const xxh_u8* XXH_RESTRICT input, size_t len,
+                                XXH64_hash_t seed64,
+                                XXH3_f_accumulate_512 f_acc512,
+                                XXH3_f_scrambleAcc f_scramble,
+                                XXH3_f_initCustomSecret f_initSec)
+{
+    if (seed64 == 0)
+        return XXH3_hashLong_128b_internal(input, len,
+                                           XXH3_kSecret, sizeof(XXH3_kSecret),
+                                           f_acc512, f_scramble);
+    {   XXH_ALIGN(XXH_SEC_ALIGN) xxh_u8 secret[XXH_SECRET_DEFAULT_SIZE];
+        f_initSec(secret, seed64);
+        return XXH3_hashLong_128b_internal(input, len, secret, sizeof(secret),
+                                           f_acc512, f_scramble);
+    }
+}
+
+/*
+ * It's important for performance that XXH3_hashLong is not inlined.
+ */
+XXH_NO_INLINE XXH128_hash_t
+XXH3_hashLong_128b_withSeed(const xxh_u8* input, size_t len,
+                            XXH64_hash_t seed64, const xxh_u8* XXH_RESTRICT secret, size_t secretLen)
+{
+    (void)secret; (void)secretLen;
+    return XXH3_hashLong_128b_withSeed_internal(input, len, seed64,
+                XXH3_accumulate_512, XXH3_scrambleAcc, XXH3_initCustomSecret);
+}
+
+typedef XXH128_hash_t (*XXH3_hashLong128_f)(const xxh_u8* XXH_RESTRICT, size_t,
+                                            XXH64_hash_t, const xxh_u8* XXH_RESTRICT, size_t);
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_128bits_internal(const void* input, size_t len,
+                      XXH64_hash_t seed64, const xxh_u8* XXH_RESTRICT secret, size_t secretLen,
+                      XXH3_hashLong128_f f_hl128)
+{
+    XXH_ASSERT(secretLen >= XXH3_SECRET_SIZE_MIN);
+    /*
+     * If an action is to be taken if `secret` conditions are not respected,
+     * it should be done here.
+     * For now, it's a contract pre-condition.
+     * Adding a check and a branch here would cost performance at every hash.
+     */
+    if (len <= 16)
+        return XXH3_len_0to16_128b((const xxh_u8*)input, len, secret, seed64);
+    if (len <= 128)
+        return XXH3_len_17to128_128b((const xxh_u8*)input, len, secret, secretLen, seed64);
+    if (len <= XXH3_MIDSIZE_MAX)
+        return XXH3_len_129to240_128b((const xxh_u8*)input, len, secret, secretLen, seed64);
+    return f_hl128((const xxh_u8*)input, len, seed64, secret, secretLen);
+}
+
+
+/* ===   Public XXH128 API   === */
+
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits(const void* input, size_t len)
+{
+    return XXH3_128bits_internal(input, len, 0,
+                                 XXH3_kSecret, sizeof(XXH3_kSecret),
+                                 XXH3_hashLong_128b_default);
+}
+
+XXH_PUBLIC_API XXH128_hash_t
+XXH3_128bits_withSecret(const void* input, size_t len, const void* secret, size_t secretSize)
+{
+    return XXH3_128bits_internal(input, len, 0,
+                                 (const xxh_u8*)secret, secretSize,
+                                 XXH3_hashLong_128b_withSecret);
+}
+
+XXH_PUBLIC_API XXH128_hash_t
+XXH3_128bits_withSeed(const void* input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_128bits_internal(input, len, seed,
+                                 XXH3_kSecret, sizeof(XXH3_kSecret),
+                                 XXH3_hashLong_128b_withSeed);
+}
+
+XXH_PUBLIC_API XXH128_hash_t
+XXH128(const void* input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_128bits_withSeed(input, len, seed);
+}
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_128bits_withSecretandSeed_internal(const void* input, size_t len,
+                                        const void* secret, size_t secretSize, XXH64_hash_t seed,
+                                        XXH3_hashLong128_f f_hl128)
+{
+    if (len <= XXH3_MIDSIZE_MAX)
+        return XXH3_128bits_internal(input, len, seed, XXH3_kSecret, sizeof(XXH3_kSecret), f_hl128);
+    XXH_ASSERT(secretSize >= XXH3_SECRET_SIZE_MIN);
+    return f_hl128((const xxh_u8*)input, len, seed, (const xxh_u8*)secret, secretSize);
+}
+
+XXH_PUBLIC_API XXH128_hash_t
+XXH3_128bits_withSecretandSeed(const void* input, size_t len, const void* secret, size_t secretSize, XXH64_hash_t seed)
+{
+    return XXH3_128bits_withSecretandSeed_internal(input, len, secret, secretSize, seed, XXH3_hashLong_128b_withSecret);
+}
+
+XXH_PUBLIC_API XXH128_hash_t
+XXH3_128bits_withSeededContext(const void* input, size_t len, const XXH3_seededContext_t* ctx)
+{
+    XXH_ASSERT(ctx != NULL);
+    return XXH3_128bits_withSecretandSeed(input, len, ctx->secret, sizeof(ctx->secret), ctx->seed);
+}
+
+
+/* ===   XXH3 128-bit streaming   === */
+
+/*
+ * All the functions are actually the same as for 64-bit streaming variant.
+ * The only difference is the finalizatiom routine.
+ */
+
+static void
+XXH3_128bits_reset_internal(XXH3_state_t* statePtr,
+                            XXH64_hash_t seed,
+                            const xxh_u8* secret, size_t secretSize)
+{
+    XXH3_64bits_reset_internal(statePtr, seed, secret, secretSize);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_reset(XXH3_state_t* statePtr)
+{
+    if (statePtr == NULL) return XXH_ERROR;
+    XXH3_128bits_reset_internal(statePtr, 0, XXH3_kSecret, XXH_SECRET_DEFAULT_SIZE);
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_reset_withSecret(XXH3_state_t* statePtr, const void* secret, size_t secretSize)
+{
+    if (statePtr == NULL) return XXH_ERROR;
+    XXH3_128bits_reset_internal(statePtr, 0, (const xxh_u8*)secret, secretSize);
+    if (secret == NULL) return XXH_ERROR;
+    if (secretSize < XXH3_SECRET_SIZE_MIN) return XXH_ERROR;
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_reset_withSeed(XXH3_state_t* statePtr, XXH64_hash_t seed)
+{
+    if (statePtr == NULL) return XXH_ERROR;
+    XXH3_128bits_reset_internal(statePtr, seed, XXH3_kSecret, XXH_SECRET_DEFAULT_SIZE);
+    XXH3_initCustomSecret(statePtr->customSecret, seed);
+    statePtr->extSecret = NULL;
+    statePtr->useSeed = 1;
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_reset_withSecretandSeed(XXH3_state_t* statePtr, const void* secret, size_t secretSize, XXH64_hash_t seed)
+{
+    if (statePtr == NULL) return XXH_ERROR;
+    if (secret == NULL) return XXH_ERROR;
+    if (secretSize < XXH3_SECRET_SIZE_MIN) return XXH_ERROR;
+    XXH3_128bits_reset_internal(statePtr, seed, (const xxh_u8*)secret, secretSize);
+    statePtr->useSeed = 1;
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_reset_withSeededContext(XXH3_state_t* statePtr, const XXH3_seededContext_t* ctx)
+{
+    if (ctx == NULL) return XXH_ERROR;
+    return XXH3_128bits_reset_withSecretandSeed(statePtr, ctx->secret, sizeof(ctx->secret), ctx->seed);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_update(XXH3_state_t* state, const void* input, size_t len)
+{
+    return XXH3_update(state, (const xxh_u8*)input, len,
+                       XXH3_acc_128bits, XXH3_accumulate_512, XXH3_scrambleAcc);
+}
+
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_digest (const XXH3_state_t* state)
+{
+    const unsigned char* const secret = (state->extSecret == NULL) ? state->customSecret : state->extSecret;
+    if (state->totalLen > XXH3_MIDSIZE_MAX) {
+        XXH_ALIGN(XXH_ACC_ALIGN) XXH64_hash_t acc[XXH_ACC_NB];
+        XXH3_digest_long(acc, state->acc, state, secret, XXH3_acc_128bits);
+        XXH_ASSERT(state->secretLimit + XXH_STRIPE_LEN >= sizeof(acc) + XXH_SECRET_MERGEACCS_START);
+        {   XXH128_hash_t h128;
+            h128.low64  = XXH3_mergeAccs(acc,
+                                         secret + XXH_SECRET_MERGEACCS_START,
+                                         (xxh_u64)state->totalLen * XXH_PRIME64_1);
+            h128.high64 = XXH3_mergeAccs(acc,
+                                         secret + state->secretLimit + XXH_STRIPE_LEN
+                                                - sizeof(acc) - XXH_SECRET_MERGEACCS_START,
+                                         ~((xxh_u64)state->totalLen * XXH_PRIME64_2));
+            return h128;
+        }
+    }
+    /* len <= XXH3_MIDSIZE_MAX : short code */
+    if (state->useSeed)
+        return XXH3_128bits_withSeed(state->buffer, (size_t)state->totalLen, state->seed);
+    return XXH3_128bits_withSecret(state->buffer, (size_t)(state->totalLen),
+                                   secret, state->secretLimit + XXH_STRIPE_LEN);
+}
+
+/* 128-bit utility functions */
+
+#include <string.h>   /* memcmp, memcpy */
+
+/* return : 1 is equal, 0 if different */
+XXH_PUBLIC_API int XXH128_isEqual(XXH128_hash_t h1, XXH128_hash_t h2)
+{
+    /* note : XXH128_hash_t is compact, it has no padding byte */
+    return !(memcmp(&h1, &h2, sizeof(h1)));
+}
+
+/* This prototype is compatible with stdlib's qsort().
+ * return : >0 if *h128_1  > *h128_2
+ *          <0 if *h128_1  < *h128_2
+ *          =0 if *h128_1 == *h128_2  */
+XXH_PUBLIC_API int XXH128_cmp(const void* h128_1, const void* h128_2)
+{
+    XXH128_hash_t const h1 = *(const XXH128_hash_t*)h128_1;
+    XXH128_hash_t const h2 = *(const XXH128_hash_t*)h128_2;
+    int const hcmp = (h1.high64 > h2.high64) - (h2.high64 > h1.high64);
+    /* note : bets that, in most cases, hash values are different */
+    if (hcmp) return hcmp;
+    return (h1.low64 > h2.low64) - (h2.low64 > h1.low64);
+}
+
+
+/*======   Canonical representation   ======*/
+XXH_PUBLIC_API void
+XXH128_canonicalFromHash(XXH128_canonical_t* dst, XXH128_hash_t hash)
+{
+    XXH_STATIC_ASSERT(sizeof(XXH128_canonical_t) == sizeof(XXH128_hash_t));
+    if (XXH_CPU_LITTLE_ENDIAN) {
+        hash.high64 = XXH_swap64(hash.high64);
+        hash.low64  = XXH_swap64(hash.low64);
+    }
+    memcpy(dst, &hash.high64, sizeof(hash.high64));
+    memcpy((char*)dst + sizeof(hash.high64), &hash.low64, sizeof(hash.low64));
+}
+
+XXH_PUBLIC_API XXH128_hash_t
+XXH128_hashFromCanonical(const XXH128_canonical_t* src)
+{
+    XXH128_hash_t h;
+    h.high64 = XXH_readBE64(src);
+    h.low64  = XXH_readBE64(src->digest + 8);
+    return h;
+}
+
+
+/* ===   XXH3-T tree hashing   === */
+
+/*
+ * XXH_TREE_THREADS:
+ * When set to 1, `XXH3_128bits_tree()` and its streaming variant can start
+ * their own threads, using pthreads, as requested by `XXH3_treePool_t.nbThreads`.
+ * Otherwise, leaves are only hashed in parallel on a caller-provided pool.
+ * Default is 0, which doesn't require linking with -pthread.
+ */
+#ifndef XXH_TREE_THREADS
+#  define XXH_TREE_THREADS 0
+#endif
+
+#if XXH_TREE_THREADS
+#  include <pthread.h>
+#endif
+
+/* leaves hashed by one call to the pool */
+#define XXH3_TREE_BATCH_LEAVES 4096
+#define XXH3_TREE_THREADS_MAX 64
+
+typedef XXH128_hash_t (*XXH3_f_hashLeaf)(const void* input, size_t len, XXH64_hash_t seed);
+typedef XXH_errorcode (*XXH3_f_update)(XXH3_state_t* state, const void* input, size_t len);
+
+typedef struct {
+    const xxh_u8* input;
+    XXH64_hash_t seed;
+    XXH3_f_hashLeaf f_hashLeaf;
+    XXH128_canonical_t* digests;
+} XXH3_treeLeaves_t;
+
+static void XXH3_tree_hashLeafJob(void* jobCtx, size_t leafNb)
+{
+    const XXH3_treeLeaves_t* const leaves = (const XXH3_treeLeaves_t*)jobCtx;
+    XXH128_hash_t const h128 = leaves->f_hashLeaf(leaves->input + leafNb * XXH3_TREE_LEAF_SIZE,
+                                                  XXH3_TREE_LEAF_SIZE, leaves->seed);
+    XXH128_canonicalFromHash(leaves->digests + leafNb, h128);
+}
+
+#if XXH_TREE_THREADS
+
+typedef struct {
+    XXH3_treeJob_f job;
+    void* jobCtx;
+    size_t nbJobs;
+    size_t first;
+    size_t step;
+} XXH3_treeWorker_t;
+
+static void* XXH3_tree_worker(void* arg)
+{
+    const XXH3_treeWorker_t* const worker = (const XXH3_treeWorker_t*)arg;
+    size_t n;
+    for (n = worker->first; n < worker->nbJobs; n += worker->step)
+        worker->job(worker->jobCtx, n);
+    return NULL;
+}
+
+/*
+ * Built-in pool: threads are started for each batch, which is large enough
+ * to make their creation cost negligible.
+ * Jobs are interleaved, all leaves of a batch have the same size.
+ */
+static void
+XXH3_tree_parallelFor_threads(unsigned nbThreads, XXH3_treeJob_f job, void* jobCtx, size_t nbJobs)
+{
+    pthread_t threads[XXH3_TREE_THREADS_MAX];
+    XXH3_treeWorker_t workers[XXH3_TREE_THREADS_MAX];
+    int started[XXH3_TREE_THREADS_MAX];
+    size_t t;
+    if (nbThreads > XXH3_TREE_THREADS_MAX) nbThreads = XXH3_TREE_THREADS_MAX;
+    if (nbThreads > nbJobs) nbThreads = (unsigned)nbJobs;
+    for (t = 0; t < nbThreads; t++) {
+        workers[t].job = job;
+        workers[t].jobCtx = jobCtx;
+        workers[t].nbJobs = nbJobs;
+        workers[t].first = t;
+        workers[t].step = nbThreads;
+        /* worker 0 is the calling thread */
+        started[t] = (t > 0) && !pthread_create(&threads[t], NULL, XXH3_tree_worker, &workers[t]);
+    }
+    for (t = 0; t < nbThreads; t++) {
+        if (started[t]) pthread_join(threads[t], NULL);
+        else XXH3_tree_worker(&workers[t]);
+    }
+}
+
+#endif  /* XXH_TREE_THREADS */
+
+static int XXH3_tree_isParallel(const XXH3_treePool_t* pool)
+{
+    if (pool->parallelFor != NULL) return 1;
+    return XXH_TREE_THREADS && (pool->nbThreads > 1);
+}
+
+static void
+XXH3_tree_parallelFor(const XXH3_treePool_t* pool, XXH3_treeJob_f job, void* jobCtx, size_t nbJobs)
+{
+    if (pool->parallelFor != NULL) {
+        pool->parallelFor(pool->poolCtx, job, jobCtx, nbJobs);
+        return;
+    }
+#if XXH_TREE_THREADS
+    XXH3_tree_parallelFor_threads(pool->nbThreads, job, jobCtx, nbJobs);
+#else
+    {   size_t n;
+        for (n = 0; n < nbJobs; n++) job(jobCtx, n);
+    }
+#endif
+}
+
+/* hashes `nbLeaves` complete leaves, and absorbs their digests into the root */
+XXH_FORCE_INLINE void
+XXH3_tree_hashLeaves(XXH3_treeState_t* state,
+                     const xxh_u8* input, size_t nbLeaves,
+                     XXH3_f_hashLeaf f_hashLeaf)
+{
+    XXH3_treeLeaves_t leaves;
+    leaves.input = input;
+    leaves.seed = state->seed;
+    leaves.f_hashLeaf = f_hashLeaf;
+    leaves.digests = NULL;
+    if (nbLeaves > 1 && XXH3_tree_isParallel(&state->pool)) {
+        size_t const batchMax = (nbLeaves < XXH3_TREE_BATCH_LEAVES) ? nbLeaves : XXH3_TREE_BATCH_LEAVES;
+        leaves.digests = (XXH128_canonical_t*)XXH_malloc(batchMax * sizeof(XXH128_canonical_t));
+    }
+
+    if (leaves.digests == NULL) {
+        /* sequential: no digest array needed */
+        XXH128_canonical_t digest;
+        leaves.digests = &digest;
+        for ( ; nbLeaves > 0; nbLeaves--) {
+            XXH3_tree_hashLeafJob(&leaves, 0);
+            XXH3_128bits_update(&state->root, &digest, sizeof(digest));
+            leaves.input += XXH3_TREE_LEAF_SIZE;
+        }
+        return;
+    }
+
+    while (nbLeaves > 0) {
+        size_t const batchSize = (nbLeaves < XXH3_TREE_BATCH_LEAVES) ? nbLeaves : XXH3_TREE_BATCH_LEAVES;
+        XXH3_tree_parallelFor(&state->pool, XXH3_tree_hashLeafJob, &leaves, batchSize);
+        XXH3_128bits_update(&state->root, leaves.digests, batchSize * sizeof(XXH128_canonical_t));
+        leaves.input += batchSize * XXH3_TREE_LEAF_SIZE;
+        nbLeaves -= batchSize;
+    }
+    XXH_free(leaves.digests);
+}
+
+XXH_PUBLIC_API XXH3_treeState_t* XXH3_createTreeState(void)
+{
+    return (XXH3_treeState_t*)XXH_alignedMalloc(sizeof(XXH3_treeState_t), 64);
+}
+
+XXH_PUBLIC_API XXH_errorcode XXH3_freeTreeState(XXH3_treeState_t* statePtr)
+{
+    XXH_alignedFree(statePtr);
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_tree_reset(XXH3_treeState_t* statePtr, XXH64_hash_t seed, const XXH3_treePool_t* pool)
+{
+    if (statePtr == NULL) return XXH_ERROR;
+    (void)XXH3_128bits_reset_withSeed(&statePtr->leaf, seed);
+    (void)XXH3_128bits_reset_withSeed(&statePtr->root, seed);
+    if (pool != NULL) {
+        statePtr->pool = *pool;
+    } else {
+        memset(&statePtr->pool, 0, sizeof(statePtr->pool));
+    }
+    statePtr->totalLen = 0;
+    statePtr->seed = seed;
+    return XXH_OK;
+}
+
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_128bits_tree_update_internal(XXH3_treeState_t* state,
+                                  const xxh_u8* input, size_t len,
+                                  XXH3_f_hashLeaf f_hashLeaf,
+                                  XXH3_f_update f_updateLeaf)
+{
+    if (input==NULL)
+#if defined(XXH_ACCEPT_NULL_INPUT_POINTER) && (XXH_ACCEPT_NULL_INPUT_POINTER>=1)
+        return XXH_OK;
+#else
+        return XXH_ERROR;
+#endif
+
+    {   size_t const leafFill = (size_t)(state->totalLen % XXH3_TREE_LEAF_SIZE);
+        state->totalLen += len;
+
+        /* complete the current leaf */
+        if (leafFill > 0) {
+            size_t const loadSize = XXH3_TREE_LEAF_SIZE - leafFill;
+            if (len < loadSize) return f_updateLeaf(&state->leaf, input, len);
+            (void)f_updateLeaf(&state->leaf, input, loadSize);
+            {   XXH128_canonical_t digest;
+                XXH128_canonicalFromHash(&digest, XXH3_128bits_digest(&state->leaf));
+                XXH3_128bits_update(&state->root, &digest, sizeof(digest));
+            }
+            (void)XXH3_128bits_reset_withSeed(&state->leaf, state->seed);
+            input += loadSize;
+            len -= loadSize;
+        }
+
+        /* complete leaves are hashed straight from the input */
+        {   size_t const nbLeaves = len / XXH3_TREE_LEAF_SIZE;
+            XXH3_tree_hashLeaves(state, input, nbLeaves, f_hashLeaf);
+            input += nbLeaves * XXH3_TREE_LEAF_SIZE;
+            len -= nbLeaves * XXH3_TREE_LEAF_SIZE;
+        }
+
+        /* start the next leaf */
+        if (len > 0) return f_updateLeaf(&state->leaf, input, len);
+    }
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_tree_update(XXH3_treeState_t* state, const void* input, size_t len)
+{
+    return XXH3_128bits_tree_update_internal(state, (const xxh_u8*)input, len,
+                                             XXH3_128bits_withSeed, XXH3_128bits_update);
+}
+
+XXH_PUBLIC_API XXH128_hash_t
+XXH3_128bits_tree_digest(const XXH3_treeState_t* state)
+{
+    XXH3_state_t root;
+    xxh_u8 footer[16];
+    XXH3_copyState(&root, &state->root);
+    /* last leaf, if incomplete */
+    if (state->totalLen % XXH3_TREE_LEAF_SIZE) {
+        XXH128_canonical_t digest;
+        XXH128_canonicalFromHash(&digest, XXH3_128bits_digest(&state->leaf));
+        XXH3_128bits_update(&root, &digest, sizeof(digest));
+    }
+    XXH_writeLE64(footer, state->totalLen);
+    XXH_writeLE64(footer + 8, XXH3_TREE_LEAF_SIZE);
+    XXH3_128bits_update(&root, footer, sizeof(footer));
+    return XXH3_128bits_digest(&root);
+}
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_128bits_tree_internal(const void* input, size_t len,
+                           XXH64_hash_t seed, const XXH3_treePool_t* pool,
+                           XXH3_f_hashLeaf f_hashLeaf,
+                           XXH3_f_update f_updateLeaf)
+{
+    XXH3_treeState_t state;
+    (void)XXH3_128bits_tree_reset(&state, seed, pool);
+    (void)XXH3_128bits_tree_update_internal(&state, (const xxh_u8*)input, len, f_hashLeaf, f_updateLeaf);
+    return XXH3_128bits_tree_digest(&state);
+}
+
+XXH_PUBLIC_API XXH128_hash_t
+XXH3_128bits_tree(const void* input, size_t len, XXH64_hash_t seed, const XXH3_treePool_t* pool)
+{
+    return XXH3_128bits_tree_internal(input, len, seed, pool,
+                                      XXH3_128bits_withSeed, XXH3_128bits_update);
+}
+
+
+
+/* ===   XXH3 Merkle tree   === */
+
+/* in-order position of the node at `level` (0 for leaves) covering leaves [n << level, (n+1) << level) */
+XXH_FORCE_INLINE size_t XXH3_merkle_nodePos(unsigned level, size_t n)
+{
+    return (n << (level + 1)) + ((size_t)1 << level) - 1;
+}
+
+XXH_FORCE_INLINE void
+XXH3_merkle_hashPair(XXH128_canonical_t* dst,
+                     const XXH128_canonical_t* left, const XXH128_canonical_t* right,
+                     XXH64_hash_t seed)
+{
+    XXH128_canonical_t pair[2];
+    pair[0] = *left;
+    pair[1] = *right;
+    XXH128_canonicalFromHash(dst, XXH3_128bits_withSeed(pair, sizeof(pair), seed ^ XXH_PRIME64_1));
+}
+
+/*
+ * Re-hashes the complete ancestors of leaves [first, last).
+ * Each level only visits the parents of the previous level's range.
+ */
+static void
+XXH3_merkle_updateAncestors(XXH3_merkle_t* tree, size_t first, size_t last)
+{
+    unsigned level;
+    for (level = 1; (tree->nbLeaves >> level) > 0; level++) {
+        size_t const nbComplete = tree->nbLeaves >> level;
+        size_t n;
+        first >>= 1;
+        last = (last + 1) >> 1;
+        if (last > nbComplete) last = nbComplete;
+        if (first >= last) break;
+        for (n = first; n < last; n++) {
+            XXH3_merkle_hashPair(tree->nodes + XXH3_merkle_nodePos(level, n),
+                                 tree->nodes + XXH3_merkle_nodePos(level - 1, 2*n),
+                                 tree->nodes + XXH3_merkle_nodePos(level - 1, 2*n + 1),
+                                 tree->seed);
+    }   }
+}
+
+/* hashes `data` into the leaves starting at `firstLeaf`, which must exist */
+XXH_FORCE_INLINE void
+XXH3_merkle_hashLeaves(XXH3_merkle_t* tree, size_t firstLeaf,
+                       const xxh_u8* data, size_t len,
+                       XXH3_f_hashLeaf f_hashLeaf)
+{
+    size_t n = firstLeaf;
+    do {
+        size_t const leafLen = (len < tree->leafSize) ? len : tree->leafSize;
+        XXH128_canonicalFromHash(tree->nodes + XXH3_merkle_nodePos(0, n),
+                                 f_hashLeaf(data, leafLen, tree->seed));
+        data += leafLen;
+        len -= leafLen;
+        n++;
+    } while (len > 0);
+    XXH3_merkle_updateAncestors(tree, firstLeaf, n);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_merkle_init(XXH3_merkle_t* tree, XXH128_canonical_t* nodes, size_t capacity,
+                 size_t nbLeaves, size_t leafSize, XXH64_hash_t seed)
+{
+    if (tree == NULL) return XXH_ERROR;
+    if (capacity < XXH3_MERKLE_NB_NODES(nbLeaves)) return XXH_ERROR;
+    if (nodes == NULL && capacity > 0) return XXH_ERROR;
+    tree->nodes = nodes;
+    tree->capacity = capacity;
+    tree->nbLeaves = nbLeaves;
+    tree->leafSize = leafSize;
+    tree->seed = seed;
+    return XXH_OK;
+}
+
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_merkle_build_internal(XXH3_merkle_t* tree, const void* data, size_t len,
+                           XXH3_f_hashLeaf f_hashLeaf)
+{
+    if (tree->leafSize == 0) return XXH_ERROR;
+    if (data == NULL && len > 0) return XXH_ERROR;
+    {   size_t const nbLeaves = len / tree->leafSize + (len % tree->leafSize != 0);
+        if (tree->capacity < XXH3_MERKLE_NB_NODES(nbLeaves)) return XXH_ERROR;
+        tree->nbLeaves = nbLeaves;
+    }
+    if (len == 0) return XXH_OK;
+    XXH3_merkle_hashLeaves(tree, 0, (const xxh_u8*)data, len, f_hashLeaf);
+    return XXH_OK;
+}
+
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_merkle_append_internal(XXH3_merkle_t* tree, const void* leaf, size_t leafLen,
+                            XXH3_f_hashLeaf f_hashLeaf)
+{
+    size_t const n = tree->nbLeaves;
+    if (tree->capacity < XXH3_MERKLE_NB_NODES(n + 1)) return XXH_ERROR;
+    if (leaf == NULL && leafLen > 0) return XXH_ERROR;
+    tree->nbLeaves = n + 1;
+    XXH128_canonicalFromHash(tree->nodes + XXH3_merkle_nodePos(0, n),
+                             f_hashLeaf(leaf, leafLen, tree->seed));
+    XXH3_merkle_updateAncestors(tree, n, n + 1);
+    return XXH_OK;
+}
+
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_merkle_updateLeaf_internal(XXH3_merkle_t* tree, size_t leafNb,
+                                const void* leaf, size_t leafLen,
+                                XXH3_f_hashLeaf f_hashLeaf)
+{
+    if (leafNb >= tree->nbLeaves) return XXH_ERROR;
+    if (leaf == NULL && leafLen > 0) return XXH_ERROR;
+    XXH128_canonicalFromHash(tree->nodes + XXH3_merkle_nodePos(0, leafNb),
+                             f_hashLeaf(leaf, leafLen, tree->seed));
+    XXH3_merkle_updateAncestors(tree, leafNb, leafNb + 1);
+    return XXH_OK;
+}
+
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_merkle_updateLeaves_internal(XXH3_merkle_t* tree, size_t firstLeaf,
+                                  const void* data, size_t len,
+                                  XXH3_f_hashLeaf f_hashLeaf)
+{
+    if (tree->leafSize == 0) return XXH_ERROR;
+    if (len == 0) return XXH_OK;
+    if (data == NULL) return XXH_ERROR;
+    if (firstLeaf >= tree->nbLeaves) return XXH_ERROR;
+    if ((len - 1) / tree->leafSize >= tree->nbLeaves - firstLeaf) return XXH_ERROR;
+    XXH3_merkle_hashLeaves(tree, firstLeaf, (const xxh_u8*)data, len, f_hashLeaf);
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_merkle_build(XXH3_merkle_t* tree, const void* data, size_t len)
+{
+    return XXH3_merkle_build_internal(tree, data, len, XXH3_128bits_withSeed);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_merkle_append(XXH3_merkle_t* tree, const void* leaf, size_t leafLen)
+{
+    return XXH3_merkle_append_internal(tree, leaf, leafLen, XXH3_128bits_withSeed);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_merkle_updateLeaf(XXH3_merkle_t* tree, size_t leafNb, const void* leaf, size_t leafLen)
+{
+    return XXH3_merkle_updateLeaf_internal(tree, leafNb, leaf, leafLen, XXH3_128bits_withSeed);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_merkle_updateLeaves(XXH3_merkle_t* tree, size_t firstLeaf, const void* data, size_t len)
+{
+    return XXH3_merkle_updateLeaves_internal(tree, firstLeaf, data, len, XXH3_128bits_withSeed);
+}
+
+/*
+ * The root combines the complete subtrees ("peaks") of the tree,
+ * one per bit set in nbLeaves, from the right: H(peak0, H(peak1, peak2)).
+ */
+XXH_PUBLIC_API XXH128_hash_t XXH3_merkle_root(const XXH3_merkle_t* tree)
+{
+    XXH128_canonical_t root;
+    size_t const nbLeaves = tree->nbLeaves;
+    size_t end = nbLeaves;   /* peaks are visited from the right */
+    unsigned level;
+    int first = 1;
+    if (nbLeaves == 0) return XXH3_128bits_withSeed(NULL, 0, tree->seed);
+    for (level = 0; (nbLeaves >> level) > 0; level++) {
+        if ((nbLeaves >> level) & 1) {
+            const XXH128_canonical_t* const peak = tree->nodes + XXH3_merkle_nodePos(level, (end >> level) - 1);
+            if (first) {
+                root = *peak;
+                first = 0;
+            } else {
+                XXH3_merkle_hashPair(&root, peak, &root, tree->seed);
+            }
+            end -= (size_t)1 << level;
+    }   }
+    return XXH128_hashFromCanonical(&root);
+}
+
+
+
+/* ===   XXH3 copy and hash   === */
+
+/* input hashed then copied at once, small enough to remain in L1 cache */
+#define XXH3_COPY_CHUNK_SIZE (8 << 10)
+
+#if (XXH_VECTOR == XXH_SSE2) || (XXH_VECTOR == XXH_AVX2) || (XXH_VECTOR == XXH_AVX512)
+#  define XXH3_COPY_NONTEMPORAL 1
+#else
+#  define XXH3_COPY_NONTEMPORAL 0
+#endif
+
+XXH_FORCE_INLINE void
+XXH3_copy(void* XXH_RESTRICT dst, const void* XXH_RESTRICT src, size_t len, XXH3_copyMode_e mode)
+{
+    if (len == 0) return;
+#if XXH3_COPY_NONTEMPORAL
+    if (mode == XXH3_copy_nonTemporal && len >= 64) {
+        xxh_u8* d = (xxh_u8*)dst;
+        const xxh_u8* s = (const xxh_u8*)src;
+        /* streaming stores require an aligned destination */
+        size_t const head = (size_t)(-(size_t)d) & 15;
+        memcpy(d, s, head);
+        d += head; s += head; len -= head;
+        for ( ; len >= 64; len -= 64, d += 64, s += 64) {
+            __m128i* const xd = (__m128i*)(void*)d;
+            const __m128i* const xs = (const __m128i*)(const void*)s;
+            _mm_stream_si128(xd + 0, _mm_loadu_si128(xs + 0));
+            _mm_stream_si128(xd + 1, _mm_loadu_si128(xs + 1));
+            _mm_stream_si128(xd + 2, _mm_loadu_si128(xs + 2));
+            _mm_stream_si128(xd + 3, _mm_loadu_si128(xs + 3));
+        }
+        memcpy(d, s, len);
+        return;
+    }
+#endif
+    (void)mode;
+    memcpy(dst, src, len);
+}
+
+/* makes non-temporal stores visible to other threads, before returning */
+XXH_FORCE_INLINE void XXH3_copyFence(XXH3_copyMode_e mode)
+{
+#if XXH3_COPY_NONTEMPORAL
+    if (mode == XXH3_copy_nonTemporal) _mm_sfence();
+#endif
+    (void)mode;
+}
+
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_update_copy(XXH3_state_t* state, void* dst, const xxh_u8* src, size_t len,
+                 XXH3_copyMode_e mode, XXH3_f_update f_update)
+{
+    xxh_u8* d = (xxh_u8*)dst;
+    if (src==NULL)
+#if defined(XXH_ACCEPT_NULL_INPUT_POINTER) && (XXH_ACCEPT_NULL_INPUT_POINTER>=1)
+        return XXH_OK;
+#else
+        return XXH_ERROR;
+#endif
+
+    while (len > 0) {
+        size_t const chunkSize = (len < XXH3_COPY_CHUNK_SIZE) ? len : XXH3_COPY_CHUNK_SIZE;
+        (void)f_update(state, src, chunkSize);
+        XXH3_copy(d, src, chunkSize, mode);
+        src += chunkSize;
+        d += chunkSize;
+        len -= chunkSize;
+    }
+    XXH3_copyFence(mode);
+    return XXH_OK;
+}
+
+/*
+ * Same as XXH3_hashLong_internal_loop(), also copying the input to `dst`.
+ * The input is hashed in chunks of whole blocks, which restart the secret
+ * exactly as the next block would, and each chunk is copied right after,
+ * while it is still in L1 cache.
+ */
+XXH_FORCE_INLINE void
+XXH3_hashLong_copy_loop(xxh_u64* XXH_RESTRICT acc, xxh_u8* XXH_RESTRICT dst,
+                  const xxh_u8* XXH_RESTRICT input, size_t len,
+                  const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
+                        XXH3_accWidth_e accWidth, XXH3_copyMode_e mode,
+                        XXH3_f_accumulate_512 f_acc512,
+                        XXH3_f_scrambleAcc f_scramble)
+{
+    size_t const block_len = XXH_STRIPE_LEN * ((secretSize - XXH_STRIPE_LEN) / XXH_SECRET_CONSUME_RATE);
+    size_t const chunkSize = (XXH3_COPY_CHUNK_SIZE < block_len) ? block_len
+                           : XXH3_COPY_CHUNK_SIZE - (XXH3_COPY_CHUNK_SIZE % block_len);
+    /* the last chunk, up to 2 chunks long, ends like the whole input */
+    while (len > 2 * chunkSize) {
+        XXH3_hashLong_internal_loop(acc, input, chunkSize, secret, secretSize, accWidth, f_acc512, f_scramble);
+        XXH3_copy(dst, input, chunkSize, mode);
+        input += chunkSize;
+        dst += chunkSize;
+        len -= chunkSize;
+    }
+    XXH3_hashLong_internal_loop(acc, input, len, secret, secretSize, accWidth, f_acc512, f_scramble);
+    XXH3_copy(dst, input, len, mode);
+}
+
+XXH_FORCE_INLINE XXH64_hash_t
+XXH3_hashLong_64b_copy_internal(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len,
+                                XXH3_copyMode_e mode,
+                                XXH3_f_accumulate_512 f_acc512,
+                                XXH3_f_scrambleAcc f_scramble)
+{
+    XXH_ALIGN(XXH_ACC_ALIGN) xxh_u64 acc[XXH_ACC_NB] = XXH3_INIT_ACC;
+    XXH3_hashLong_copy_loop(acc, (xxh_u8*)dst, (const xxh_u8*)input, len,
+                            XXH3_kSecret, sizeof(XXH3_kSecret), XXH3_acc_64bits, mode, f_acc512, f_scramble);
+    return XXH3_mergeAccs(acc, XXH3_kSecret + XXH_SECRET_MERGEACCS_START, (xxh_u64)len * XXH_PRIME64_1);
+}
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_hashLong_128b_copy_internal(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len,
+                                 XXH3_copyMode_e mode,
+                                 XXH3_f_accumulate_512 f_acc512,
+                                 XXH3_f_scrambleAcc f_scramble)
+{
+    XXH_ALIGN(XXH_ACC_ALIGN) xxh_u64 acc[XXH_ACC_NB] = XXH3_INIT_ACC;
+    XXH3_hashLong_copy_loop(acc, (xxh_u8*)dst, (const xxh_u8*)input, len,
+                            XXH3_kSecret, sizeof(XXH3_kSecret), XXH3_acc_128bits, mode, f_acc512, f_scramble);
+    {   XXH128_hash_t h128;
+        h128.low64  = XXH3_mergeAccs(acc,
+                                     XXH3_kSecret + XXH_SECRET_MERGEACCS_START,
+                                     (xxh_u64)len * XXH_PRIME64_1);
+        h128.high64 = XXH3_mergeAccs(acc,
+                                     XXH3_kSecret + sizeof(XXH3_kSecret)
+                                                  - sizeof(acc) - XXH_SECRET_MERGEACCS_START,
+                                     ~((xxh_u64)len * XXH_PRIME64_2));
+        return h128;
+    }
+}
+
+/*
+ * It's important for performance that XXH3_hashLong is not inlined.
+ */
+XXH_NO_INLINE XXH64_hash_t
+XXH3_hashLong_64b_copy(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_hashLong_64b_copy_internal(dst, input, len, mode, XXH3_accumulate_512, XXH3_scrambleAcc);
+}
+
+XXH_NO_INLINE XXH128_hash_t
+XXH3_hashLong_128b_copy(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_hashLong_128b_copy_internal(dst, input, len, mode, XXH3_accumulate_512, XXH3_scrambleAcc);
+}
+
+typedef XXH64_hash_t (*XXH3_hashLong64_copy_f)(void* XXH_RESTRICT, const void* XXH_RESTRICT, size_t, XXH3_copyMode_e);
+typedef XXH128_hash_t (*XXH3_hashLong128_copy_f)(void* XXH_RESTRICT, const void* XXH_RESTRICT, size_t, XXH3_copyMode_e);
+
+XXH_FORCE_INLINE XXH64_hash_t
+XXH3_64bits_copy_internal(void* dst, const void* src, size_t len, XXH3_copyMode_e mode,
+                          XXH3_hashLong64_copy_f f_hashLong)
+{
+    XXH64_hash_t h64;
+    if (len <= XXH3_MIDSIZE_MAX) {
+        h64 = XXH3_64bits(src, len);
+        XXH3_copy(dst, src, len, mode);
+    } else {
+        h64 = f_hashLong(dst, src, len, mode);
+    }
+    XXH3_copyFence(mode);
+    return h64;
+}
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_128bits_copy_internal(void* dst, const void* src, size_t len, XXH3_copyMode_e mode,
+                           XXH3_hashLong128_copy_f f_hashLong)
+{
+    XXH128_hash_t h128;
+    if (len <= XXH3_MIDSIZE_MAX) {
+        h128 = XXH3_128bits(src, len);
+        XXH3_copy(dst, src, len, mode);
+    } else {
+        h128 = f_hashLong(dst, src, len, mode);
+    }
+    XXH3_copyFence(mode);
+    return h128;
+}
+
+XXH_PUBLIC_API XXH64_hash_t
+XXH3_64bits_copy(void* dst, const void* src, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_64bits_copy_internal(dst, src, len, mode, XXH3_hashLong_64b_copy);
+}
+
+XXH_PUBLIC_API XXH128_hash_t
+XXH3_128bits_copy(void* dst, const void* src, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_128bits_copy_internal(dst, src, len, mode, XXH3_hashLong_128b_copy);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_update_copy(XXH3_state_t* state, void* dst, const void* src, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_update_copy(state, dst, (const xxh_u8*)src, len, mode, XXH3_64bits_update);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_update_copy(XXH3_state_t* state, void* dst, const void* src, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_update_copy(state, dst, (const xxh_u8*)src, len, mode, XXH3_128bits_update);
+}
+
+
+/* ===   XXH3 scatter-gather hashing   === */
+
+XXH_FORCE_INLINE size_t XXH3_iovec_totalLen(const XXH3_iovec_t* iov, size_t iovcnt)
+{
+    size_t len = 0;
+    size_t n;
+    for (n = 0; n < iovcnt; n++) len += iov[n].len;
+    return len;
+}
+
+/*
+ * Returns a pointer to the last `XXH_STRIPE_LEN` bytes of the concatenation,
+ * gathered into `buffer` only when they span several fragments.
+ */
+static const xxh_u8*
+XXH3_iovec_lastStripe(xxh_u8* buffer, const XXH3_iovec_t* iov, size_t iovcnt)
+{
+    size_t missing = XXH_STRIPE_LEN;
+    while (iovcnt > 0) {
+        const xxh_u8* const p = (const xxh_u8*)iov[iovcnt-1].ptr;
+        size_t const n = iov[iovcnt-1].len;
+        iovcnt--;
+        if (n == 0) continue;
+        if (n >= missing) {
+            if (missing == XXH_STRIPE_LEN) return p + n - XXH_STRIPE_LEN;
+            XXH_memcpy(buffer, p + n - missing, missing);
+            return buffer;
+        }
+        missing -= n;
+        XXH_memcpy(buffer + missing, p, n);
+    }
+    XXH_ASSERT(0);  /* the concatenation must be at least one stripe long */
+    return buffer;
+}
+
+/*
+ * Same as XXH3_hashLong_internal_loop(), on the concatenation of `iov`.
+ * `len` is the total length of the fragments.
+ * Whole stripes are consumed in place, a stripe straddling fragments is gathered first.
+ */
+XXH_FORCE_INLINE void
+XXH3_hashLong_vec_loop(xxh_u64* XXH_RESTRICT acc,
+                       const XXH3_iovec_t* iov, size_t iovcnt, size_t len,
+                       const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
+                       XXH3_accWidth_e accWidth,
+                       XXH3_f_accumulate_512 f_acc512,
+                       XXH3_f_scrambleAcc f_scramble)
+{
+    size_t const nbStripesPerBlock = (secretSize - XXH_STRIPE_LEN) / XXH_SECRET_CONSUME_RATE;
+    size_t const secretLimit = secretSize - XXH_STRIPE_LEN;
+    size_t nbStripesLeft = len / XXH_STRIPE_LEN;
+    size_t nbStripesSoFar = 0;
+    XXH_ALIGN(XXH_ACC_ALIGN) xxh_u8 stripe[XXH_STRIPE_LEN];
+    size_t stripeSize = 0;
+    size_t n;
+
+    XXH_ASSERT(len > XXH_STRIPE_LEN);
+    for (n = 0; n < iovcnt && nbStripesLeft > 0; n++) {
+        const xxh_u8* p = (const xxh_u8*)iov[n].ptr;
+        size_t size = iov[n].len;
+        if (size == 0) continue;
+
+        if (stripeSize > 0) {  /* complete the straddling stripe */
+            size_t const fill = XXH_MIN(XXH_STRIPE_LEN - stripeSize, size);
+            XXH_memcpy(stripe + stripeSize, p, fill);
+            stripeSize += fill;
+            p += fill;
+            size -= fill;
+            if (stripeSize < XXH_STRIPE_LEN) continue;
+            f_acc512(acc, stripe, secret + nbStripesSoFar * XXH_SECRET_CONSUME_RATE, accWidth);
+            if (++nbStripesSoFar == nbStripesPerBlock) {
+                f_scramble(acc, secret + secretLimit);
+                nbStripesSoFar = 0;
+            }
+            nbStripesLeft--;
+            stripeSize = 0;
+        }
+
+        {   size_t nbStripes = XXH_MIN(size / XXH_STRIPE_LEN, nbStripesLeft);
+            nbStripesLeft -= nbStripes;
+            while (nbStripes > 0) {
+                size_t const nb = XXH_MIN(nbStripes, nbStripesPerBlock);
+                XXH3_consumeStripes(acc, &nbStripesSoFar, nbStripesPerBlock,
+                                    p, nb, secret, secretLimit,
+                                    accWidth, f_acc512, f_scramble);
+                p += nb * XXH_STRIPE_LEN;
+                size -= nb * XXH_STRIPE_LEN;
+                nbStripes -= nb;
+        }   }
+
+        if (nbStripesLeft > 0 && size > 0) {  /* beginning of a straddling stripe */
+            XXH_ASSERT(size < XXH_STRIPE_LEN);
+            XXH_memcpy(stripe, p, size);
+            stripeSize = size;
+        }
+    }
+
+    /* last stripe */
+    if (len & (XXH_STRIPE_LEN - 1)) {
+        f_acc512(acc, XXH3_iovec_lastStripe(stripe, iov, iovcnt),
+                 secret + secretSize - XXH_STRIPE_LEN - XXH_SECRET_LASTACC_START, accWidth);
+    }
+}
+
+XXH_FORCE_INLINE XXH64_hash_t
+XXH3_hashLong_64b_vec_internal(const XXH3_iovec_t* iov, size_t iovcnt, size_t len,
+                               XXH64_hash_t seed,
+                               XXH3_f_accumulate_512 f_acc512,
+                               XXH3_f_scrambleAcc f_scramble,
+                               XXH3_f_initCustomSecret f_initSec)
+{
+    XXH_ALIGN(XXH_ACC_ALIGN) xxh_u64 acc[XXH_ACC_NB] = XXH3_INIT_ACC;
+    XXH_ALIGN(XXH_SEC_ALIGN) xxh_u8 customSecret[XXH_SECRET_DEFAULT_SIZE];
+    const xxh_u8* const secret = (seed == 0) ? XXH3_kSecret : customSecret;
+    if (seed != 0) f_initSec(customSecret, seed);
+
+    XXH3_hashLong_vec_loop(acc, iov, iovcnt, len, secret, XXH_SECRET_DEFAULT_SIZE,
+                           XXH3_acc_64bits, f_acc512, f_scramble);
+    return XXH3_mergeAccs(acc, secret + XXH_SECRET_MERGEACCS_START, (xxh_u64)len * XXH_PRIME64_1);
+}
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_hashLong_128b_vec_internal(const XXH3_iovec_t* iov, size_t iovcnt, size_t len,
+                                XXH64_hash_t seed,
+                                XXH3_f_accumulate_512 f_acc512,
+                                XXH3_f_scrambleAcc f_scramble,
+                                XXH3_f_initCustomSecret f_initSec)
+{
+    XXH_ALIGN(XXH_ACC_ALIGN) xxh_u64 acc[XXH_ACC_NB] = XXH3_INIT_ACC;
+    XXH_ALIGN(XXH_SEC_ALIGN) xxh_u8 customSecret[XXH_SECRET_DEFAULT_SIZE];
+    const xxh_u8* const secret = (seed == 0) ? XXH3_kSecret : customSecret;
+    if (seed != 0) f_initSec(customSecret, seed);
+
+    XXH3_hashLong_vec_loop(acc, iov, iovcnt, len, secret, XXH_SECRET_DEFAULT_SIZE,
+                           XXH3_acc_128bits, f_acc512, f_scramble);
+    {   XXH128_hash_t h128;
+        h128.low64  = XXH3_mergeAccs(acc, secret + XXH_SECRET_MERGEACCS_START,
+                                     (xxh_u64)len * XXH_PRIME64_1);
+        h128.high64 = XXH3_mergeAccs(acc, secret + XXH_SECRET_DEFAULT_SIZE - sizeof(acc) - XXH_SECRET_MERGEACCS_START,
+                                     ~((xxh_u64)len * XXH_PRIME64_2));
+        return h128;
+    }
+}
+
+XXH_NO_INLINE XXH64_hash_t
+XXH3_hashLong_64b_vec(const XXH3_iovec_t* iov, size_t iovcnt, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_64b_vec_internal(iov, iovcnt, len, seed,
+                XXH3_accumulate_512, XXH3_scrambleAcc, XXH3_initCustomSecret);
+}
+
+XXH_NO_INLINE XXH128_hash_t
+XXH3_hashLong_128b_vec(const XXH3_iovec_t* iov, size_t iovcnt, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_128b_vec_internal(iov, iovcnt, len, seed,
+                XXH3_accumulate_512, XXH3_scrambleAcc, XXH3_initCustomSecret);
+}
+
+typedef XXH64_hash_t (*XXH3_hashLong64_vec_f)(const XXH3_iovec_t*, size_t, size_t, XXH64_hash_t);
+typedef XXH128_hash_t (*XXH3_hashLong128_vec_f)(const XXH3_iovec_t*, size_t, size_t, XXH64_hash_t);
+
+/*
+ * Gathers a short concatenation into `buffer`,
+ * unless it is made of a single non-empty fragment.
+ */
+static const void*
+XXH3_iovec_gatherShort(xxh_u8* buffer, const XXH3_iovec_t* iov, size_t iovcnt, size_t len)
+{
+    size_t pos = 0;
+    size_t n;
+    XXH_ASSERT(len <= XXH3_MIDSIZE_MAX);
+    for (n = 0; n < iovcnt; n++) {
+        if (iov[n].len == 0) continue;
+        if (iov[n].len == len) return iov[n].ptr;  /* single non-empty fragment */
+        XXH_memcpy(buffer + pos, iov[n].ptr, iov[n].len);
+        pos += iov[n].len;
+    }
+    return buffer;
+}
+
+XXH_FORCE_INLINE XXH64_hash_t
+XXH3_64bits_vec_internal(const XXH3_iovec_t* iov, size_t iovcnt, XXH64_hash_t seed,
+                         XXH3_hashLong64_vec_f f_hashLong)
+{
+    size_t const len = XXH3_iovec_totalLen(iov, iovcnt);
+    if (len <= XXH3_MIDSIZE_MAX) {
+        xxh_u8 buffer[XXH3_MIDSIZE_MAX];
+        return XXH3_64bits_internal(XXH3_iovec_gatherShort(buffer, iov, iovcnt, len), len,
+                                    seed, XXH3_kSecret, sizeof(XXH3_kSecret), XXH3_hashLong_64b_withSeed);
+    }
+    return f_hashLong(iov, iovcnt, len, seed);
+}
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_128bits_vec_internal(const XXH3_iovec_t* iov, size_t iovcnt, XXH64_hash_t seed,
+                          XXH3_hashLong128_vec_f f_hashLong)
+{
+    size_t const len = XXH3_iovec_totalLen(iov, iovcnt);
+    if (len <= XXH3_MIDSIZE_MAX) {
+        xxh_u8 buffer[XXH3_MIDSIZE_MAX];
+        return XXH3_128bits_internal(XXH3_iovec_gatherShort(buffer, iov, iovcnt, len), len,
+                                     seed, XXH3_kSecret, sizeof(XXH3_kSecret), XXH3_hashLong_128b_withSeed);
+    }
+    return f_hashLong(iov, iovcnt, len, seed);
+}
+
+XXH_PUBLIC_API XXH64_hash_t
+XXH3_64bits_vec(const XXH3_iovec_t* iov, size_t iovcnt)
+{
+    return XXH3_64bits_vec_internal(iov, iovcnt, 0, XXH3_hashLong_64b_vec);
+}
+
+XXH_PUBLIC_API XXH64_hash_t
+XXH3_64bits_withSeed_vec(const XXH3_iovec_t* iov, size_t iovcnt, XXH64_hash_t seed)
+{
+    return XXH3_64bits_vec_internal(iov, iovcnt, seed, XXH3_hashLong_64b_vec);
+}
+
+XXH_PUBLIC_API XXH128_hash_t
+XXH3_128bits_vec(const XXH3_iovec_t* iov, size_t iovcnt)
+{
+    return XXH3_128bits_vec_internal(iov, iovcnt, 0, XXH3_hashLong_128b_vec);
+}
+
+XXH_PUBLIC_API XXH128_hash_t
+XXH3_128bits_withSeed_vec(const XXH3_iovec_t* iov, size_t iovcnt, XXH64_hash_t seed)
+{
+    return XXH3_128bits_vec_internal(iov, iovcnt, seed, XXH3_hashLong_128b_vec);
+}
+
+
+/* ===   XXH3 zero runs   === */
+
+/*
+ * On a stripe of zeros, XXH3_accumulate_512() adds `key_lo * key_hi`
+ * to each accumulator, whatever the accumulator width:
+ * the contribution only depends on the secret.
+ */
+XXH_FORCE_INLINE void
+XXH3_accumulateZeros(xxh_u64* XXH_RESTRICT acc, const xxh_u8* XXH_RESTRICT secret, size_t nbStripes)
+{
+    size_t n, i;
+    for (n = 0; n < nbStripes; n++) {
+        for (i = 0; i < XXH_ACC_NB; i++) {
+            xxh_u64 const key64 = XXH_readLE64(secret + n * XXH_SECRET_CONSUME_RATE + 8*i);
+            acc[i] += XXH_mult32to64(key64 & 0xFFFFFFFF, key64 >> 32);
+    }   }
+}
+
+/*
+ * Same as XXH3_consumeStripes() on `nbStripes` stripes of zeros.
+ * Whole blocks add a sum computed once, then scramble.
+ */
+XXH_FORCE_INLINE void
+XXH3_consumeZeroStripes(xxh_u64* XXH_RESTRICT acc,
+                        size_t* XXH_RESTRICT nbStripesSoFarPtr, size_t nbStripesPerBlock,
+                        size_t nbStripes,
+                        const xxh_u8* XXH_RESTRICT secret, size_t secretLimit,
+                        XXH3_accWidth_e accWidth,
+                        XXH3_f_accumulate_512 f_acc512,
+                        XXH3_f_scrambleAcc f_scramble)
+{
+    size_t const nbStripesToEndofBlock = nbStripesPerBlock - *nbStripesSoFarPtr;
+    if (nbStripes < nbStripesToEndofBlock) {
+        XXH3_accumulateZeros(acc, secret + *nbStripesSoFarPtr * XXH_SECRET_CONSUME_RATE, nbStripes);
+        *nbStripesSoFarPtr += nbStripes;
+        return;
+    }
+    XXH3_accumulateZeros(acc, secret + *nbStripesSoFarPtr * XXH_SECRET_CONSUME_RATE, nbStripesToEndofBlock);
+    f_scramble(acc, secret + secretLimit);
+    nbStripes -= nbStripesToEndofBlock;
+
+    if (nbStripes >= nbStripesPerBlock) {
+        XXH_ALIGN(XXH_ACC_ALIGN) xxh_u8 blockSum[XXH_STRIPE_LEN];
+        size_t nbBlocks = nbStripes / nbStripesPerBlock;
+        {   xxh_u64 sum[XXH_ACC_NB] = { 0 };
+            size_t i;
+            XXH3_accumulateZeros(sum, secret, nbStripesPerBlock);
+            /* the 128-bit width swaps adjacent lanes of its input */
+            for (i = 0; i < XXH_ACC_NB; i++)
+                XXH_writeLE64(blockSum + 8*i, sum[(accWidth == XXH3_acc_64bits) ? i : i ^ 1]);
+        }
+        nbStripes -= nbBlocks * nbStripesPerBlock;
+        while (nbBlocks--) {
             /*
-             * 64-bit optimized (albeit more confusing) version.
-             *
-             * Uses some properties of addition and multiplication to remove the mask:
-             *
-             * Let:
-             *    a = input_hi.lo = (input_hi & 0x00000000FFFFFFFF)
-             *    b = input_hi.hi = (input_hi & 0xFFFFFFFF00000000)
-             *    c = XXH_PRIME32_2
-             *
-             *    a + (b * c)
-             * Inverse Property: x + y - x == y
-             *    a + (b * (1 + c - 1))
-             * Distributive Property: x * (y + z) == (x * y) + (x * z)
-             *    a + (b * 1) + (b * (c - 1))
-             * Identity Property: x * 1 == x
-             *    a + b + (b * (c - 1))
-             *
-             * Substitute a, b, and c:
-             *    input_hi.hi + input_hi.lo + ((xxh_u64)input_hi.lo * (XXH_PRIME32_2 - 1))
-             *
-             * Since input_hi.hi + input_hi.lo == input_hi, we get this:
-             *    input_hi + ((xxh_u64)input_hi.lo * (XXH_PRIME32_2 - 1))
+             * Adds blockSum to acc: with the input used as its own secret,
+             * the multiplication term is zero. Scalar additions would stall
+             * the vector loads of f_scramble() on store forwarding.
              */
-            m128.high64 += input_hi + XXH_mult32to64((xxh_u32)input_hi, XXH_PRIME32_2 - 1);
+            f_acc512(acc, blockSum, blockSum, accWidth);
+            f_scramble(acc, secret + secretLimit);
+    }   }
+
+    XXH3_accumulateZeros(acc, secret, nbStripes);
+    *nbStripesSoFarPtr = nbStripes;
+}
+
+/*
+ * Follows the steps of XXH3_consumeInput() exactly,
+ * so that the state ends up identical, including its buffer.
+ */
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_updateZeros(XXH3_state_t* state, size_t len,
+                 XXH3_accWidth_e accWidth,
+                 XXH3_f_accumulate_512 f_acc512,
+                 XXH3_f_scrambleAcc f_scramble)
+{
+    const unsigned char* const secret = (state->extSecret == NULL) ? state->customSecret : state->extSecret;
+    xxh_u8* const lastStripeSlot = state->buffer + sizeof(state->buffer) - XXH_STRIPE_LEN;
+
+    state->totalLen += len;
+
+    if (state->bufferedSize + len <= XXH3_INTERNALBUFFER_SIZE) {
+        memset(state->buffer + state->bufferedSize, 0, len);
+        state->bufferedSize += (XXH32_hash_t)len;
+        return XXH_OK;
+    }
+
+    if (state->bufferedSize) {
+        size_t const loadSize = (XXH_STRIPE_LEN - state->bufferedSize % XXH_STRIPE_LEN) % XXH_STRIPE_LEN;
+        size_t const nbStripes = (state->bufferedSize + loadSize) / XXH_STRIPE_LEN;
+        memset(state->buffer + state->bufferedSize, 0, loadSize);
+        len -= loadSize;
+        XXH3_consumeStripes(state->acc,
+                           &state->nbStripesSoFar, state->nbStripesPerBlock,
+                            state->buffer, nbStripes,
+                            secret, state->secretLimit,
+                            accWidth, f_acc512, f_scramble);
+        if (state->buffer + (nbStripes - 1) * XXH_STRIPE_LEN != lastStripeSlot)
+            memcpy(lastStripeSlot, state->buffer + (nbStripes - 1) * XXH_STRIPE_LEN, XXH_STRIPE_LEN);
+        state->bufferedSize = 0;
+    }
+
+    {   size_t const nbStripes = len / XXH_STRIPE_LEN;
+        if (nbStripes) {
+            XXH3_consumeZeroStripes(state->acc,
+                                   &state->nbStripesSoFar, state->nbStripesPerBlock,
+                                    nbStripes,
+                                    secret, state->secretLimit,
+                                    accWidth, f_acc512, f_scramble);
+            len -= nbStripes * XXH_STRIPE_LEN;
+            /* for last partial stripe */
+            memset(lastStripeSlot, 0, XXH_STRIPE_LEN);
+    }   }
+
+    if (len) {
+        memset(state->buffer, 0, len);
+        state->bufferedSize = (XXH32_hash_t)len;
+    }
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_updateZeros(XXH3_state_t* state, size_t nbZeros)
+{
+    return XXH3_updateZeros(state, nbZeros, XXH3_acc_64bits, XXH3_accumulate_512, XXH3_scrambleAcc);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_updateZeros(XXH3_state_t* state, size_t nbZeros)
+{
+    return XXH3_updateZeros(state, nbZeros, XXH3_acc_128bits, XXH3_accumulate_512, XXH3_scrambleAcc);
+}
+
+
+/* ===   XXH3 typed appends   === */
+
+/*
+ * Small fixed-size fields go straight into the internal buffer.
+ * With a constant @size, the copy is a single store, and the checks of
+ * XXH3_update() are reduced to one comparison.
+ * A full buffer is consumed by the regular update, like any other input,
+ * which keeps the result identical to hashing the concatenated bytes.
+ */
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_append(XXH3_state_t* state, const xxh_u8* bytes, size_t size, XXH3_accWidth_e accWidth)
+{
+    if (state->bufferedSize + size <= XXH3_INTERNALBUFFER_SIZE) {
+        XXH_memcpy(state->buffer + state->bufferedSize, bytes, size);
+        state->bufferedSize += (XXH32_hash_t)size;
+        state->totalLen += size;
+        return XXH_OK;
+    }
+    return (accWidth == XXH3_acc_64bits) ? XXH3_64bits_update(state, bytes, size)
+                                         : XXH3_128bits_update(state, bytes, size);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_append_u8(XXH3_state_t* state, unsigned char value)
+{
+    xxh_u8 const byte = (xxh_u8)value;
+    return XXH3_append(state, &byte, 1, XXH3_acc_64bits);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_append_u16(XXH3_state_t* state, unsigned short value)
+{
+    xxh_u8 bytes[2];
+    bytes[0] = (xxh_u8)value;
+    bytes[1] = (xxh_u8)(value >> 8);
+    return XXH3_append(state, bytes, sizeof(bytes), XXH3_acc_64bits);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_append_u32(XXH3_state_t* state, XXH32_hash_t value)
+{
+    xxh_u8 bytes[4];
+    XXH_writeLE32(bytes, value);
+    return XXH3_append(state, bytes, sizeof(bytes), XXH3_acc_64bits);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_append_u64(XXH3_state_t* state, XXH64_hash_t value)
+{
+    xxh_u8 bytes[8];
+    XXH_writeLE64(bytes, value);
+    return XXH3_append(state, bytes, sizeof(bytes), XXH3_acc_64bits);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_append_u8(XXH3_state_t* state, unsigned char value)
+{
+    xxh_u8 const byte = (xxh_u8)value;
+    return XXH3_append(state, &byte, 1, XXH3_acc_128bits);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_append_u16(XXH3_state_t* state, unsigned short value)
+{
+    xxh_u8 bytes[2];
+    bytes[0] = (xxh_u8)value;
+    bytes[1] = (xxh_u8)(value >> 8);
+    return XXH3_append(state, bytes, sizeof(bytes), XXH3_acc_128bits);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_append_u32(XXH3_state_t* state, XXH32_hash_t value)
+{
+    xxh_u8 bytes[4];
+    XXH_writeLE32(bytes, value);
+    return XXH3_append(state, bytes, sizeof(bytes), XXH3_acc_128bits);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_append_u64(XXH3_state_t* state, XXH64_hash_t value)
+{
+    xxh_u8 bytes[8];
+    XXH_writeLE64(bytes, value);
+    return XXH3_append(state, bytes, sizeof(bytes), XXH3_acc_128bits);
+}
+
+
+/* ===   XXH3 NUL-terminated strings   === */
+
+/*
+ * Strings are searched, then hashed, by chunks small enough to remain in L1 cache.
+ * Strings shorter than a chunk are hashed in a single shot, longer ones are streamed.
+ */
+#ifndef XXH3_CSTR_CHUNK_SIZE
+#  define XXH3_CSTR_CHUNK_SIZE (8 << 10)
+#endif
+
+/*
+ * Length of @s, or @maxLen if it is longer.
+ * memchr() stops at the first match, so it never reads past the terminator,
+ * and C libraries provide vectorized implementations.
+ */
+static size_t XXH_strnlen(const char* s, size_t maxLen)
+{
+    const char* const end = (const char*)memchr(s, 0, maxLen);
+    return (end == NULL) ? maxLen : (size_t)(end - s);
+}
+
+typedef XXH64_hash_t (*XXH3_f_hash64)(const void* input, size_t len, XXH64_hash_t seed);
+typedef XXH128_hash_t (*XXH3_f_hash128)(const void* input, size_t len, XXH64_hash_t seed);
+
+/* @s is known to start with a full chunk of non-NUL characters */
+static void
+XXH3_update_cstr(XXH3_state_t* state, const char* s, XXH3_f_update f_update)
+{
+    size_t len = XXH3_CSTR_CHUNK_SIZE;
+    do {
+        (void)f_update(state, s, len);
+        s += len;
+        len = XXH_strnlen(s, XXH3_CSTR_CHUNK_SIZE);
+    } while (len == XXH3_CSTR_CHUNK_SIZE);
+    (void)f_update(state, s, len);
+}
+
+/* kept out of line: the state would otherwise burden the stack frame of short strings */
+XXH_NO_INLINE XXH64_hash_t
+XXH3_64bits_cstr_stream(const char* s, XXH64_hash_t seed, XXH3_f_update f_update)
+{
+    XXH3_state_t state;
+    (void)XXH3_64bits_reset_withSeed(&state, seed);
+    XXH3_update_cstr(&state, s, f_update);
+    return XXH3_64bits_digest(&state);
+}
+
+XXH_FORCE_INLINE XXH64_hash_t
+XXH3_64bits_cstr_internal(const char* s, XXH64_hash_t seed,
+                          XXH3_f_hash64 f_hash, XXH3_f_update f_update)
+{
+    size_t len;
+#if defined(XXH_ACCEPT_NULL_INPUT_POINTER) && (XXH_ACCEPT_NULL_INPUT_POINTER>=1)
+    if (s == NULL) return f_hash(NULL, 0, seed);
+#endif
+    len = XXH_strnlen(s, XXH3_CSTR_CHUNK_SIZE);
+    if (len < XXH3_CSTR_CHUNK_SIZE) return f_hash(s, len, seed);
+    return XXH3_64bits_cstr_stream(s, seed, f_update);
+}
+
+XXH_NO_INLINE XXH128_hash_t
+XXH3_128bits_cstr_stream(const char* s, XXH64_hash_t seed, XXH3_f_update f_update)
+{
+    XXH3_state_t state;
+    (void)XXH3_128bits_reset_withSeed(&state, seed);
+    XXH3_update_cstr(&state, s, f_update);
+    return XXH3_128bits_digest(&state);
+}
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_128bits_cstr_internal(const char* s, XXH64_hash_t seed,
+                           XXH3_f_hash128 f_hash, XXH3_f_update f_update)
+{
+    size_t len;
+#if defined(XXH_ACCEPT_NULL_INPUT_POINTER) && (XXH_ACCEPT_NULL_INPUT_POINTER>=1)
+    if (s == NULL) return f_hash(NULL, 0, seed);
+#endif
+    len = XXH_strnlen(s, XXH3_CSTR_CHUNK_SIZE);
+    if (len < XXH3_CSTR_CHUNK_SIZE) return f_hash(s, len, seed);
+    return XXH3_128bits_cstr_stream(s, seed, f_update);
+}
+
+XXH_PUBLIC_API XXH64_hash_t XXH3_64bits_cstr(const char* s)
+{
+    return XXH3_64bits_cstr_internal(s, 0, XXH3_64bits_withSeed, XXH3_64bits_update);
+}
+
+XXH_PUBLIC_API XXH64_hash_t XXH3_64bits_cstr_withSeed(const char* s, XXH64_hash_t seed)
+{
+    return XXH3_64bits_cstr_internal(s, seed, XXH3_64bits_withSeed, XXH3_64bits_update);
+}
+
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_cstr(const char* s)
+{
+    return XXH3_128bits_cstr_internal(s, 0, XXH3_128bits_withSeed, XXH3_128bits_update);
+}
+
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_cstr_withSeed(const char* s, XXH64_hash_t seed)
+{
+    return XXH3_128bits_cstr_internal(s, seed, XXH3_128bits_withSeed, XXH3_128bits_update);
+}
+
+
+/* ===   XXH3 ASCII case-insensitive hashing   === */
+
+/*
+ * Input is folded to lower case into a stack buffer, one chunk at a time,
+ * so that it's still in L1 cache when hashed.
+ */
+#ifndef XXH3_LOWERCASE_CHUNK_SIZE
+#  define XXH3_LOWERCASE_CHUNK_SIZE (4 << 10)
+#endif
+#if (XXH3_LOWERCASE_CHUNK_SIZE < XXH3_MIDSIZE_MAX)
+#  error "XXH3_LOWERCASE_CHUNK_SIZE must be at least XXH3_MIDSIZE_MAX"
+#endif
+
+/*
+ * Only 'A' (0x41) to 'Z' (0x5A) are changed, whatever the locale or charset.
+ *
+ * 8 bytes are folded at once: within each byte, adding to the low 7 bits
+ * sets bit 7 if they reach 'A' (0x80 - 0x3F), or go beyond 'Z' (0x80 - 0x25),
+ * and cannot carry into the next byte. The resulting mask, restricted to
+ * ASCII bytes, is moved onto the case bit 0x20.
+ * This doesn't depend on compilers auto-vectorizing the loop, which GCC won't
+ * do at -O2 (see the AVX2 note at the top of this file).
+ */
+XXH_FORCE_INLINE xxh_u64 XXH_toLowerASCII64(xxh_u64 w)
+{
+    xxh_u64 const low7 = w & 0x7F7F7F7F7F7F7F7FULL;
+    xxh_u64 const geA = low7 + 0x3F3F3F3F3F3F3F3FULL;
+    xxh_u64 const gtZ = low7 + 0x2525252525252525ULL;
+    xxh_u64 const upper = geA & ~gtZ & ~w & 0x8080808080808080ULL;
+    return w | (upper >> 2);
+}
+
+XXH_FORCE_INLINE void XXH_toLowerASCII(xxh_u8* dst, const xxh_u8* src, size_t len)
+{
+    size_t i;
+    for (i = 0; i + 8 <= len; i += 8)
+        XXH_writeLE64(dst + i, XXH_toLowerASCII64(XXH_readLE64(src + i)));
+    for (; i < len; i++) {
+        xxh_u8 const c = src[i];
+        dst[i] = (xxh_u8)(c | ((xxh_u8)(c - 0x41) < 26) << 5);
+    }
+}
+
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_update_lowercase_internal(XXH3_state_t* state, const void* input, size_t len, XXH3_f_update f_update)
+{
+    const xxh_u8* p = (const xxh_u8*)input;
+    xxh_u8 folded[XXH3_LOWERCASE_CHUNK_SIZE];
+    if (input == NULL) return f_update(state, input, len);
+    while (len > 0) {
+        size_t const l = (len < sizeof(folded)) ? len : sizeof(folded);
+        XXH_toLowerASCII(folded, p, l);
+        (void)f_update(state, folded, l);
+        p += l;
+        len -= l;
+    }
+    return XXH_OK;
+}
+
+/* long inputs are streamed, out of line to keep the state off the stack frame of short ones */
+XXH_NO_INLINE XXH64_hash_t
+XXH3_64bits_lowercase_stream(const void* input, size_t len, XXH64_hash_t seed, XXH3_f_update f_update)
+{
+    XXH3_state_t state;
+    (void)XXH3_64bits_reset_withSeed(&state, seed);
+    (void)XXH3_update_lowercase_internal(&state, input, len, f_update);
+    return XXH3_64bits_digest(&state);
+}
+
+XXH_FORCE_INLINE XXH64_hash_t
+XXH3_64bits_lowercase_internal(const void* input, size_t len, XXH64_hash_t seed,
+                               XXH3_f_hash64 f_hash, XXH3_f_update f_update)
+{
+    if (len == 0) return f_hash(input, 0, seed);   /* nothing to fold */
+    if (len <= XXH3_MIDSIZE_MAX) {
+        xxh_u8 folded[XXH3_MIDSIZE_MAX];
+        XXH_toLowerASCII(folded, (const xxh_u8*)input, len);
+        return f_hash(folded, len, seed);
+    }
+    return XXH3_64bits_lowercase_stream(input, len, seed, f_update);
+}
+
+XXH_NO_INLINE XXH128_hash_t
+XXH3_128bits_lowercase_stream(const void* input, size_t len, XXH64_hash_t seed, XXH3_f_update f_update)
+{
+    XXH3_state_t state;
+    (void)XXH3_128bits_reset_withSeed(&state, seed);
+    (void)XXH3_update_lowercase_internal(&state, input, len, f_update);
+    return XXH3_128bits_digest(&state);
+}
+
+XXH_FORCE_INLINE XXH128_hash_t
+XXH3_128bits_lowercase_internal(const void* input, size_t len, XXH64_hash_t seed,
+                                XXH3_f_hash128 f_hash, XXH3_f_update f_update)
+{
+    if (len == 0) return f_hash(input, 0, seed);   /* nothing to fold */
+    if (len <= XXH3_MIDSIZE_MAX) {
+        xxh_u8 folded[XXH3_MIDSIZE_MAX];
+        XXH_toLowerASCII(folded, (const xxh_u8*)input, len);
+        return f_hash(folded, len, seed);
+    }
+    return XXH3_128bits_lowercase_stream(input, len, seed, f_update);
+}
+
+XXH_PUBLIC_API XXH64_hash_t XXH3_64bits_lowercase(const void* input, size_t len)
+{
+    return XXH3_64bits_lowercase_internal(input, len, 0, XXH3_64bits_withSeed, XXH3_64bits_update);
+}
+
+XXH_PUBLIC_API XXH64_hash_t
+XXH3_64bits_lowercase_withSeed(const void* input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_64bits_lowercase_internal(input, len, seed, XXH3_64bits_withSeed, XXH3_64bits_update);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_update_lowercase(XXH3_state_t* state, const void* input, size_t len)
+{
+    return XXH3_update_lowercase_internal(state, input, len, XXH3_64bits_update);
+}
+
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_lowercase(const void* input, size_t len)
+{
+    return XXH3_128bits_lowercase_internal(input, len, 0, XXH3_128bits_withSeed, XXH3_128bits_update);
+}
+
+XXH_PUBLIC_API XXH128_hash_t
+XXH3_128bits_lowercase_withSeed(const void* input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_128bits_lowercase_internal(input, len, seed, XXH3_128bits_withSeed, XXH3_128bits_update);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_128bits_update_lowercase(XXH3_state_t* state, const void* input, size_t len)
+{
+    return XXH3_update_lowercase_internal(state, input, len, XXH3_128bits_update);
+}
+
+
+/* ===   XXH3 set digest   === */
+
+XXH_FORCE_INLINE void XXH3_set_add128(XXH128_hash_t* sum, XXH128_hash_t h)
+{
+    sum->low64 += h.low64;
+    sum->high64 += h.high64 + (sum->low64 < h.low64);
+}
+
+XXH_FORCE_INLINE void XXH3_set_sub128(XXH128_hash_t* sum, XXH128_hash_t h)
+{
+    xxh_u64 const borrow = (sum->low64 < h.low64);
+    sum->low64 -= h.low64;
+    sum->high64 -= h.high64 + borrow;
+}
+
+XXH_PUBLIC_API XXH_errorcode XXH3_set_init(XXH3_set_t* set, XXH64_hash_t seed)
+{
+    if (set == NULL) return XXH_ERROR;
+    set->sum.low64 = 0;
+    set->sum.high64 = 0;
+    set->count = 0;
+    set->seed = seed;
+    return XXH_OK;
+}
+
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_set_add_internal(XXH3_set_t* set, const void* element, size_t len, XXH3_f_hash128 f_hash)
+{
+    if (set == NULL || (element == NULL && len > 0)) return XXH_ERROR;
+    XXH3_set_add128(&set->sum, f_hash(element, len, set->seed));
+    set->count++;
+    return XXH_OK;
+}
+
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_set_remove_internal(XXH3_set_t* set, const void* element, size_t len, XXH3_f_hash128 f_hash)
+{
+    if (set == NULL || (element == NULL && len > 0)) return XXH_ERROR;
+    XXH3_set_sub128(&set->sum, f_hash(element, len, set->seed));
+    set->count--;
+    return XXH_OK;
+}
+
+/* the sum is kept in registers, instead of being stored back after each element */
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_set_addBatch_internal(XXH3_set_t* set, const void* elements, size_t elementSize, size_t nbElements,
+                           XXH3_f_hash128 f_hash)
+{
+    const xxh_u8* p = (const xxh_u8*)elements;
+    XXH128_hash_t sum;
+    XXH64_hash_t seed;
+    size_t n;
+    if (set == NULL) return XXH_ERROR;
+    if (elements == NULL && elementSize > 0 && nbElements > 0) return XXH_ERROR;
+    sum = set->sum;
+    seed = set->seed;
+    for (n = 0; n < nbElements; n++) {
+        XXH3_set_add128(&sum, f_hash(p, elementSize, seed));
+        p += elementSize;
+    }
+    set->sum = sum;
+    set->count += nbElements;
+    return XXH_OK;
+}
+
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_set_addGather_internal(XXH3_set_t* set, const void* const* elements, const size_t* lengths, size_t nbElements,
+                            XXH3_f_hash128 f_hash)
+{
+    XXH128_hash_t sum;
+    XXH64_hash_t seed;
+    size_t n;
+    if (set == NULL) return XXH_ERROR;
+    if (nbElements > 0 && (elements == NULL || lengths == NULL)) return XXH_ERROR;
+    sum = set->sum;
+    seed = set->seed;
+    for (n = 0; n < nbElements; n++)
+        if (elements[n] == NULL && lengths[n] > 0) return XXH_ERROR;
+    for (n = 0; n < nbElements; n++)
+        XXH3_set_add128(&sum, f_hash(elements[n], lengths[n], seed));
+    set->sum = sum;
+    set->count += nbElements;
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode XXH3_set_add(XXH3_set_t* set, const void* element, size_t len)
+{
+    return XXH3_set_add_internal(set, element, len, XXH3_128bits_withSeed);
+}
+
+XXH_PUBLIC_API XXH_errorcode XXH3_set_remove(XXH3_set_t* set, const void* element, size_t len)
+{
+    return XXH3_set_remove_internal(set, element, len, XXH3_128bits_withSeed);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_set_addBatch(XXH3_set_t* set, const void* elements, size_t elementSize, size_t nbElements)
+{
+    return XXH3_set_addBatch_internal(set, elements, elementSize, nbElements, XXH3_128bits_withSeed);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_set_addGather(XXH3_set_t* set, const void* const* elements, const size_t* lengths, size_t nbElements)
+{
+    return XXH3_set_addGather_internal(set, elements, lengths, nbElements, XXH3_128bits_withSeed);
+}
+
+XXH_PUBLIC_API XXH_errorcode XXH3_set_merge(XXH3_set_t* set, const XXH3_set_t* other)
+{
+    if (set == NULL || other == NULL) return XXH_ERROR;
+    if (set->seed != other->seed) return XXH_ERROR;
+    XXH3_set_add128(&set->sum, other->sum);
+    set->count += other->count;
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH128_hash_t XXH3_set_digest(const XXH3_set_t* set)
+{
+    struct {
+        XXH64_canonical_t count;
+        XXH128_canonical_t sum;
+    } digestInput;
+    XXH_STATIC_ASSERT(sizeof(digestInput) == 24);
+    XXH_ASSERT(set != NULL);
+    XXH64_canonicalFromHash(&digestInput.count, set->count);
+    XXH128_canonicalFromHash(&digestInput.sum, set->sum);
+    return XXH3_128bits_withSeed(&digestInput, sizeof(digestInput), set->seed ^ XXH_PRIME64_2);
+}
+
+
+/* ===   XXH3 dual-width hashing   === */
+
+/*
+ * XXH3_64bits() and XXH3_128bits() of the same input, from a single pass.
+ *
+ * The long paths of both widths consume the input stripe by stripe, with the
+ * same secret, and both add the same `data_key` product to their accumulators.
+ * They only differ in which lane receives the raw input (see XXH3_acc_dual),
+ * and in the final merge. Hence a single loop feeds 2 sets of accumulators,
+ * loading each stripe and computing each product once.
+ *
+ * Short inputs go through both short hashes, inlined side by side,
+ * so that the compiler can share their input loads.
+ */
+
+XXH_FORCE_INLINE void
+XXH3_initAccs_dual(xxh_u64* acc)
+{
+    static const xxh_u64 initAcc[XXH_ACC_NB] = XXH3_INIT_ACC;
+    memcpy(acc, initAcc, sizeof(initAcc));
+    memcpy(acc + XXH_ACC_NB, initAcc, sizeof(initAcc));
+}
+
+XXH_FORCE_INLINE XXH3_dualHash_t
+XXH3_mergeAccs_dual(const xxh_u64* XXH_RESTRICT acc,
+                    const xxh_u8* XXH_RESTRICT secret, size_t secretSize, xxh_u64 len)
+{
+    XXH3_dualHash_t h;
+    XXH_ASSERT(secretSize >= XXH_STRIPE_LEN + XXH_SECRET_MERGEACCS_START);
+    h.h64 = XXH3_mergeAccs(acc, secret + XXH_SECRET_MERGEACCS_START, len * XXH_PRIME64_1);
+    h.h128.low64  = XXH3_mergeAccs(acc + XXH_ACC_NB,
+                                   secret + XXH_SECRET_MERGEACCS_START,
+                                   len * XXH_PRIME64_1);
+    h.h128.high64 = XXH3_mergeAccs(acc + XXH_ACC_NB,
+                                   secret + secretSize - XXH_STRIPE_LEN - XXH_SECRET_MERGEACCS_START,
+                                   ~(len * XXH_PRIME64_2));
+    return h;
+}
+
+XXH_FORCE_INLINE XXH3_dualHash_t
+XXH3_hashLong_dual_internal(const xxh_u8* XXH_RESTRICT input, size_t len,
+                            XXH64_hash_t seed,
+                            XXH3_f_accumulate_512 f_acc512,
+                            XXH3_f_scrambleAcc f_scramble,
+                            XXH3_f_initCustomSecret f_initSec)
+{
+    XXH_ALIGN(XXH_ACC_ALIGN) xxh_u64 acc[2 * XXH_ACC_NB];
+    XXH_ALIGN(XXH_SEC_ALIGN) xxh_u8 customSecret[XXH_SECRET_DEFAULT_SIZE];
+    const xxh_u8* secret = XXH3_kSecret;
+
+    XXH_STATIC_ASSERT(sizeof(XXH3_kSecret) == XXH_SECRET_DEFAULT_SIZE);
+    if (seed != 0) {
+        f_initSec(customSecret, seed);
+        secret = customSecret;
+    }
+    XXH3_initAccs_dual(acc);
+    XXH3_hashLong_internal_loop(acc, input, len, secret, XXH_SECRET_DEFAULT_SIZE, XXH3_acc_dual, f_acc512, f_scramble);
+    return XXH3_mergeAccs_dual(acc, secret, XXH_SECRET_DEFAULT_SIZE, (xxh_u64)len);
+}
+
+/*
+ * It's important for performance that XXH3_hashLong is not inlined.
+ */
+XXH_NO_INLINE XXH3_dualHash_t
+XXH3_hashLong_dual(const xxh_u8* XXH_RESTRICT input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_dual_internal(input, len, seed,
+                XXH3_accumulate_512, XXH3_scrambleAcc, XXH3_initCustomSecret);
+}
+
+typedef XXH3_dualHash_t (*XXH3_hashLongDual_f)(const xxh_u8* XXH_RESTRICT, size_t, XXH64_hash_t);
+
+XXH_FORCE_INLINE XXH3_dualHash_t
+XXH3_dual_internal(const void* XXH_RESTRICT input, size_t len, XXH64_hash_t seed,
+                   XXH3_hashLongDual_f f_hashLong)
+{
+    const xxh_u8* const in = (const xxh_u8*)input;
+    XXH3_dualHash_t h;
+    if (len <= 16) {
+        h.h64  = XXH3_len_0to16_64b(in, len, XXH3_kSecret, seed);
+        h.h128 = XXH3_len_0to16_128b(in, len, XXH3_kSecret, seed);
+    } else if (len <= 128) {
+        h.h64  = XXH3_len_17to128_64b(in, len, XXH3_kSecret, sizeof(XXH3_kSecret), seed);
+        h.h128 = XXH3_len_17to128_128b(in, len, XXH3_kSecret, sizeof(XXH3_kSecret), seed);
+    } else if (len <= XXH3_MIDSIZE_MAX) {
+        h.h64  = XXH3_len_129to240_64b(in, len, XXH3_kSecret, sizeof(XXH3_kSecret), seed);
+        h.h128 = XXH3_len_129to240_128b(in, len, XXH3_kSecret, sizeof(XXH3_kSecret), seed);
+    } else {
+        h = f_hashLong(in, len, seed);
+    }
+    return h;
+}
+
+XXH_PUBLIC_API XXH3_dualHash_t XXH3_dual(const void* input, size_t len)
+{
+    return XXH3_dual_internal(input, len, 0, XXH3_hashLong_dual);
+}
+
+XXH_PUBLIC_API XXH3_dualHash_t
+XXH3_dual_withSeed(const void* input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_dual_internal(input, len, seed, XXH3_hashLong_dual);
+}
+
+XXH_PUBLIC_API XXH3_dualState_t* XXH3_createDualState(void)
+{
+    return (XXH3_dualState_t*)XXH_alignedMalloc(sizeof(XXH3_dualState_t), 64);
+}
+
+XXH_PUBLIC_API XXH_errorcode XXH3_freeDualState(XXH3_dualState_t* statePtr)
+{
+    XXH_alignedFree(statePtr);
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_dual_reset_withSeed(XXH3_dualState_t* statePtr, XXH64_hash_t seed)
+{
+    if (statePtr == NULL) return XXH_ERROR;
+    XXH3_initAccs_dual(statePtr->acc);
+    return XXH3_64bits_reset_withSeed(&statePtr->state, seed);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_dual_reset(XXH3_dualState_t* statePtr)
+{
+    if (statePtr == NULL) return XXH_ERROR;
+    XXH3_initAccs_dual(statePtr->acc);
+    return XXH3_64bits_reset(&statePtr->state);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_dual_update(XXH3_dualState_t* statePtr, const void* input, size_t len)
+{
+    return XXH3_update_accs(&statePtr->state, statePtr->acc, (const xxh_u8*)input, len,
+                            XXH3_acc_dual, XXH3_accumulate_512, XXH3_scrambleAcc);
+}
+
+XXH_PUBLIC_API XXH3_dualHash_t XXH3_dual_digest(const XXH3_dualState_t* statePtr)
+{
+    const XXH3_state_t* const state = &statePtr->state;
+    XXH3_dualHash_t h;
+    if (state->totalLen > XXH3_MIDSIZE_MAX) {
+        const unsigned char* const secret = (state->extSecret == NULL) ? state->customSecret : state->extSecret;
+        XXH_ALIGN(XXH_ACC_ALIGN) XXH64_hash_t acc[2 * XXH_ACC_NB];
+        XXH_STATIC_ASSERT(sizeof(acc) == sizeof(statePtr->acc));
+        XXH3_digest_long(acc, statePtr->acc, state, secret, XXH3_acc_dual);
+        return XXH3_mergeAccs_dual(acc, secret, state->secretLimit + XXH_STRIPE_LEN, (xxh_u64)state->totalLen);
+    }
+    /* short inputs don't use the accumulators */
+    h.h64  = XXH3_64bits_digest(state);
+    h.h128 = XXH3_128bits_digest(state);
+    return h;
+}
+
+
+
+/* ===   XXH3 packed states   === */
+
+/*
+ * Dense, endian-neutral form of an idle XXH3_state_t.
+ *
+ * The stripes waiting in the internal buffer are consumed at pack time,
+ * which leaves less than a stripe of input to keep. Together with the stripe
+ * needed by the digest of a partial last stripe, that's the last 64 bytes
+ * of input. The secret is not stored: a seed-derived secret is generated
+ * again on unpack, and an external secret must be provided again.
+ *
+ * Layout, little endian:
+ *   0: version, 1: flags, 2: buffered size, 3: reserved (0),
+ *   4: nbStripesSoFar (32-bit), 8: secret size (32-bit),
+ *  12: total length (64-bit), 20: seed (64-bit),
+ *  28: long inputs: 8 accumulators (64-bit each), then the last 64 bytes of input;
+ *      short inputs: the input itself.
+ */
+
+#define XXH3_PACKEDSTATE_VERSION 1
+#define XXH3_PACKEDSTATE_HEADER_SIZE 28
+
+/* flags of packed and saved states */
+#define XXH3_SAVED_USESEED   1
+#define XXH3_SAVED_EXTSECRET 2
+
+static xxh_u8 XXH3_savedFlags(const XXH3_state_t* state)
+{
+    size_t const secretSize = state->secretLimit + XXH_STRIPE_LEN;
+    /* XXH3_64bits_reset() references the default secret, which needs not be provided again */
+    int const extSecret = (state->extSecret != NULL)
+                       && !(!state->useSeed && secretSize == sizeof(XXH3_kSecret)
+                            && !memcmp(state->extSecret, XXH3_kSecret, sizeof(XXH3_kSecret)));
+    return (xxh_u8)((state->useSeed ? XXH3_SAVED_USESEED : 0) | (extSecret ? XXH3_SAVED_EXTSECRET : 0));
+}
+
+/*
+ * Resets @state with the secret described by @flags:
+ * the caller's @secret, which must match @savedSecretSize, or the one derived from @seed.
+ * The secret is checked first: on error, @state is left untouched.
+ */
+static XXH_errorcode
+XXH3_restoreSecret(XXH3_state_t* state, xxh_u8 flags, xxh_u64 seed, size_t savedSecretSize,
+                   const void* secret, size_t secretSize)
+{
+    if (flags & ~(XXH3_SAVED_USESEED | XXH3_SAVED_EXTSECRET)) return XXH_ERROR;
+    if (flags & XXH3_SAVED_EXTSECRET) {
+        if (secret == NULL || secretSize != savedSecretSize) return XXH_ERROR;
+        if (secretSize < XXH3_SECRET_SIZE_MIN) return XXH_ERROR;
+        XXH3_64bits_reset_internal(state, seed, (const xxh_u8*)secret, secretSize);
+    } else {
+        if (secret != NULL || savedSecretSize != XXH_SECRET_DEFAULT_SIZE) return XXH_ERROR;
+        XXH3_64bits_reset_internal(state, seed, XXH3_kSecret, XXH_SECRET_DEFAULT_SIZE);
+        if (flags & XXH3_SAVED_USESEED) {
+            XXH3_initCustomSecret(state->customSecret, seed);
+            state->extSecret = NULL;
+        }
+    }
+    state->useSeed = (flags & XXH3_SAVED_USESEED) ? 1 : 0;
+    return XXH_OK;
+}
+
+/* nbStripesPerBlock of a state whose secret is @secretSize bytes, see XXH3_64bits_reset_internal() */
+static size_t XXH3_savedStripesPerBlock(size_t secretSize)
+{
+    return (secretSize - XXH_STRIPE_LEN) / XXH_SECRET_CONSUME_RATE;
+}
+
+XXH_FORCE_INLINE size_t
+XXH3_packState(void* XXH_RESTRICT dst, size_t dstCapacity,
+               const XXH3_state_t* XXH_RESTRICT state, XXH3_accWidth_e accWidth)
+{
+    xxh_u8* const op = (xxh_u8*)dst;
+    int const isLong = state->totalLen > XXH3_MIDSIZE_MAX;
+    size_t const packedSize = XXH3_PACKEDSTATE_HEADER_SIZE
+                            + (isLong ? sizeof(state->acc) + XXH_STRIPE_LEN : (size_t)state->totalLen);
+    size_t const secretSize = state->secretLimit + XXH_STRIPE_LEN;
+    const xxh_u8* const secret = (state->extSecret == NULL) ? state->customSecret : state->extSecret;
+    size_t nbStripesSoFar = state->nbStripesSoFar;
+    size_t bufferedSize = state->bufferedSize;
+
+    XXH_STATIC_ASSERT(XXH3_PACKEDSTATE_HEADER_SIZE + XXH3_MIDSIZE_MAX <= XXH3_PACKEDSTATE_SIZE_MAX);
+    XXH_STATIC_ASSERT(XXH3_PACKEDSTATE_HEADER_SIZE + 8*XXH_ACC_NB + XXH_STRIPE_LEN <= XXH3_PACKEDSTATE_SIZE_MAX);
+    if (dst == NULL || dstCapacity < packedSize) return 0;
+
+    if (isLong) {
+        XXH_ALIGN(XXH_ACC_ALIGN) xxh_u64 acc[XXH_ACC_NB];
+        xxh_u8* const lastStripe = op + XXH3_PACKEDSTATE_HEADER_SIZE + sizeof(acc);
+        size_t i;
+        memcpy(acc, state->acc, sizeof(acc));
+        if (bufferedSize >= XXH_STRIPE_LEN) {
+            XXH3_consumeStripes(acc,
+                               &nbStripesSoFar, state->nbStripesPerBlock,
+                                state->buffer, bufferedSize / XXH_STRIPE_LEN,
+                                secret, state->secretLimit,
+                                accWidth, XXH3_accumulate_512, XXH3_scrambleAcc);
+            memcpy(lastStripe, state->buffer + bufferedSize - XXH_STRIPE_LEN, XXH_STRIPE_LEN);
+        } else {
+            /* same catch-up as XXH3_digest_long() */
+            size_t const catchupSize = XXH_STRIPE_LEN - bufferedSize;
+            memcpy(lastStripe, state->buffer + sizeof(state->buffer) - catchupSize, catchupSize);
+            memcpy(lastStripe + catchupSize, state->buffer, bufferedSize);
         }
-        /* m128 ^= XXH_swap64(m128 >> 64); */
-        m128.low64  ^= XXH_swap64(m128.high64);
+        bufferedSize %= XXH_STRIPE_LEN;
+        for (i = 0; i < XXH_ACC_NB; i++)
+            XXH_writeLE64(op + XXH3_PACKEDSTATE_HEADER_SIZE + 8*i, acc[i]);
+    } else {
+        /* nothing consumed yet: the buffer holds the whole input */
+        XXH_ASSERT(bufferedSize == state->totalLen);
+        memcpy(op + XXH3_PACKEDSTATE_HEADER_SIZE, state->buffer, bufferedSize);
+    }
 
-        {   /* 128x64 multiply: h128 = m128 * XXH_PRIME64_2; */
-            XXH128_hash_t h128 = XXH_mult64to128(m128.low64, XXH_PRIME64_2);
-            h128.high64 += m128.high64 * XXH_PRIME64_2;
+    op[0] = XXH3_PACKEDSTATE_VERSION;
+    op[1] = XXH3_savedFlags(state);
+    op[2] = (xxh_u8)bufferedSize;
+    op[3] = 0;
+    XXH_writeLE32(op + 4, (xxh_u32)nbStripesSoFar);
+    XXH_writeLE32(op + 8, (xxh_u32)secretSize);
+    XXH_writeLE64(op + 12, state->totalLen);
+    XXH_writeLE64(op + 20, state->seed);
+    return packedSize;
+}
 
-            h128.low64   = XXH3_avalanche(h128.low64);
-            h128.high64  = XXH3_avalanche(h128.high64);
-            return h128;
-    }   }
+XXH_PUBLIC_API size_t
+XXH3_64bits_packState(void* dst, size_t dstCapacity, const XXH3_state_t* state)
+{
+    return XXH3_packState(dst, dstCapacity, state, XXH3_acc_64bits);
 }
 
-/*
- * Assumption: `secret` size is >= XXH3_SECRET_SIZE_MIN
+XXH_PUBLIC_API size_t
+XXH3_128bits_packState(void* dst, size_t dstCapacity, const XXH3_state_t* state)
+{
+    return XXH3_packState(dst, dstCapacity, state, XXH3_acc_128bits);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_unpackState(XXH3_state_t* state, const void* src, size_t srcSize,
+                 const void* secret, size_t secretSize)
+{
+    const xxh_u8* const ip = (const xxh_u8*)src;
+    if (state == NULL || src == NULL || srcSize < XXH3_PACKEDSTATE_HEADER_SIZE) return XXH_ERROR;
+    if (ip[0] != XXH3_PACKEDSTATE_VERSION) return XXH_ERROR;
+
+    {   size_t const bufferedSize = ip[2];
+        xxh_u32 const nbStripesSoFar = XXH_readLE32(ip + 4);
+        xxh_u32 const packedSecretSize = XXH_readLE32(ip + 8);
+        xxh_u64 const totalLen = XXH_readLE64(ip + 12);
+        xxh_u64 const seed = XXH_readLE64(ip + 20);
+        int const isLong = totalLen > XXH3_MIDSIZE_MAX;
+
+        /* validate everything before touching @state */
+        if (isLong) {
+            if (srcSize != XXH3_PACKEDSTATE_HEADER_SIZE + sizeof(state->acc) + XXH_STRIPE_LEN) return XXH_ERROR;
+            if (bufferedSize >= XXH_STRIPE_LEN) return XXH_ERROR;
+            if (nbStripesSoFar >= XXH3_savedStripesPerBlock(packedSecretSize)) return XXH_ERROR;
+        } else {
+            if (srcSize != XXH3_PACKEDSTATE_HEADER_SIZE + (size_t)totalLen) return XXH_ERROR;
+            if (bufferedSize != totalLen || nbStripesSoFar != 0) return XXH_ERROR;
+        }
+        if (XXH3_restoreSecret(state, ip[1], seed, packedSecretSize, secret, secretSize) != XXH_OK)
+            return XXH_ERROR;
+
+        if (isLong) {
+            xxh_u8 const* const lastStripe = ip + XXH3_PACKEDSTATE_HEADER_SIZE + sizeof(state->acc);
+            size_t i;
+            for (i = 0; i < XXH_ACC_NB; i++)
+                state->acc[i] = XXH_readLE64(ip + XXH3_PACKEDSTATE_HEADER_SIZE + 8*i);
+            /* buffered input at the start of the buffer, what precedes it at the end */
+            memcpy(state->buffer, lastStripe + XXH_STRIPE_LEN - bufferedSize, bufferedSize);
+            memcpy(state->buffer + sizeof(state->buffer) - (XXH_STRIPE_LEN - bufferedSize),
+                   lastStripe, XXH_STRIPE_LEN - bufferedSize);
+        } else {
+            memcpy(state->buffer, ip + XXH3_PACKEDSTATE_HEADER_SIZE, bufferedSize);
+        }
+        state->bufferedSize = (XXH32_hash_t)bufferedSize;
+        state->nbStripesSoFar = nbStripesSoFar;
+        state->totalLen = totalLen;
+    }
+    return XXH_OK;
+}
+
+
+/* ==========================================
+ * XXH3 saved states
+ * ==========================================
+ * Portable checkpoints of streaming states (see XXH32_saveState()).
+ * The accumulators are saved as they are, without consuming the buffer,
+ * so the same saved state serves both widths.
+ *
+ * Layout, little-endian:
+ *   0: type, version, flags, 0
+ *   4: bufferedSize (4), nbStripesSoFar (4), secretSize (4)
+ *  16: totalLen (8), seed (8)
+ *  32: acc (8x8)
+ *  96: the bufferedSize bytes of the buffer, followed, when there are
+ *      fewer than a stripe, by the end of the buffer, needed for the
+ *      last stripe of long inputs.
  */
-XXH_FORCE_INLINE XXH128_hash_t
-XXH3_len_0to16_128b(const xxh_u8* input, size_t len, const xxh_u8* secret, XXH64_hash_t seed)
+
+#define XXH3_SAVEDSTATE_HEADER_SIZE 96
+
+static size_t XXH3_savedWindowSize(size_t bufferedSize)
 {
-    XXH_ASSERT(len <= 16);
-    {   if (len > 8) return XXH3_len_9to16_128b(input, len, secret, seed);
-        if (len >= 4) return XXH3_len_4to8_128b(input, len, secret, seed);
-        if (len) return XXH3_len_1to3_128b(input, len, secret, seed);
-        {   XXH128_hash_t h128;
-            xxh_u64 const bitflipl = XXH_readLE64(secret+64) ^ XXH_readLE64(secret+72);
-            xxh_u64 const bitfliph = XXH_readLE64(secret+80) ^ XXH_readLE64(secret+88);
-            h128.low64 = XXH3_avalanche((XXH_PRIME64_1 + seed) ^ bitflipl);
-            h128.high64 = XXH3_avalanche((XXH_PRIME64_2 - seed) ^ bitfliph);
-            return h128;
-    }   }
+    return bufferedSize < XXH_STRIPE_LEN ? XXH_STRIPE_LEN : bufferedSize;
 }
 
+XXH_PUBLIC_API size_t
+XXH3_saveState(void* dst, size_t dstCapacity, const XXH3_state_t* state)
+{
+    xxh_u8* const op = (xxh_u8*)dst;
+    size_t bufferedSize, savedSize, i;
+    if (dst == NULL || state == NULL) return 0;
+    bufferedSize = state->bufferedSize;
+    savedSize = XXH3_SAVEDSTATE_HEADER_SIZE + XXH3_savedWindowSize(bufferedSize);
+    XXH_ASSERT(bufferedSize <= sizeof(state->buffer));
+    if (dstCapacity < savedSize) return 0;
+
+    op[0] = XXH_SAVEDSTATE_XXH3;
+    op[1] = XXH_SAVEDSTATE_VERSION;
+    op[2] = XXH3_savedFlags(state);
+    op[3] = 0;
+    XXH_writeLE32(op + 4, (xxh_u32)bufferedSize);
+    XXH_writeLE32(op + 8, (xxh_u32)state->nbStripesSoFar);
+    XXH_writeLE32(op + 12, (xxh_u32)(state->secretLimit + XXH_STRIPE_LEN));
+    XXH_writeLE64(op + 16, state->totalLen);
+    XXH_writeLE64(op + 24, state->seed);
+    for (i = 0; i < XXH_ACC_NB; i++)
+        XXH_writeLE64(op + 32 + 8*i, state->acc[i]);
+    memcpy(op + XXH3_SAVEDSTATE_HEADER_SIZE, state->buffer, bufferedSize);
+    if (bufferedSize < XXH_STRIPE_LEN) {
+        size_t const catchupSize = XXH_STRIPE_LEN - bufferedSize;
+        memcpy(op + XXH3_SAVEDSTATE_HEADER_SIZE + bufferedSize,
+               state->buffer + sizeof(state->buffer) - catchupSize, catchupSize);
+    }
+    return savedSize;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_loadState(XXH3_state_t* state, const void* src, size_t srcSize,
+               const void* secret, size_t secretSize)
+{
+    const xxh_u8* const ip = (const xxh_u8*)src;
+    if (state == NULL || src == NULL || srcSize < XXH3_SAVEDSTATE_HEADER_SIZE + XXH_STRIPE_LEN) return XXH_ERROR;
+    if (ip[0] != XXH_SAVEDSTATE_XXH3 || ip[1] != XXH_SAVEDSTATE_VERSION || ip[3]) return XXH_ERROR;
+
+    {   size_t const bufferedSize = XXH_readLE32(ip + 4);
+        xxh_u32 const nbStripesSoFar = XXH_readLE32(ip + 8);
+        xxh_u32 const savedSecretSize = XXH_readLE32(ip + 12);
+        xxh_u64 const totalLen = XXH_readLE64(ip + 16);
+        xxh_u64 const seed = XXH_readLE64(ip + 24);
+        size_t i;
+
+        /* validate everything before touching @state */
+        if (bufferedSize > sizeof(state->buffer) || bufferedSize > totalLen) return XXH_ERROR;
+        if (srcSize != XXH3_SAVEDSTATE_HEADER_SIZE + XXH3_savedWindowSize(bufferedSize)) return XXH_ERROR;
+        if (nbStripesSoFar >= XXH3_savedStripesPerBlock(savedSecretSize)) return XXH_ERROR;
+        if (XXH3_restoreSecret(state, ip[2], seed, savedSecretSize, secret, secretSize) != XXH_OK)
+            return XXH_ERROR;
+
+        for (i = 0; i < XXH_ACC_NB; i++)
+            state->acc[i] = XXH_readLE64(ip + 32 + 8*i);
+        memcpy(state->buffer, ip + XXH3_SAVEDSTATE_HEADER_SIZE, bufferedSize);
+        if (bufferedSize < XXH_STRIPE_LEN) {
+            size_t const catchupSize = XXH_STRIPE_LEN - bufferedSize;
+            memcpy(state->buffer + sizeof(state->buffer) - catchupSize,
+                   ip + XXH3_SAVEDSTATE_HEADER_SIZE + bufferedSize, catchupSize);
+        }
+        state->bufferedSize = (XXH32_hash_t)bufferedSize;
+        state->nbStripesSoFar = nbStripesSoFar;
+        state->totalLen = totalLen;
+    }
+    return XXH_OK;
+}
+
+
+/* ===   XXH3 hash partitioning   === */
+
 /*
- * A bit slower than XXH3_mix16B, but handles multiply by zero better.
+ * Building blocks of radix-partitioned hash joins.
+ *
+ * XXH3_64bits_partition() hashes a column of keys and derives the partition
+ * of each key from the top bits of its hash, counting partition sizes on the
+ * way. Keys are hashed in chunks, with the batch kernel for fixed-width keys,
+ * and each chunk of hashes is partitioned while it is still in L1,
+ * instead of being read back from memory by a second pass.
+ *
+ * XXH3_partition_scatter() then writes row ids grouped by partition.
+ * With many partitions, writing each row id straight to its destination
+ * touches one cache line, and often one page, per partition: more than
+ * the L1 cache and the TLB can hold. Instead, row ids are staged in one
+ * cache line buffer per partition (software write-combining), and a buffer
+ * is written out when its destination line is complete, as one aligned
+ * line, with streaming stores when available.
  */
-XXH_FORCE_INLINE XXH128_hash_t
-XXH128_mix32B(XXH128_hash_t acc, const xxh_u8* input_1, const xxh_u8* input_2,
-              const xxh_u8* secret, XXH64_hash_t seed)
+
+/* 256 hashes and partition ids take 3 KB of L1 */
+#define XXH3_PARTITION_CHUNK 256
+
+#define XXH3_SCATTER_LINE (64 / sizeof(xxh_u32))
+
+/* with fewer partitions, destination lines stay in L1, and direct writes are faster */
+#define XXH3_SCATTER_DIRECT_MAX 32
+
+typedef void (*XXH3_f_batch)(XXH64_hash_t*, const void*, size_t, size_t, XXH64_hash_t);
+
+/* top @bits bits of @h, 0 when @bits is 0 */
+XXH_FORCE_INLINE xxh_u32 XXH3_partitionOf(xxh_u64 h, unsigned bits)
 {
-    acc.low64  += XXH3_mix16B (input_1, secret+0, seed);
-    acc.low64  ^= XXH_readLE64(input_2) + XXH_readLE64(input_2 + 8);
-    acc.high64 += XXH3_mix16B (input_2, secret+16, seed);
-    acc.high64 ^= XXH_readLE64(input_1) + XXH_readLE64(input_1 + 8);
-    return acc;
+    XXH_ASSERT(bits <= XXH3_PARTITION_BITS_MAX);
+    return (xxh_u32)((h >> 1) >> (63 - bits));
 }
 
+XXH_FORCE_INLINE void
+XXH3_partition_count(XXH32_hash_t* XXH_RESTRICT partitions, size_t* XXH_RESTRICT histogram,
+                     const XXH64_hash_t* XXH_RESTRICT hashes, size_t nbKeys, unsigned bits)
+{
+    size_t n;
+    for (n = 0; n < nbKeys; n++) {
+        xxh_u32 const p = XXH3_partitionOf(hashes[n], bits);
+        partitions[n] = p;
+        histogram[p]++;
+    }
+}
 
-XXH_FORCE_INLINE XXH128_hash_t
-XXH3_len_17to128_128b(const xxh_u8* XXH_RESTRICT input, size_t len,
-                      const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
-                      XXH64_hash_t seed)
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_64bits_partition_internal(XXH64_hash_t* XXH_RESTRICT hashes, XXH32_hash_t* XXH_RESTRICT partitions,
+                               size_t* XXH_RESTRICT histogram,
+                               const void* XXH_RESTRICT keys, size_t keySize, size_t nbKeys,
+                               XXH64_hash_t seed, unsigned bits, XXH3_f_batch f_batch)
 {
-    XXH_ASSERT(secretSize >= XXH3_SECRET_SIZE_MIN); (void)secretSize;
-    XXH_ASSERT(16 < len && len <= 128);
+    size_t n;
+    if (bits > XXH3_PARTITION_BITS_MAX) return XXH_ERROR;
+    if (nbKeys == 0) return XXH_OK;
+    if (hashes == NULL || partitions == NULL || histogram == NULL) return XXH_ERROR;
+
+    for (n = 0; n < nbKeys; n += XXH3_PARTITION_CHUNK) {
+        size_t const chunkSize = (nbKeys - n < XXH3_PARTITION_CHUNK) ? nbKeys - n : XXH3_PARTITION_CHUNK;
+        /* empty keys may come without a key buffer */
+        const void* const chunk = keySize ? (const xxh_u8*)keys + n*keySize : keys;
+        f_batch(hashes + n, chunk, keySize, chunkSize, seed);
+        XXH3_partition_count(partitions + n, histogram, hashes + n, chunkSize, bits);
+    }
+    return XXH_OK;
+}
 
-    {   XXH128_hash_t acc;
-        acc.low64 = len * XXH_PRIME64_1;
-        acc.high64 = 0;
-        if (len > 32) {
-            if (len > 64) {
-                if (len > 96) {
-                    acc = XXH128_mix32B(acc, input+48, input+len-64, secret+96, seed);
-                }
-                acc = XXH128_mix32B(acc, input+32, input+len-48, secret+64, seed);
-            }
-            acc = XXH128_mix32B(acc, input+16, input+len-32, secret+32, seed);
+XXH_FORCE_INLINE XXH_errorcode
+XXH3_64bits_partition_varlen_internal(XXH64_hash_t* XXH_RESTRICT hashes, XXH32_hash_t* XXH_RESTRICT partitions,
+                                      size_t* XXH_RESTRICT histogram,
+                                      const void* XXH_RESTRICT data, const size_t* XXH_RESTRICT offsets, size_t nbKeys,
+                                      XXH64_hash_t seed, unsigned bits, XXH3_hashLong64_f f_hashLong)
+{
+    size_t n, i;
+    if (bits > XXH3_PARTITION_BITS_MAX) return XXH_ERROR;
+    if (nbKeys == 0) return XXH_OK;
+    if (hashes == NULL || partitions == NULL || histogram == NULL || offsets == NULL) return XXH_ERROR;
+
+    /*
+     * Contiguous keys are read in order, and the hardware prefetcher keeps up:
+     * the prefetching and grouping of XXH3_64bits_gather() would only add overhead.
+     */
+    for (n = 0; n < nbKeys; n += XXH3_PARTITION_CHUNK) {
+        size_t const chunkSize = (nbKeys - n < XXH3_PARTITION_CHUNK) ? nbKeys - n : XXH3_PARTITION_CHUNK;
+        for (i = n; i < n + chunkSize; i++) {
+            XXH_ASSERT(offsets[i+1] >= offsets[i]);
+            hashes[i] = XXH3_64bits_internal((const xxh_u8*)data + offsets[i], offsets[i+1] - offsets[i],
+                                             seed, XXH3_kSecret, sizeof(XXH3_kSecret), f_hashLong);
         }
-        acc = XXH128_mix32B(acc, input, input+len-16, secret, seed);
-        {   XXH128_hash_t h128;
-            h128.low64  = acc.low64 + acc.high64;
-            h128.high64 = (acc.low64    * XXH_PRIME64_1)
-                        + (acc.high64   * XXH_PRIME64_4)
-                        + ((len - seed) * XXH_PRIME64_2);
-            h128.low64  = XXH3_avalanche(h128.low64);
-            h128.high64 = (XXH64_hash_t)0 - XXH3_avalanche(h128.high64);
-            return h128;
+        XXH3_partition_count(partitions + n, histogram, hashes + n, chunkSize, bits);
+    }
+    return XXH_OK;
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_partition(XXH64_hash_t* hashes, XXH32_hash_t* partitions, size_t* histogram,
+                      const void* keys, size_t keySize, size_t nbKeys, unsigned partitionBits)
+{
+    return XXH3_64bits_partition_internal(hashes, partitions, histogram, keys, keySize, nbKeys,
+                                          0, partitionBits, XXH3_64bits_withSeed_batch);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_withSeed_partition(XXH64_hash_t* hashes, XXH32_hash_t* partitions, size_t* histogram,
+                               const void* keys, size_t keySize, size_t nbKeys,
+                               XXH64_hash_t seed, unsigned partitionBits)
+{
+    return XXH3_64bits_partition_internal(hashes, partitions, histogram, keys, keySize, nbKeys,
+                                          seed, partitionBits, XXH3_64bits_withSeed_batch);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_partition_varlen(XXH64_hash_t* hashes, XXH32_hash_t* partitions, size_t* histogram,
+                             const void* data, const size_t* offsets, size_t nbKeys, unsigned partitionBits)
+{
+    return XXH3_64bits_partition_varlen_internal(hashes, partitions, histogram, data, offsets, nbKeys,
+                                                 0, partitionBits, XXH3_hashLong_64b_default);
+}
+
+XXH_PUBLIC_API XXH_errorcode
+XXH3_64bits_withSeed_partition_varlen(XXH64_hash_t* hashes, XXH32_hash_t* partitions, size_t* histogram,
+                                      const void* data, const size_t* offsets, size_t nbKeys,
+                                      XXH64_hash_t seed, unsigned partitionBits)
+{
+    return XXH3_64bits_partition_varlen_internal(hashes, partitions, histogram, data, offsets, nbKeys,
+                                                 seed, partitionBits, XXH3_hashLong_64b_withSeed);
+}
+
+XXH_FORCE_INLINE void
+XXH3_scatter_direct(xxh_u32* XXH_RESTRICT rowIds, size_t* XXH_RESTRICT cursors,
+                    const xxh_u32* XXH_RESTRICT partitions, size_t nbRows, xxh_u32 firstRowId)
+{
+    size_t n;
+    for (n = 0; n < nbRows; n++) {
+        rowIds[cursors[partitions[n]]++] = firstRowId + (xxh_u32)n;
+    }
+}
+
+/* writes a complete, 64-byte aligned, destination line */
+XXH_FORCE_INLINE void
+XXH3_scatter_writeLine(xxh_u32* XXH_RESTRICT dst, const xxh_u32* XXH_RESTRICT line)
+{
+#if XXH3_COPY_NONTEMPORAL
+    __m128i* const xd = (__m128i*)(void*)dst;
+    const __m128i* const xs = (const __m128i*)(const void*)line;
+    _mm_stream_si128(xd + 0, _mm_load_si128(xs + 0));
+    _mm_stream_si128(xd + 1, _mm_load_si128(xs + 1));
+    _mm_stream_si128(xd + 2, _mm_load_si128(xs + 2));
+    _mm_stream_si128(xd + 3, _mm_load_si128(xs + 3));
+#else
+    memcpy(dst, line, 64);
+#endif
+}
+
+/*
+ * Each partition owns one line of @lines, whose slots mirror the destination
+ * line of its cursor. Lines shared with a neighbouring partition, at the
+ * edges of the partition, are written partially, with memcpy().
+ * @starts receives the first position of each partition.
+ */
+XXH_FORCE_INLINE void
+XXH3_scatter_combined(xxh_u32* XXH_RESTRICT rowIds, size_t* XXH_RESTRICT cursors,
+                      const xxh_u32* XXH_RESTRICT partitions, size_t nbRows, xxh_u32 firstRowId,
+                      size_t nbPartitions, xxh_u32* XXH_RESTRICT lines, size_t* XXH_RESTRICT starts)
+{
+    size_t n, p;
+    XXH_ASSERT(((size_t)rowIds & (sizeof(xxh_u32)-1)) == 0);
+    memcpy(starts, cursors, nbPartitions * sizeof(size_t));
+
+    for (n = 0; n < nbRows; n++) {
+        xxh_u32 const part = partitions[n];
+        size_t const pos = cursors[part]++;
+        size_t const slot = ((size_t)(rowIds + pos) / sizeof(xxh_u32)) % XXH3_SCATTER_LINE;
+        xxh_u32* const line = lines + part * XXH3_SCATTER_LINE;
+        line[slot] = firstRowId + (xxh_u32)n;
+        if (slot == XXH3_SCATTER_LINE - 1) {
+            size_t const nbInLine = pos + 1 - starts[part];
+            if (nbInLine >= XXH3_SCATTER_LINE) {
+                XXH3_scatter_writeLine(rowIds + pos + 1 - XXH3_SCATTER_LINE, line);
+            } else {
+                memcpy(rowIds + starts[part], line + XXH3_SCATTER_LINE - nbInLine, nbInLine * sizeof(xxh_u32));
+            }
         }
     }
+
+    /* incomplete last lines */
+    for (p = 0; p < nbPartitions; p++) {
+        size_t const end = cursors[p];
+        size_t const endSlot = ((size_t)(rowIds + end) / sizeof(xxh_u32)) % XXH3_SCATTER_LINE;
+        size_t const nbLeft = (end - starts[p] < endSlot) ? end - starts[p] : endSlot;
+        memcpy(rowIds + end - nbLeft, lines + p * XXH3_SCATTER_LINE + endSlot - nbLeft, nbLeft * sizeof(xxh_u32));
+    }
+    XXH3_copyFence(XXH3_copy_nonTemporal);
 }
 
-XXH_NO_INLINE XXH128_hash_t
-XXH3_len_129to240_128b(const xxh_u8* XXH_RESTRICT input, size_t len,
-                       const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
-                       XXH64_hash_t seed)
+XXH_PUBLIC_API XXH_errorcode
+XXH3_partition_scatter(XXH32_hash_t* rowIds, size_t* cursors,
+                       const XXH32_hash_t* partitions, size_t nbRows,
+                       XXH32_hash_t firstRowId, unsigned partitionBits)
 {
-    XXH_ASSERT(secretSize >= XXH3_SECRET_SIZE_MIN); (void)secretSize;
-    XXH_ASSERT(128 < len && len <= XXH3_MIDSIZE_MAX);
+    if (partitionBits > XXH3_PARTITION_BITS_MAX) return XXH_ERROR;
+    if (nbRows == 0) return XXH_OK;
+    if (rowIds == NULL || cursors == NULL || partitions == NULL) return XXH_ERROR;
+
+    /* staging pays off once most lines get filled */
+    {   size_t const nbPartitions = (size_t)1 << partitionBits;
+        if (nbPartitions > XXH3_SCATTER_DIRECT_MAX && nbRows >= nbPartitions * XXH3_SCATTER_LINE) {
+            xxh_u32* const lines = (xxh_u32*)XXH_alignedMalloc(nbPartitions * (64 + sizeof(size_t)), 64);
+            if (lines != NULL) {
+                XXH3_scatter_combined(rowIds, cursors, partitions, nbRows, firstRowId, nbPartitions,
+                                      lines, (size_t*)(void*)(lines + nbPartitions * XXH3_SCATTER_LINE));
+                XXH_alignedFree(lines);
+                return XXH_OK;
+    }   }   }
+    XXH3_scatter_direct(rowIds, cursors, partitions, nbRows, firstRowId);
+    return XXH_OK;
+}
 
-    {   XXH128_hash_t acc;
-        int const nbRounds = (int)len / 32;
-        int i;
-        acc.low64 = len * XXH_PRIME64_1;
-        acc.high64 = 0;
-        for (i=0; i<4; i++) {
-            acc = XXH128_mix32B(acc,
-                                input  + (32 * i),
-                                input  + (32 * i) + 16,
-                                secret + (32 * i),
-                                seed);
+
+/* ===   XXH3 columnar hashing   === */
+
+/*
+ * Columns of variable-length values, as laid out by Apache Arrow:
+ * one offsets array, one contiguous data buffer, and a validity bitmap.
+ *
+ * Rows are hashed in micro-batches. Each micro-batch is first sorted by
+ * length class, then each class runs its XXH3_len_* kernel in a tight loop.
+ * With mixed lengths, the length dispatch of XXH3_64bits_internal() would
+ * mispredict on most rows. Micro-batches of a single class, as found in
+ * columns of fixed-size values, skip the sort.
+ *
+ * Row hashes of several columns are chained: the hash of a row in one column
+ * seeds the same row in the next column, which is why seeds are per row.
+ *
+ * Offsets are either size_t or 32-bit, as in Arrow's default layouts.
+ * Their width is a constant in each entry point.
+ */
+
+/* row indexes within a micro-batch fit in a byte */
+#define XXH3_COLUMN_GROUP 64
+#define XXH3_COLUMN_CLASSES 11
+/* micro-batches of longer rows, on average, are hashed in order */
+#define XXH3_COLUMN_SORT_MAXLEN 32
+
+/*
+ * 0 is null, then empty, 1-3, 4-8, 9-16, 17-32, 33-64, 65-96, 97-128, 129-240 and long.
+ * 17-128 is split along the branches of XXH3_len_17to128_64b(),
+ * so that they are always predicted within a class.
+ * Looked up in a table: sorting mixed lengths must not mispredict either.
+ */
+static const xxh_u8 XXH3_kColumnClass[256] = {
+     1,  2,  2,  2,  3,  3,  3,  3,  3,  4,  4,  4,  4,  4,  4,  4,   /*   0 to  15 */
+     4,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,   /*  16 to  31 */
+     5,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,   /*  32 to  47 */
+     6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,   /*  48 to  63 */
+     6,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,   /*  64 to  79 */
+     7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,   /*  80 to  95 */
+     7,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,   /*  96 to 111 */
+     8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,  8,   /* 112 to 127 */
+     8,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,   /* 128 to 143 */
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,   /* 144 to 159 */
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,   /* 160 to 175 */
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,   /* 176 to 191 */
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,   /* 192 to 207 */
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,   /* 208 to 223 */
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,   /* 224 to 239 */
+     9, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10    /* 240 to 255 */
+};
+
+XXH_FORCE_INLINE size_t XXH3_column_lenClass(size_t len)
+{
+    return XXH3_kColumnClass[(len < 255) ? len : 255];
+}
+
+/* @offsetSize is 4 or sizeof(size_t) */
+XXH_FORCE_INLINE size_t
+XXH3_column_offset(const void* offsets, size_t offsetSize, size_t n)
+{
+    if (offsetSize == 4) return ((const xxh_u32*)offsets)[n];
+    return ((const size_t*)offsets)[n];
+}
+
+/* @lenClass is a constant, each call inlines a single kernel. NULL @rows are in order. */
+XXH_FORCE_INLINE void
+XXH3_column_hashClass(XXH64_hash_t* dst, const xxh_u8* XXH_RESTRICT data,
+                      const void* XXH_RESTRICT offsets, size_t offsetSize,
+                      const XXH64_hash_t* seeds, XXH64_hash_t seed,
+                      const unsigned char* rows, size_t nbRows, size_t lenClass, XXH3_hashLong64_f f_hashLong)
+{
+    size_t i;
+    for (i = 0; i < nbRows; i++) {
+        size_t const k = (rows != NULL) ? rows[i] : i;
+        XXH64_hash_t const s = (seeds != NULL) ? seeds[k] : seed;
+        size_t const start = XXH3_column_offset(offsets, offsetSize, k);
+        const xxh_u8* const input = data + start;
+        size_t const len = XXH3_column_offset(offsets, offsetSize, k+1) - start;
+        switch (lenClass) {
+        case 0:  dst[k] = ~XXH3_len_0to16_64b(NULL, 0, XXH3_kSecret, s); break;   /* null */
+        case 1:  dst[k] = XXH3_len_0to16_64b(NULL, 0, XXH3_kSecret, s); break;
+        case 2:  dst[k] = XXH3_len_1to3_64b(input, len, XXH3_kSecret, s); break;
+        case 3:  dst[k] = XXH3_len_4to8_64b(input, len, XXH3_kSecret, s); break;
+        case 4:  dst[k] = XXH3_len_9to16_64b(input, len, XXH3_kSecret, s); break;
+        case 5: case 6: case 7: case 8:
+                 dst[k] = XXH3_len_17to128_64b(input, len, XXH3_kSecret, sizeof(XXH3_kSecret), s); break;
+        case 9:  dst[k] = XXH3_len_129to240_64b(input, len, XXH3_kSecret, sizeof(XXH3_kSecret), s); break;
+        default: dst[k] = f_hashLong(input, len, s, XXH3_kSecret, sizeof(XXH3_kSecret)); break;
         }
-        acc.low64 = XXH3_avalanche(acc.low64);
-        acc.high64 = XXH3_avalanche(acc.high64);
-        XXH_ASSERT(nbRounds >= 4);
-        for (i=4 ; i < nbRounds; i++) {
-            acc = XXH128_mix32B(acc,
-                                input + (32 * i),
-                                input + (32 * i) + 16,
-                                secret + XXH3_MIDSIZE_STARTOFFSET + (32 * (i - 4)),
-                                seed);
+    }
+}
+
+/* @seeds, when not NULL, may be @dst */
+XXH_FORCE_INLINE void
+XXH3_64bits_column_internal(XXH64_hash_t* dst, const void* data,
+                            const void* XXH_RESTRICT offsets, size_t offsetSize,
+                            const unsigned char* XXH_RESTRICT validity,
+                            const XXH64_hash_t* seeds, XXH64_hash_t seed, size_t nbRows,
+                            XXH3_hashLong64_f f_hashLong)
+{
+    size_t n, i;
+    if (nbRows == 0) return;
+    XXH_ASSERT(dst != NULL && offsets != NULL);
+
+    for (n = 0; n < nbRows; n += XXH3_COLUMN_GROUP) {
+        size_t const groupSize = (nbRows - n < XXH3_COLUMN_GROUP) ? nbRows - n : XXH3_COLUMN_GROUP;
+        unsigned char classes[XXH3_COLUMN_GROUP];
+        unsigned char byClass[XXH3_COLUMN_CLASSES][XXH3_COLUMN_GROUP];
+        size_t nbInClass[XXH3_COLUMN_CLASSES] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        unsigned classMask = 0;
+        size_t lastClass = 0;
+        XXH64_hash_t* const groupDst = dst + n;
+        const XXH64_hash_t* const groupSeeds = (seeds != NULL) ? seeds + n : NULL;
+        const void* const groupOffsets = (const xxh_u8*)offsets + n * offsetSize;
+        const xxh_u8* const input = (const xxh_u8*)data;
+
+        if ( XXH3_column_offset(offsets, offsetSize, n + groupSize) - XXH3_column_offset(offsets, offsetSize, n)
+           > XXH3_COLUMN_SORT_MAXLEN * groupSize) {
+            /* longer rows: a misprediction costs less than sorting them */
+            for (i = 0; i < groupSize; i++) {
+                size_t const row = n + i;
+                XXH64_hash_t const s = (groupSeeds != NULL) ? groupSeeds[i] : seed;
+                if ((validity != NULL) && !((validity[row >> 3] >> (row & 7)) & 1)) {
+                    groupDst[i] = ~XXH3_len_0to16_64b(NULL, 0, XXH3_kSecret, s);
+                } else {
+                    size_t const start = XXH3_column_offset(offsets, offsetSize, row);
+                    groupDst[i] = XXH3_64bits_internal(input + start, XXH3_column_offset(offsets, offsetSize, row+1) - start,
+                                                       s, XXH3_kSecret, sizeof(XXH3_kSecret), f_hashLong);
+            }   }
+            continue;
         }
-        /* last bytes */
-        acc = XXH128_mix32B(acc,
-                            input + len - 16,
-                            input + len - 32,
-                            secret + XXH3_SECRET_SIZE_MIN - XXH3_MIDSIZE_LASTOFFSET - 16,
-                            0ULL - seed);
 
-        {   XXH128_hash_t h128;
-            h128.low64  = acc.low64 + acc.high64;
-            h128.high64 = (acc.low64    * XXH_PRIME64_1)
-                        + (acc.high64   * XXH_PRIME64_4)
-                        + ((len - seed) * XXH_PRIME64_2);
-            h128.low64  = XXH3_avalanche(h128.low64);
-            h128.high64 = (XXH64_hash_t)0 - XXH3_avalanche(h128.high64);
-            return h128;
+        for (i = 0; i < groupSize; i++) {
+            size_t const row = n + i;
+            int const isNull = (validity != NULL) && !((validity[row >> 3] >> (row & 7)) & 1);
+            size_t const start = XXH3_column_offset(offsets, offsetSize, row);
+            size_t const end = XXH3_column_offset(offsets, offsetSize, row+1);
+            size_t const lenClass = isNull ? 0 : XXH3_column_lenClass(end - start);
+            XXH_ASSERT(isNull || end >= start);
+            classes[i] = (unsigned char)lenClass;
+            classMask |= 1U << lenClass;
+            lastClass = lenClass;
+        }
+
+#define XXH3_COLUMN_HASH(c) \
+        XXH3_column_hashClass(groupDst, input, groupOffsets, offsetSize, groupSeeds, seed, byClass[c], nbInClass[c], c, f_hashLong)
+#define XXH3_COLUMN_HASH_ALL(c) \
+        XXH3_column_hashClass(groupDst, input, groupOffsets, offsetSize, groupSeeds, seed, NULL, groupSize, c, f_hashLong)
+
+        if ((classMask & (classMask - 1)) == 0) {
+            /* a single class: rows in order */
+            switch (lastClass) {
+            case 0:  XXH3_COLUMN_HASH_ALL(0); break;
+            case 1:  XXH3_COLUMN_HASH_ALL(1); break;
+            case 2:  XXH3_COLUMN_HASH_ALL(2); break;
+            case 3:  XXH3_COLUMN_HASH_ALL(3); break;
+            case 4:  XXH3_COLUMN_HASH_ALL(4); break;
+            case 5:  XXH3_COLUMN_HASH_ALL(5); break;
+            case 6:  XXH3_COLUMN_HASH_ALL(6); break;
+            case 7:  XXH3_COLUMN_HASH_ALL(7); break;
+            case 8:  XXH3_COLUMN_HASH_ALL(8); break;
+            case 9:  XXH3_COLUMN_HASH_ALL(9); break;
+            default: XXH3_COLUMN_HASH_ALL(10); break;
+            }
+            continue;
         }
+        for (i = 0; i < groupSize; i++) byClass[classes[i]][nbInClass[classes[i]]++] = (unsigned char)i;
+        if (classMask & (1U << 0)) XXH3_COLUMN_HASH(0);
+        if (classMask & (1U << 1)) XXH3_COLUMN_HASH(1);
+        if (classMask & (1U << 2)) XXH3_COLUMN_HASH(2);
+        if (classMask & (1U << 3)) XXH3_COLUMN_HASH(3);
+        if (classMask & (1U << 4)) XXH3_COLUMN_HASH(4);
+        if (classMask & (1U << 5)) XXH3_COLUMN_HASH(5);
+        if (classMask & (1U << 6)) XXH3_COLUMN_HASH(6);
+        if (classMask & (1U << 7)) XXH3_COLUMN_HASH(7);
+        if (classMask & (1U << 8)) XXH3_COLUMN_HASH(8);
+        if (classMask & (1U << 9)) XXH3_COLUMN_HASH(9);
+        if (classMask & (1U << 10)) XXH3_COLUMN_HASH(10);
+#undef XXH3_COLUMN_HASH_ALL
+#undef XXH3_COLUMN_HASH
     }
 }
 
-XXH_FORCE_INLINE XXH128_hash_t
-XXH3_hashLong_128b_internal(const xxh_u8* XXH_RESTRICT input, size_t len,
-                            const xxh_u8* XXH_RESTRICT secret, size_t secretSize,
-                            XXH3_f_accumulate_512 f_acc512,
-                            XXH3_f_scrambleAcc f_scramble)
+XXH_FORCE_INLINE void
+XXH3_64bits_columns_internal(XXH64_hash_t* dst, const XXH3_column_t* columns, size_t nbColumns,
+                             size_t nbRows, XXH64_hash_t seed, XXH3_hashLong64_f f_hashLong)
+{
+    size_t c, n;
+    if (nbColumns == 0) {
+        for (n = 0; n < nbRows; n++) dst[n] = seed;
+        return;
+    }
+    XXH_ASSERT(columns != NULL);
+    for (c = 0; c < nbColumns; c++) {
+        /* the first column is seeded with @seed, the next ones with the row hashes */
+        const XXH64_hash_t* const seeds = (c == 0) ? NULL : dst;
+        XXH64_hash_t const columnSeed = (c == 0) ? seed : 0;
+        XXH_ASSERT(columns[c].offsetSize == 4 || columns[c].offsetSize == sizeof(size_t));
+        if (columns[c].offsetSize == 4) {
+            XXH3_64bits_column_internal(dst, columns[c].data, columns[c].offsets, 4, columns[c].validity,
+                                        seeds, columnSeed, nbRows, f_hashLong);
+        } else {
+            XXH3_64bits_column_internal(dst, columns[c].data, columns[c].offsets, sizeof(size_t), columns[c].validity,
+                                        seeds, columnSeed, nbRows, f_hashLong);
+    }   }
+}
+
+XXH_PUBLIC_API void
+XXH3_64bits_column(XXH64_hash_t* dst, const void* data, const size_t* offsets,
+                   const unsigned char* validity, const XXH64_hash_t* seeds, size_t nbRows)
+{
+    XXH3_64bits_column_internal(dst, data, offsets, sizeof(size_t), validity, seeds, 0, nbRows, XXH3_hashLong_64b_withSeed);
+}
+
+XXH_PUBLIC_API void
+XXH3_64bits_column32(XXH64_hash_t* dst, const void* data, const XXH32_hash_t* offsets,
+                     const unsigned char* validity, const XXH64_hash_t* seeds, size_t nbRows)
+{
+    XXH3_64bits_column_internal(dst, data, offsets, 4, validity, seeds, 0, nbRows, XXH3_hashLong_64b_withSeed);
+}
+
+XXH_PUBLIC_API void
+XXH3_64bits_columns(XXH64_hash_t* dst, const XXH3_column_t* columns, size_t nbColumns,
+                    size_t nbRows, XXH64_hash_t seed)
+{
+    XXH3_64bits_columns_internal(dst, columns, nbColumns, nbRows, seed, XXH3_hashLong_64b_withSeed);
+}
+
+
+/* ===   XXH3 integer hashing   === */
+
+/*
+ * Fixed-size integer keys.
+ *
+ * Hashing an integer key with XXH3_64bits(&key, sizeof(key)) goes through the
+ * length dispatch of XXH3_len_0to16_64b(), and reads the key back from memory,
+ * although its length is known at compile time and it already sits in a register.
+ * The functions below build the input words of the 4-8 and 9-16 byte paths
+ * directly from the key instead:
+ * - 4 bytes: both 32-bit reads of XXH3_len_4to8_64b() return the key,
+ * - 8 bytes: the two 32-bit halves of the key, swapped,
+ * - 16 bytes: the low and high 64-bit halves, for XXH3_len_9to16_64b().
+ * This leaves the mixing code only, constant-folded with the default secret.
+ *
+ * Arrays of keys are contiguous, so unlike XXH3 batch hashing there is no
+ * gather: the lane kernels load 8 keys with full-width loads.
+ * The 4-8 byte path only multiplies by a constant, which SSE2 and AVX2
+ * emulate with 3 PMULUDQ, so AVX2 hashes 32 and 64-bit keys 4 at a time.
+ * The 9-16 byte path needs a full 64x64->128 multiply, so 128-bit keys
+ * use the scalar kernel below AVX512, like XXH3 batch hashing.
+ */
+
+/* the input word of XXH3_len_4to8_64b() for the 4 little-endian bytes of @key */
+XXH_FORCE_INLINE xxh_u64 XXH3_int_input32(xxh_u32 key)
+{
+    return key + ((xxh_u64)key << 32);
+}
+
+/* the input word of XXH3_len_4to8_64b() for the 8 little-endian bytes of @key */
+XXH_FORCE_INLINE xxh_u64 XXH3_int_input64(xxh_u64 key)
 {
-    XXH_ALIGN(XXH_ACC_ALIGN) xxh_u64 acc[XXH_ACC_NB] = XXH3_INIT_ACC;
+    return XXH_rotl64(key, 32);
+}
 
-    XXH3_hashLong_internal_loop(acc, input, len, secret, secretSize, XXH3_acc_128bits, f_acc512, f_scramble);
+XXH_FORCE_INLINE XXH64_hash_t
+XXH3_hash_u32_internal(xxh_u32 key, XXH64_hash_t seed)
+{
+    return XXH3_mix4to8_64b(XXH3_int_input32(key), 4, XXH3_kSecret, seed);
+}
 
-    /* converge into final hash */
-    XXH_STATIC_ASSERT(sizeof(acc) == 64);
-    XXH_ASSERT(secretSize >= sizeof(acc) + XXH_SECRET_MERGEACCS_START);
-    {   XXH128_hash_t h128;
-        h128.low64  = XXH3_mergeAccs(acc,
-                                     secret + XXH_SECRET_MERGEACCS_START,
-                                     (xxh_u64)len * XXH_PRIME64_1);
-        h128.high64 = XXH3_mergeAccs(acc,
-                                     secret + secretSize
-                                            - sizeof(acc) - XXH_SECRET_MERGEACCS_START,
-                                     ~((xxh_u64)len * XXH_PRIME64_2));
-        return h128;
-    }
+XXH_FORCE_INLINE XXH64_hash_t
+XXH3_hash_u64_internal(xxh_u64 key, XXH64_hash_t seed)
+{
+    return XXH3_mix4to8_64b(XXH3_int_input64(key), 8, XXH3_kSecret, seed);
 }
 
-/*
- * It's important for performance that XXH3_hashLong is not inlined.
- */
-XXH_NO_INLINE XXH128_hash_t
-XXH3_hashLong_128b_default(const xxh_u8* XXH_RESTRICT input, size_t len,
-                           XXH64_hash_t seed64,
-                           const xxh_u8* XXH_RESTRICT secret, size_t secretLen)
+XXH_FORCE_INLINE XXH64_hash_t
+XXH3_hash_u128_internal(XXH128_hash_t key, XXH64_hash_t seed)
 {
-    (void)seed64; (void)secret; (void)secretLen;
-    return XXH3_hashLong_128b_internal(input, len, XXH3_kSecret, sizeof(XXH3_kSecret),
-                                       XXH3_accumulate_512, XXH3_scrambleAcc);
+    return XXH3_mix9to16_64b(key.low64, key.high64, 16, XXH3_kSecret, seed);
 }
 
-/*
- * It's important for performance that XXH3_hashLong is not inlined.
- */
-XXH_NO_INLINE XXH128_hash_t
-XXH3_hashLong_128b_withSecret(const xxh_u8* XXH_RESTRICT input, size_t len,
-                              XXH64_hash_t seed64,
-                              const xxh_u8* XXH_RESTRICT secret, size_t secretLen)
+XXH_PUBLIC_API XXH64_hash_t XXH3_hash_u32(XXH32_hash_t key)
 {
-    (void)seed64;
-    return XXH3_hashLong_128b_internal(input, len, secret, secretLen,
-                                       XXH3_accumulate_512, XXH3_scrambleAcc);
+    return XXH3_hash_u32_internal(key, 0);
 }
 
-XXH_FORCE_INLINE XXH128_hash_t
-XXH3_hashLong_128b_withSeed_internal(const xxh_u8* XXH_RESTRICT input, size_t len,
-                                XXH64_hash_t seed64,
-                                XXH3_f_accumulate_512 f_acc512,
-                                XXH3_f_scrambleAcc f_scramble,
-                                XXH3_f_initCustomSecret f_initSec)
+XXH_PUBLIC_API XXH64_hash_t XXH3_hash_u32_withSeed(XXH32_hash_t key, XXH64_hash_t seed)
 {
-    if (seed64 == 0)
-        return XXH3_hashLong_128b_internal(input, len,
-                                           XXH3_kSecret, sizeof(XXH3_kSecret),
-                                           f_acc512, f_scramble);
-    {   XXH_ALIGN(XXH_SEC_ALIGN) xxh_u8 secret[XXH_SECRET_DEFAULT_SIZE];
-        f_initSec(secret, seed64);
-        return XXH3_hashLong_128b_internal(input, len, secret, sizeof(secret),
-                                           f_acc512, f_scramble);
-    }
+    return XXH3_hash_u32_internal(key, seed);
 }
 
-/*
- * It's important for performance that XXH3_hashLong is not inlined.
- */
-XXH_NO_INLINE XXH128_hash_t
-XXH3_hashLong_128b_withSeed(const xxh_u8* input, size_t len,
-                            XXH64_hash_t seed64, const xxh_u8* XXH_RESTRICT secret, size_t secretLen)
+XXH_PUBLIC_API XXH64_hash_t XXH3_hash_u64(XXH64_hash_t key)
 {
-    (void)secret; (void)secretLen;
-    return XXH3_hashLong_128b_withSeed_internal(input, len, seed64,
-                XXH3_accumulate_512, XXH3_scrambleAcc, XXH3_initCustomSecret);
+    return XXH3_hash_u64_internal(key, 0);
 }
 
-typedef XXH128_hash_t (*XXH3_hashLong128_f)(const xxh_u8* XXH_RESTRICT, size_t,
-                                            XXH64_hash_t, const xxh_u8* XXH_RESTRICT, size_t);
+XXH_PUBLIC_API XXH64_hash_t XXH3_hash_u64_withSeed(XXH64_hash_t key, XXH64_hash_t seed)
+{
+    return XXH3_hash_u64_internal(key, seed);
+}
 
-XXH_FORCE_INLINE XXH128_hash_t
-XXH3_128bits_internal(const void* input, size_t len,
-                      XXH64_hash_t seed64, const xxh_u8* XXH_RESTRICT secret, size_t secretLen,
-                      XXH3_hashLong128_f f_hl128)
+XXH_PUBLIC_API XXH64_hash_t XXH3_hash_u128(XXH128_hash_t key)
 {
-    XXH_ASSERT(secretLen >= XXH3_SECRET_SIZE_MIN);
-    /*
-     * If an action is to be taken if `secret` conditions are not respected,
-     * it should be done here.
-     * For now, it's a contract pre-condition.
-     * Adding a check and a branch here would cost performance at every hash.
-     */
-    if (len <= 16)
-        return XXH3_len_0to16_128b((const xxh_u8*)input, len, secret, seed64);
-    if (len <= 128)
-        return XXH3_len_17to128_128b((const xxh_u8*)input, len, secret, secretLen, seed64);
-    if (len <= XXH3_MIDSIZE_MAX)
-        return XXH3_len_129to240_128b((const xxh_u8*)input, len, secret, secretLen, seed64);
-    return f_hl128((const xxh_u8*)input, len, seed64, secret, secretLen);
+    return XXH3_hash_u128_internal(key, 0);
 }
 
+XXH_PUBLIC_API XXH64_hash_t XXH3_hash_u128_withSeed(XXH128_hash_t key, XXH64_hash_t seed)
+{
+    return XXH3_hash_u128_internal(key, seed);
+}
 
-/* ===   Public XXH128 API   === */
+#define XXH3_INT_LANES 8
 
-XXH_PUBLIC_API XXH128_hash_t XXH3_128bits(const void* input, size_t len)
+#if (XXH_VECTOR == XXH_AVX512) || defined(XXH_X86DISPATCH)
+
+XXH_FORCE_INLINE XXH_TARGET_AVX512 void
+XXH3_hash_u32_x8_avx512(xxh_u64* XXH_RESTRICT dst, const xxh_u32* XXH_RESTRICT keys, xxh_u64 seed)
 {
-    return XXH3_128bits_internal(input, len, 0,
-                                 XXH3_kSecret, sizeof(XXH3_kSecret),
-                                 XXH3_hashLong_128b_default);
+    __m512i const k = _mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i*)keys));
+    __m512i const input64 = _mm512_or_si512(k, _mm512_slli_epi64(k, 32));
+    _mm512_storeu_si512(dst, XXH3_lanes_mix4to8_avx512(input64, 4, XXH3_kSecret, _mm512_set1_epi64((xxh_i64)seed)));
 }
 
-XXH_PUBLIC_API XXH128_hash_t
-XXH3_128bits_withSecret(const void* input, size_t len, const void* secret, size_t secretSize)
+XXH_FORCE_INLINE XXH_TARGET_AVX512 void
+XXH3_hash_u64_x8_avx512(xxh_u64* XXH_RESTRICT dst, const xxh_u64* XXH_RESTRICT keys, xxh_u64 seed)
 {
-    return XXH3_128bits_internal(input, len, 0,
-                                 (const xxh_u8*)secret, secretSize,
-                                 XXH3_hashLong_128b_withSecret);
+    __m512i const input64 = _mm512_rol_epi64(_mm512_loadu_si512(keys), 32);
+    _mm512_storeu_si512(dst, XXH3_lanes_mix4to8_avx512(input64, 8, XXH3_kSecret, _mm512_set1_epi64((xxh_i64)seed)));
 }
 
-XXH_PUBLIC_API XXH128_hash_t
-XXH3_128bits_withSeed(const void* input, size_t len, XXH64_hash_t seed)
+XXH_FORCE_INLINE XXH_TARGET_AVX512 void
+XXH3_hash_u128_x8_avx512(xxh_u64* XXH_RESTRICT dst, const XXH128_hash_t* XXH_RESTRICT keys, xxh_u64 seed)
 {
-    return XXH3_128bits_internal(input, len, seed,
-                                 XXH3_kSecret, sizeof(XXH3_kSecret),
-                                 XXH3_hashLong_128b_withSeed);
+    /* keys are { low64, high64 } pairs: split them into a vector of each */
+    __m512i const even = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+    __m512i const odd  = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+    __m512i const k0 = _mm512_loadu_si512(keys);
+    __m512i const k1 = _mm512_loadu_si512(keys + 4);
+    __m512i const input_lo = _mm512_permutex2var_epi64(k0, even, k1);
+    __m512i const input_hi = _mm512_permutex2var_epi64(k0, odd, k1);
+    _mm512_storeu_si512(dst, XXH3_lanes_mix9to16_avx512(input_lo, input_hi, 16, XXH3_kSecret, _mm512_set1_epi64((xxh_i64)seed)));
 }
 
-XXH_PUBLIC_API XXH128_hash_t
-XXH128(const void* input, size_t len, XXH64_hash_t seed)
+#endif
+
+#if (XXH_VECTOR == XXH_AVX2) || defined(XXH_X86DISPATCH)
+
+/* x * prime, modulo 2^64 */
+XXH_FORCE_INLINE XXH_TARGET_AVX2 __m256i
+XXH3_int_mult64_avx2(__m256i x, xxh_u64 prime)
 {
-    return XXH3_128bits_withSeed(input, len, seed);
+    __m256i const prime_lo = _mm256_set1_epi64x((xxh_i64)prime);
+    __m256i const prime_hi = _mm256_set1_epi64x((xxh_i64)(prime >> 32));
+    __m256i const lo  = _mm256_mul_epu32(x, prime_lo);
+    __m256i const mid = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), prime_lo), _mm256_mul_epu32(x, prime_hi));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(mid, 32));
 }
 
+/* XXH3_mix4to8_64b() of 4 input words, @bitflip being the keyed secret */
+XXH_FORCE_INLINE XXH_TARGET_AVX2 __m256i
+XXH3_int_mix4to8_avx2(__m256i input64, size_t len, __m256i bitflip)
+{
+    __m256i x = _mm256_xor_si256(input64, bitflip);
+    __m256i const rot49 = _mm256_or_si256(_mm256_slli_epi64(x, 49), _mm256_srli_epi64(x, 15));
+    __m256i const rot24 = _mm256_or_si256(_mm256_slli_epi64(x, 24), _mm256_srli_epi64(x, 40));
+    x = _mm256_xor_si256(x, _mm256_xor_si256(rot49, rot24));
+    x = XXH3_int_mult64_avx2(x, 0x9FB21C651E98DF25ULL);
+    x = _mm256_xor_si256(x, _mm256_add_epi64(_mm256_srli_epi64(x, 35), _mm256_set1_epi64x((xxh_i64)len)));
+    x = XXH3_int_mult64_avx2(x, 0x9FB21C651E98DF25ULL);
+    return _mm256_xor_si256(x, _mm256_srli_epi64(x, 28));
+}
 
-/* ===   XXH3 128-bit streaming   === */
+XXH_FORCE_INLINE XXH_TARGET_AVX2 __m256i
+XXH3_int_bitflip4to8_avx2(xxh_u64 seed)
+{
+    seed ^= (xxh_u64)XXH_swap32((xxh_u32)seed) << 32;
+    return _mm256_set1_epi64x((xxh_i64)((XXH_readLE64(XXH3_kSecret+8) ^ XXH_readLE64(XXH3_kSecret+16)) - seed));
+}
 
-/*
- * All the functions are actually the same as for 64-bit streaming variant.
- * The only difference is the finalizatiom routine.
- */
+XXH_FORCE_INLINE XXH_TARGET_AVX2 void
+XXH3_hash_u32_x8_avx2(xxh_u64* XXH_RESTRICT dst, const xxh_u32* XXH_RESTRICT keys, xxh_u64 seed)
+{
+    __m256i const bitflip = XXH3_int_bitflip4to8_avx2(seed);
+    __m256i const k0 = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)keys));
+    __m256i const k1 = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)(keys + 4)));
+    _mm256_storeu_si256((__m256i*)dst,       XXH3_int_mix4to8_avx2(_mm256_or_si256(k0, _mm256_slli_epi64(k0, 32)), 4, bitflip));
+    _mm256_storeu_si256((__m256i*)(dst + 4), XXH3_int_mix4to8_avx2(_mm256_or_si256(k1, _mm256_slli_epi64(k1, 32)), 4, bitflip));
+}
 
-static void
-XXH3_128bits_reset_internal(XXH3_state_t* statePtr,
-                            XXH64_hash_t seed,
-                            const xxh_u8* secret, size_t secretSize)
+XXH_FORCE_INLINE XXH_TARGET_AVX2 void
+XXH3_hash_u64_x8_avx2(xxh_u64* XXH_RESTRICT dst, const xxh_u64* XXH_RESTRICT keys, xxh_u64 seed)
 {
-    XXH3_64bits_reset_internal(statePtr, seed, secret, secretSize);
+    __m256i const bitflip = XXH3_int_bitflip4to8_avx2(seed);
+    __m256i const k0 = _mm256_loadu_si256((const __m256i*)keys);
+    __m256i const k1 = _mm256_loadu_si256((const __m256i*)(keys + 4));
+    /* rotate by 32: swap the halves of each 64-bit lane */
+    __m256i const input0 = _mm256_shuffle_epi32(k0, _MM_SHUFFLE(2, 3, 0, 1));
+    __m256i const input1 = _mm256_shuffle_epi32(k1, _MM_SHUFFLE(2, 3, 0, 1));
+    _mm256_storeu_si256((__m256i*)dst,       XXH3_int_mix4to8_avx2(input0, 8, bitflip));
+    _mm256_storeu_si256((__m256i*)(dst + 4), XXH3_int_mix4to8_avx2(input1, 8, bitflip));
 }
 
-XXH_PUBLIC_API XXH_errorcode
-XXH3_128bits_reset(XXH3_state_t* statePtr)
+#endif
+
+/* scalar variants - universal */
+
+XXH_FORCE_INLINE void
+XXH3_hash_u32_x8_scalar(xxh_u64* XXH_RESTRICT dst, const xxh_u32* XXH_RESTRICT keys, xxh_u64 seed)
 {
-    if (statePtr == NULL) return XXH_ERROR;
-    XXH3_128bits_reset_internal(statePtr, 0, XXH3_kSecret, XXH_SECRET_DEFAULT_SIZE);
-    return XXH_OK;
+    size_t i;
+    for (i = 0; i < XXH3_INT_LANES; i++) dst[i] = XXH3_hash_u32_internal(keys[i], seed);
 }
 
-XXH_PUBLIC_API XXH_errorcode
-XXH3_128bits_reset_withSecret(XXH3_state_t* statePtr, const void* secret, size_t secretSize)
+XXH_FORCE_INLINE void
+XXH3_hash_u64_x8_scalar(xxh_u64* XXH_RESTRICT dst, const xxh_u64* XXH_RESTRICT keys, xxh_u64 seed)
 {
-    if (statePtr == NULL) return XXH_ERROR;
-    XXH3_128bits_reset_internal(statePtr, 0, (const xxh_u8*)secret, secretSize);
-    if (secret == NULL) return XXH_ERROR;
-    if (secretSize < XXH3_SECRET_SIZE_MIN) return XXH_ERROR;
-    return XXH_OK;
+    size_t i;
+    for (i = 0; i < XXH3_INT_LANES; i++) dst[i] = XXH3_hash_u64_internal(keys[i], seed);
 }
 
-XXH_PUBLIC_API XXH_errorcode
-XXH3_128bits_reset_withSeed(XXH3_state_t* statePtr, XXH64_hash_t seed)
+XXH_FORCE_INLINE void
+XXH3_hash_u128_x8_scalar(xxh_u64* XXH_RESTRICT dst, const XXH128_hash_t* XXH_RESTRICT keys, xxh_u64 seed)
 {
-    if (statePtr == NULL) return XXH_ERROR;
-    XXH3_128bits_reset_internal(statePtr, seed, XXH3_kSecret, XXH_SECRET_DEFAULT_SIZE);
-    XXH3_initCustomSecret(statePtr->customSecret, seed);
-    statePtr->extSecret = NULL;
-    return XXH_OK;
+    size_t i;
+    for (i = 0; i < XXH3_INT_LANES; i++) dst[i] = XXH3_hash_u128_internal(keys[i], seed);
 }
 
-XXH_PUBLIC_API XXH_errorcode
-XXH3_128bits_update(XXH3_state_t* state, const void* input, size_t len)
+typedef void (*XXH3_f_hash_u32_x8)(xxh_u64* XXH_RESTRICT, const xxh_u32* XXH_RESTRICT, xxh_u64);
+typedef void (*XXH3_f_hash_u64_x8)(xxh_u64* XXH_RESTRICT, const xxh_u64* XXH_RESTRICT, xxh_u64);
+typedef void (*XXH3_f_hash_u128_x8)(xxh_u64* XXH_RESTRICT, const XXH128_hash_t* XXH_RESTRICT, xxh_u64);
+
+#if (XXH_VECTOR == XXH_AVX512)
+#  define XXH3_hash_u32_x8 XXH3_hash_u32_x8_avx512
+#  define XXH3_hash_u64_x8 XXH3_hash_u64_x8_avx512
+#  define XXH3_hash_u128_x8 XXH3_hash_u128_x8_avx512
+#elif (XXH_VECTOR == XXH_AVX2)
+#  define XXH3_hash_u32_x8 XXH3_hash_u32_x8_avx2
+#  define XXH3_hash_u64_x8 XXH3_hash_u64_x8_avx2
+#  define XXH3_hash_u128_x8 XXH3_hash_u128_x8_scalar
+#else
+#  define XXH3_hash_u32_x8 XXH3_hash_u32_x8_scalar
+#  define XXH3_hash_u64_x8 XXH3_hash_u64_x8_scalar
+#  define XXH3_hash_u128_x8 XXH3_hash_u128_x8_scalar
+#endif
+
+/* 8 keys at a time, then one by one */
+XXH_FORCE_INLINE void
+XXH3_hash_u32_batch_internal(XXH64_hash_t* XXH_RESTRICT dst, const XXH32_hash_t* XXH_RESTRICT keys,
+                             size_t nbKeys, XXH64_hash_t seed, XXH3_f_hash_u32_x8 f_x8)
 {
-    return XXH3_update(state, (const xxh_u8*)input, len,
-                       XXH3_acc_128bits, XXH3_accumulate_512, XXH3_scrambleAcc);
+    size_t const nbFull = nbKeys - (nbKeys % XXH3_INT_LANES);
+    size_t n;
+    XXH_ASSERT(nbKeys == 0 || (dst != NULL && keys != NULL));
+    for (n = 0; n < nbFull; n += XXH3_INT_LANES) f_x8(dst + n, keys + n, seed);
+    for (n = nbFull; n < nbKeys; n++) dst[n] = XXH3_hash_u32_internal(keys[n], seed);
 }
 
-XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_digest (const XXH3_state_t* state)
+XXH_FORCE_INLINE void
+XXH3_hash_u64_batch_internal(XXH64_hash_t* XXH_RESTRICT dst, const XXH64_hash_t* XXH_RESTRICT keys,
+                             size_t nbKeys, XXH64_hash_t seed, XXH3_f_hash_u64_x8 f_x8)
 {
-    const unsigned char* const secret = (state->extSecret == NULL) ? state->customSecret : state->extSecret;
-    if (state->totalLen > XXH3_MIDSIZE_MAX) {
-        XXH_ALIGN(XXH_ACC_ALIGN) XXH64_hash_t acc[XXH_ACC_NB];
-        XXH3_digest_long(acc, state, secret, XXH3_acc_128bits);
-        XXH_ASSERT(state->secretLimit + XXH_STRIPE_LEN >= sizeof(acc) + XXH_SECRET_MERGEACCS_START);
-        {   XXH128_hash_t h128;
-            h128.low64  = XXH3_mergeAccs(acc,
-                                         secret + XXH_SECRET_MERGEACCS_START,
-                                         (xxh_u64)state->totalLen * XXH_PRIME64_1);
-            h128.high64 = XXH3_mergeAccs(acc,
-                                         secret + state->secretLimit + XXH_STRIPE_LEN
-                                                - sizeof(acc) - XXH_SECRET_MERGEACCS_START,
-                                         ~((xxh_u64)state->totalLen * XXH_PRIME64_2));
-            return h128;
-        }
-    }
-    /* len <= XXH3_MIDSIZE_MAX : short code */
-    if (state->seed)
-        return XXH3_128bits_withSeed(state->buffer, (size_t)state->totalLen, state->seed);
-    return XXH3_128bits_withSecret(state->buffer, (size_t)(state->totalLen),
-                                   secret, state->secretLimit + XXH_STRIPE_LEN);
+    size_t const nbFull = nbKeys - (nbKeys % XXH3_INT_LANES);
+    size_t n;
+    XXH_ASSERT(nbKeys == 0 || (dst != NULL && keys != NULL));
+    for (n = 0; n < nbFull; n += XXH3_INT_LANES) f_x8(dst + n, keys + n, seed);
+    for (n = nbFull; n < nbKeys; n++) dst[n] = XXH3_hash_u64_internal(keys[n], seed);
 }
 
-/* 128-bit utility functions */
+XXH_FORCE_INLINE void
+XXH3_hash_u128_batch_internal(XXH64_hash_t* XXH_RESTRICT dst, const XXH128_hash_t* XXH_RESTRICT keys,
+                              size_t nbKeys, XXH64_hash_t seed, XXH3_f_hash_u128_x8 f_x8)
+{
+    size_t const nbFull = nbKeys - (nbKeys % XXH3_INT_LANES);
+    size_t n;
+    XXH_ASSERT(nbKeys == 0 || (dst != NULL && keys != NULL));
+    for (n = 0; n < nbFull; n += XXH3_INT_LANES) f_x8(dst + n, keys + n, seed);
+    for (n = nbFull; n < nbKeys; n++) dst[n] = XXH3_hash_u128_internal(keys[n], seed);
+}
 
-#include <string.h>   /* memcmp, memcpy */
+XXH_PUBLIC_API void
+XXH3_hash_u32_batch(XXH64_hash_t* dst, const XXH32_hash_t* keys, size_t nbKeys)
+{
+    XXH3_hash_u32_batch_internal(dst, keys, nbKeys, 0, XXH3_hash_u32_x8);
+}
 
-/* return : 1 is equal, 0 if different */
-XXH_PUBLIC_API int XXH128_isEqual(XXH128_hash_t h1, XXH128_hash_t h2)
+XXH_PUBLIC_API void
+XXH3_hash_u32_withSeed_batch(XXH64_hash_t* dst, const XXH32_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
 {
-    /* note : XXH128_hash_t is compact, it has no padding byte */
-    return !(memcmp(&h1, &h2, sizeof(h1)));
+    XXH3_hash_u32_batch_internal(dst, keys, nbKeys, seed, XXH3_hash_u32_x8);
 }
 
-/* This prototype is compatible with stdlib's qsort().
- * return : >0 if *h128_1  > *h128_2
- *          <0 if *h128_1  < *h128_2
- *          =0 if *h128_1 == *h128_2  */
-XXH_PUBLIC_API int XXH128_cmp(const void* h128_1, const void* h128_2)
+XXH_PUBLIC_API void
+XXH3_hash_u64_batch(XXH64_hash_t* dst, const XXH64_hash_t* keys, size_t nbKeys)
 {
-    XXH128_hash_t const h1 = *(const XXH128_hash_t*)h128_1;
-    XXH128_hash_t const h2 = *(const XXH128_hash_t*)h128_2;
-    int const hcmp = (h1.high64 > h2.high64) - (h2.high64 > h1.high64);
-    /* note : bets that, in most cases, hash values are different */
-    if (hcmp) return hcmp;
-    return (h1.low64 > h2.low64) - (h2.low64 > h1.low64);
+    XXH3_hash_u64_batch_internal(dst, keys, nbKeys, 0, XXH3_hash_u64_x8);
 }
 
+XXH_PUBLIC_API void
+XXH3_hash_u64_withSeed_batch(XXH64_hash_t* dst, const XXH64_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_hash_u64_batch_internal(dst, keys, nbKeys, seed, XXH3_hash_u64_x8);
+}
 
-/*======   Canonical representation   ======*/
 XXH_PUBLIC_API void
-XXH128_canonicalFromHash(XXH128_canonical_t* dst, XXH128_hash_t hash)
+XXH3_hash_u128_batch(XXH64_hash_t* dst, const XXH128_hash_t* keys, size_t nbKeys)
 {
-    XXH_STATIC_ASSERT(sizeof(XXH128_canonical_t) == sizeof(XXH128_hash_t));
-    if (XXH_CPU_LITTLE_ENDIAN) {
-        hash.high64 = XXH_swap64(hash.high64);
-        hash.low64  = XXH_swap64(hash.low64);
-    }
-    memcpy(dst, &hash.high64, sizeof(hash.high64));
-    memcpy((char*)dst + sizeof(hash.high64), &hash.low64, sizeof(hash.low64));
+    XXH3_hash_u128_batch_internal(dst, keys, nbKeys, 0, XXH3_hash_u128_x8);
 }
 
-XXH_PUBLIC_API XXH128_hash_t
-XXH128_hashFromCanonical(const XXH128_canonical_t* src)
+XXH_PUBLIC_API void
+XXH3_hash_u128_withSeed_batch(XXH64_hash_t* dst, const XXH128_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
 {
-    XXH128_hash_t h;
-    h.high64 = XXH_readBE64(src);
-    h.low64  = XXH_readBE64(src->digest + 8);
-    return h;
+    XXH3_hash_u128_batch_internal(dst, keys, nbKeys, seed, XXH3_hash_u128_x8);
 }
 
+
 /* Pop our optimization override from above */
 #if XXH_VECTOR == XXH_AVX2 /* AVX2 */ \
   && defined(__GNUC__) && !defined(__clang__) /* GCC, not Clang */ \
@@ -414,6 +414,325 @@ XXH3_64bits_update_avx512(XXH3_state_t* state, const void* input, size_t len)
 }
 
 
+/* ===   XXH3 copy variants   === */
+
+XXH_NO_INLINE XXH64_hash_t
+XXHL64_copy_scalar(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_hashLong_64b_copy_internal(dst, input, len, mode, XXH3_accumulate_512_scalar, XXH3_scrambleAcc_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_SSE2 XXH64_hash_t
+XXHL64_copy_sse2(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_hashLong_64b_copy_internal(dst, input, len, mode, XXH3_accumulate_512_sse2, XXH3_scrambleAcc_sse2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH64_hash_t
+XXHL64_copy_avx2(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_hashLong_64b_copy_internal(dst, input, len, mode, XXH3_accumulate_512_avx2, XXH3_scrambleAcc_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 XXH64_hash_t
+XXHL64_copy_avx512(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_hashLong_64b_copy_internal(dst, input, len, mode, XXH3_accumulate_512_avx512, XXH3_scrambleAcc_avx512);
+}
+
+
+/* ===   XXH3 scatter-gather variants   === */
+
+XXH_NO_INLINE XXH64_hash_t
+XXHL64_vec_scalar(const XXH3_iovec_t* iov, size_t iovcnt, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_64b_vec_internal(iov, iovcnt, len, seed,
+                XXH3_accumulate_512_scalar, XXH3_scrambleAcc_scalar, XXH3_initCustomSecret_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_SSE2 XXH64_hash_t
+XXHL64_vec_sse2(const XXH3_iovec_t* iov, size_t iovcnt, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_64b_vec_internal(iov, iovcnt, len, seed,
+                XXH3_accumulate_512_sse2, XXH3_scrambleAcc_sse2, XXH3_initCustomSecret_sse2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH64_hash_t
+XXHL64_vec_avx2(const XXH3_iovec_t* iov, size_t iovcnt, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_64b_vec_internal(iov, iovcnt, len, seed,
+                XXH3_accumulate_512_avx2, XXH3_scrambleAcc_avx2, XXH3_initCustomSecret_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 XXH64_hash_t
+XXHL64_vec_avx512(const XXH3_iovec_t* iov, size_t iovcnt, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_64b_vec_internal(iov, iovcnt, len, seed,
+                XXH3_accumulate_512_avx512, XXH3_scrambleAcc_avx512, XXH3_initCustomSecret_avx512);
+}
+
+
+/* ===   XXH3 batch variants   === */
+
+/* SSE2 and AVX2 use the scalar kernel, see XXH3 batch hashing in xxh3.h */
+
+XXH_NO_INLINE void
+XXH3_64bits_batch_scalar(XXH64_hash_t* dst, const void* keys, size_t keySize, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_64bits_batch_short(dst, (const xxh_u8*)keys, keySize, nbKeys, seed, XXH3_hashShort_x8_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 void
+XXH3_64bits_batch_avx512(XXH64_hash_t* dst, const void* keys, size_t keySize, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_64bits_batch_short(dst, (const xxh_u8*)keys, keySize, nbKeys, seed, XXH3_hashShort_x8_avx512);
+}
+
+
+/* ===   XXH3 integer batch variants   === */
+
+/* SSE2 uses the scalar kernels, AVX2 too for 128-bit keys, see XXH3 integer hashing in xxh3.h */
+
+XXH_NO_INLINE void
+XXH3_hash_u32_batch_scalar(XXH64_hash_t* dst, const XXH32_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_hash_u32_batch_internal(dst, keys, nbKeys, seed, XXH3_hash_u32_x8_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 void
+XXH3_hash_u32_batch_avx2(XXH64_hash_t* dst, const XXH32_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_hash_u32_batch_internal(dst, keys, nbKeys, seed, XXH3_hash_u32_x8_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 void
+XXH3_hash_u32_batch_avx512(XXH64_hash_t* dst, const XXH32_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_hash_u32_batch_internal(dst, keys, nbKeys, seed, XXH3_hash_u32_x8_avx512);
+}
+
+XXH_NO_INLINE void
+XXH3_hash_u64_batch_scalar(XXH64_hash_t* dst, const XXH64_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_hash_u64_batch_internal(dst, keys, nbKeys, seed, XXH3_hash_u64_x8_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 void
+XXH3_hash_u64_batch_avx2(XXH64_hash_t* dst, const XXH64_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_hash_u64_batch_internal(dst, keys, nbKeys, seed, XXH3_hash_u64_x8_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 void
+XXH3_hash_u64_batch_avx512(XXH64_hash_t* dst, const XXH64_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_hash_u64_batch_internal(dst, keys, nbKeys, seed, XXH3_hash_u64_x8_avx512);
+}
+
+XXH_NO_INLINE void
+XXH3_hash_u128_batch_scalar(XXH64_hash_t* dst, const XXH128_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_hash_u128_batch_internal(dst, keys, nbKeys, seed, XXH3_hash_u128_x8_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 void
+XXH3_hash_u128_batch_avx512(XXH64_hash_t* dst, const XXH128_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_hash_u128_batch_internal(dst, keys, nbKeys, seed, XXH3_hash_u128_x8_avx512);
+}
+
+
+/* ===   XXH32 variants   === */
+
+/* Below AVX2, the scalar XXH32() is used directly */
+
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH32_hash_t
+XXH32_avx2(const void* input, size_t len, XXH32_hash_t seed)
+{
+    return XXH32_stripes_internal((const xxh_u8*)input, len, seed, XXH32_stripes_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH_errorcode
+XXH32_update_avx2(XXH32_state_t* state, const void* input, size_t len)
+{
+    return XXH32_update_stripes(state, (const xxh_u8*)input, len, XXH32_stripes_avx2);
+}
+
+
+/* ===   XXH32 and XXH64 multi-lane variants   === */
+
+/* Without an efficient kernel, batches loop over XXH32() and XXH64(), see xxh3.h.
+ * XXH64 lanes use the scalar kernel below AVX512. */
+
+XXH_NO_INLINE XXH_TARGET_AVX2 void
+XXH32_batch_avx2(XXH32_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs, XXH32_hash_t seed)
+{
+    XXH32_batch_internal(dst, inputs, inputSize, nbInputs, seed, XXH32_lanes_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 void
+XXH32_batch_avx512(XXH32_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs, XXH32_hash_t seed)
+{
+    XXH32_batch_internal(dst, inputs, inputSize, nbInputs, seed, XXH32_lanes_avx512);
+}
+
+XXH_NO_INLINE XXH_errorcode
+XXH32_lanes_update_scalar(XXH32_lanesState_t* state, const void* const* inputs, size_t len)
+{
+    return XXH32_lanes_update_internal(state, inputs, len, XXH32_lanes_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH_errorcode
+XXH32_lanes_update_avx2(XXH32_lanesState_t* state, const void* const* inputs, size_t len)
+{
+    return XXH32_lanes_update_internal(state, inputs, len, XXH32_lanes_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 XXH_errorcode
+XXH32_lanes_update_avx512(XXH32_lanesState_t* state, const void* const* inputs, size_t len)
+{
+    return XXH32_lanes_update_internal(state, inputs, len, XXH32_lanes_avx512);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 void
+XXH64_batch_avx512(XXH64_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs, XXH64_hash_t seed)
+{
+    XXH64_batch_internal(dst, inputs, inputSize, nbInputs, seed, XXH64_lanes_avx512);
+}
+
+XXH_NO_INLINE XXH_errorcode
+XXH64_lanes_update_scalar(XXH64_lanesState_t* state, const void* const* inputs, size_t len)
+{
+    return XXH64_lanes_update_internal(state, inputs, len, XXH64_lanes_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 XXH_errorcode
+XXH64_lanes_update_avx512(XXH64_lanesState_t* state, const void* const* inputs, size_t len)
+{
+    return XXH64_lanes_update_internal(state, inputs, len, XXH64_lanes_avx512);
+}
+
+
+/* ===   XXH3 multi-seed variants   === */
+
+/* SSE2 and AVX2 use the scalar short kernel, like batch variants */
+
+XXH_NO_INLINE void
+XXHL64_seeds_scalar(XXH64_hash_t* XXH_RESTRICT dst, const xxh_u8* XXH_RESTRICT input, size_t len,
+                    const XXH64_hash_t* XXH_RESTRICT seeds, size_t nbSeeds)
+{
+    XXH3_hashLong_64b_seeds_internal(dst, input, len, seeds, nbSeeds,
+                XXH3_accumulate_512_scalar, XXH3_scrambleAcc_scalar, XXH3_initCustomSecret_scalar);
+}
+
+XXH_NO_INLINE void
+XXH3_64bits_withSeeds_scalar(XXH64_hash_t* dst, const void* input, size_t len, const XXH64_hash_t* seeds, size_t nbSeeds)
+{
+    XXH3_64bits_withSeeds_internal(dst, input, len, seeds, nbSeeds, XXH3_hashShort_seeds_x8_scalar, XXHL64_seeds_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_SSE2 void
+XXHL64_seeds_sse2(XXH64_hash_t* XXH_RESTRICT dst, const xxh_u8* XXH_RESTRICT input, size_t len,
+                  const XXH64_hash_t* XXH_RESTRICT seeds, size_t nbSeeds)
+{
+    XXH3_hashLong_64b_seeds_internal(dst, input, len, seeds, nbSeeds,
+                XXH3_accumulate_512_sse2, XXH3_scrambleAcc_sse2, XXH3_initCustomSecret_sse2);
+}
+
+XXH_NO_INLINE XXH_TARGET_SSE2 void
+XXH3_64bits_withSeeds_sse2(XXH64_hash_t* dst, const void* input, size_t len, const XXH64_hash_t* seeds, size_t nbSeeds)
+{
+    XXH3_64bits_withSeeds_internal(dst, input, len, seeds, nbSeeds, XXH3_hashShort_seeds_x8_scalar, XXHL64_seeds_sse2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 void
+XXHL64_seeds_avx2(XXH64_hash_t* XXH_RESTRICT dst, const xxh_u8* XXH_RESTRICT input, size_t len,
+                  const XXH64_hash_t* XXH_RESTRICT seeds, size_t nbSeeds)
+{
+    XXH3_hashLong_64b_seeds_internal(dst, input, len, seeds, nbSeeds,
+                XXH3_accumulate_512_avx2, XXH3_scrambleAcc_avx2, XXH3_initCustomSecret_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 void
+XXH3_64bits_withSeeds_avx2(XXH64_hash_t* dst, const void* input, size_t len, const XXH64_hash_t* seeds, size_t nbSeeds)
+{
+    XXH3_64bits_withSeeds_internal(dst, input, len, seeds, nbSeeds, XXH3_hashShort_seeds_x8_scalar, XXHL64_seeds_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 void
+XXHL64_seeds_avx512(XXH64_hash_t* XXH_RESTRICT dst, const xxh_u8* XXH_RESTRICT input, size_t len,
+                    const XXH64_hash_t* XXH_RESTRICT seeds, size_t nbSeeds)
+{
+    XXH3_hashLong_64b_seeds_internal(dst, input, len, seeds, nbSeeds,
+                XXH3_accumulate_512_avx512, XXH3_scrambleAcc_avx512, XXH3_initCustomSecret_avx512);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 void
+XXH3_64bits_withSeeds_avx512(XXH64_hash_t* dst, const void* input, size_t len, const XXH64_hash_t* seeds, size_t nbSeeds)
+{
+    XXH3_64bits_withSeeds_internal(dst, input, len, seeds, nbSeeds, XXH3_hashShort_seeds_x8_avx512, XXHL64_seeds_avx512);
+}
+
+
+/* ===   XXH3 dual-width variants   === */
+
+XXH_NO_INLINE XXH3_dualHash_t
+XXHL_dual_scalar(const xxh_u8* XXH_RESTRICT input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_dual_internal(input, len, seed,
+                XXH3_accumulate_512_scalar, XXH3_scrambleAcc_scalar, XXH3_initCustomSecret_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_SSE2 XXH3_dualHash_t
+XXHL_dual_sse2(const xxh_u8* XXH_RESTRICT input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_dual_internal(input, len, seed,
+                XXH3_accumulate_512_sse2, XXH3_scrambleAcc_sse2, XXH3_initCustomSecret_sse2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH3_dualHash_t
+XXHL_dual_avx2(const xxh_u8* XXH_RESTRICT input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_dual_internal(input, len, seed,
+                XXH3_accumulate_512_avx2, XXH3_scrambleAcc_avx2, XXH3_initCustomSecret_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 XXH3_dualHash_t
+XXHL_dual_avx512(const xxh_u8* XXH_RESTRICT input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_dual_internal(input, len, seed,
+                XXH3_accumulate_512_avx512, XXH3_scrambleAcc_avx512, XXH3_initCustomSecret_avx512);
+}
+
+XXH_NO_INLINE XXH_errorcode
+XXH3_dual_update_scalar(XXH3_dualState_t* state, const void* input, size_t len)
+{
+    return XXH3_update_accs(&state->state, state->acc, (const xxh_u8*)input, len,
+                            XXH3_acc_dual, XXH3_accumulate_512_scalar, XXH3_scrambleAcc_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_SSE2 XXH_errorcode
+XXH3_dual_update_sse2(XXH3_dualState_t* state, const void* input, size_t len)
+{
+    return XXH3_update_accs(&state->state, state->acc, (const xxh_u8*)input, len,
+                            XXH3_acc_dual, XXH3_accumulate_512_sse2, XXH3_scrambleAcc_sse2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH_errorcode
+XXH3_dual_update_avx2(XXH3_dualState_t* state, const void* input, size_t len)
+{
+    return XXH3_update_accs(&state->state, state->acc, (const xxh_u8*)input, len,
+                            XXH3_acc_dual, XXH3_accumulate_512_avx2, XXH3_scrambleAcc_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 XXH_errorcode
+XXH3_dual_update_avx512(XXH3_dualState_t* state, const void* input, size_t len)
+{
+    return XXH3_update_accs(&state->state, state->acc, (const xxh_u8*)input, len,
+                            XXH3_acc_dual, XXH3_accumulate_512_avx512, XXH3_scrambleAcc_avx512);
+}
+
+
 /* ===   XXH128 default variants   === */
 
 XXH_NO_INLINE XXH128_hash_t
@@ -536,6 +855,62 @@ XXH3_128bits_update_avx512(XXH3_state_t* state, const void* input, size_t len)
                        XXH3_acc_128bits, XXH3_accumulate_512_avx512, XXH3_scrambleAcc_avx512);
 }
 
+/* ===   XXH128 copy variants   === */
+
+XXH_NO_INLINE XXH128_hash_t
+XXHL128_copy_scalar(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_hashLong_128b_copy_internal(dst, input, len, mode, XXH3_accumulate_512_scalar, XXH3_scrambleAcc_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_SSE2 XXH128_hash_t
+XXHL128_copy_sse2(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_hashLong_128b_copy_internal(dst, input, len, mode, XXH3_accumulate_512_sse2, XXH3_scrambleAcc_sse2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH128_hash_t
+XXHL128_copy_avx2(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_hashLong_128b_copy_internal(dst, input, len, mode, XXH3_accumulate_512_avx2, XXH3_scrambleAcc_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 XXH128_hash_t
+XXHL128_copy_avx512(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_hashLong_128b_copy_internal(dst, input, len, mode, XXH3_accumulate_512_avx512, XXH3_scrambleAcc_avx512);
+}
+
+/* ===   XXH128 scatter-gather variants   === */
+
+XXH_NO_INLINE XXH128_hash_t
+XXHL128_vec_scalar(const XXH3_iovec_t* iov, size_t iovcnt, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_128b_vec_internal(iov, iovcnt, len, seed,
+                XXH3_accumulate_512_scalar, XXH3_scrambleAcc_scalar, XXH3_initCustomSecret_scalar);
+}
+
+XXH_NO_INLINE XXH_TARGET_SSE2 XXH128_hash_t
+XXHL128_vec_sse2(const XXH3_iovec_t* iov, size_t iovcnt, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_128b_vec_internal(iov, iovcnt, len, seed,
+                XXH3_accumulate_512_sse2, XXH3_scrambleAcc_sse2, XXH3_initCustomSecret_sse2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH128_hash_t
+XXHL128_vec_avx2(const XXH3_iovec_t* iov, size_t iovcnt, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_128b_vec_internal(iov, iovcnt, len, seed,
+                XXH3_accumulate_512_avx2, XXH3_scrambleAcc_avx2, XXH3_initCustomSecret_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 XXH128_hash_t
+XXHL128_vec_avx512(const XXH3_iovec_t* iov, size_t iovcnt, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_hashLong_128b_vec_internal(iov, iovcnt, len, seed,
+                XXH3_accumulate_512_avx512, XXH3_scrambleAcc_avx512, XXH3_initCustomSecret_avx512);
+}
+
 /* ====    Dispatchers    ==== */
 
 typedef XXH64_hash_t (*XXH3_dispatchx86_hashLong64_default)(const void* XXH_RESTRICT, size_t);
@@ -546,21 +921,33 @@ typedef XXH64_hash_t (*XXH3_dispatchx86_hashLong64_withSecret)(const void* XXH_R
 
 typedef XXH_errorcode (*XXH3_dispatchx86_update)(XXH3_state_t*, const void*, size_t);
 
+typedef void (*XXH3_dispatchx86_batch64)(XXH64_hash_t*, const void*, size_t, size_t, XXH64_hash_t);
+
+typedef XXH64_hash_t (*XXH3_dispatchx86_hashLong64_copy)(void* XXH_RESTRICT, const void* XXH_RESTRICT, size_t, XXH3_copyMode_e);
+
+typedef XXH64_hash_t (*XXH3_dispatchx86_hashLong64_vec)(const XXH3_iovec_t*, size_t, size_t, XXH64_hash_t);
+
+typedef void (*XXH3_dispatchx86_seeds64)(XXH64_hash_t*, const void*, size_t, const XXH64_hash_t*, size_t);
+
 typedef struct {
     XXH3_dispatchx86_hashLong64_default    hashLong64_default;
     XXH3_dispatchx86_hashLong64_withSeed   hashLong64_seed;
     XXH3_dispatchx86_hashLong64_withSecret hashLong64_secret;
     XXH3_dispatchx86_update                update;
+    XXH3_dispatchx86_batch64               batch64;
+    XXH3_dispatchx86_hashLong64_copy       hashLong64_copy;
+    XXH3_dispatchx86_hashLong64_vec        hashLong64_vec;
+    XXH3_dispatchx86_seeds64               seeds64;
 } dispatchFunctions_s;
 
-static dispatchFunctions_s g_dispatch = { NULL, NULL, NULL, NULL};
+static dispatchFunctions_s g_dispatch = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
 
 #define NB_DISPATCHES 4
 static const dispatchFunctions_s k_dispatch[NB_DISPATCHES] = {
-        /* scalar */ { XXHL64_default_scalar, XXHL64_seed_scalar, XXHL64_secret_scalar, XXH3_64bits_update_scalar },
-        /* sse2   */ { XXHL64_default_sse2,   XXHL64_seed_sse2,   XXHL64_secret_sse2,   XXH3_64bits_update_sse2 },
-        /* avx2   */ { XXHL64_default_avx2,   XXHL64_seed_avx2,   XXHL64_secret_avx2,   XXH3_64bits_update_avx2 },
-        /* avx512 */ { XXHL64_default_avx512, XXHL64_seed_avx512, XXHL64_secret_avx512, XXH3_64bits_update_avx512 }
+        /* scalar */ { XXHL64_default_scalar, XXHL64_seed_scalar, XXHL64_secret_scalar, XXH3_64bits_update_scalar, XXH3_64bits_batch_scalar, XXHL64_copy_scalar, XXHL64_vec_scalar, XXH3_64bits_withSeeds_scalar },
+        /* sse2   */ { XXHL64_default_sse2,   XXHL64_seed_sse2,   XXHL64_secret_sse2,   XXH3_64bits_update_sse2,   XXH3_64bits_batch_scalar, XXHL64_copy_sse2, XXHL64_vec_sse2, XXH3_64bits_withSeeds_sse2 },
+        /* avx2   */ { XXHL64_default_avx2,   XXHL64_seed_avx2,   XXHL64_secret_avx2,   XXH3_64bits_update_avx2,   XXH3_64bits_batch_scalar, XXHL64_copy_avx2, XXHL64_vec_avx2, XXH3_64bits_withSeeds_avx2 },
+        /* avx512 */ { XXHL64_default_avx512, XXHL64_seed_avx512, XXHL64_secret_avx512, XXH3_64bits_update_avx512, XXH3_64bits_batch_avx512, XXHL64_copy_avx512, XXHL64_vec_avx512, XXH3_64bits_withSeeds_avx512 }
 };
 
 typedef XXH128_hash_t (*XXH3_dispatchx86_hashLong128_default)(const void* XXH_RESTRICT, size_t);
@@ -569,20 +956,96 @@ typedef XXH128_hash_t (*XXH3_dispatchx86_hashLong128_withSeed)(const void* XXH_R
 
 typedef XXH128_hash_t (*XXH3_dispatchx86_hashLong128_withSecret)(const void* XXH_RESTRICT, size_t, const void* XXH_RESTRICT, size_t);
 
+typedef XXH128_hash_t (*XXH3_dispatchx86_hashLong128_copy)(void* XXH_RESTRICT, const void* XXH_RESTRICT, size_t, XXH3_copyMode_e);
+
+typedef XXH128_hash_t (*XXH3_dispatchx86_hashLong128_vec)(const XXH3_iovec_t*, size_t, size_t, XXH64_hash_t);
+
+typedef XXH3_dualHash_t (*XXH3_dispatchx86_hashLongDual)(const xxh_u8* XXH_RESTRICT, size_t, XXH64_hash_t);
+
+typedef XXH_errorcode (*XXH3_dispatchx86_updateDual)(XXH3_dualState_t*, const void*, size_t);
+
 typedef struct {
     XXH3_dispatchx86_hashLong128_default    hashLong128_default;
     XXH3_dispatchx86_hashLong128_withSeed   hashLong128_seed;
     XXH3_dispatchx86_hashLong128_withSecret hashLong128_secret;
     XXH3_dispatchx86_update                 update;
+    XXH3_dispatchx86_hashLong128_copy       hashLong128_copy;
+    XXH3_dispatchx86_hashLong128_vec        hashLong128_vec;
+    XXH3_dispatchx86_hashLongDual           hashLongDual;
+    XXH3_dispatchx86_updateDual             updateDual;
 } dispatch128Functions_s;
 
-static dispatch128Functions_s g_dispatch128 = { NULL, NULL, NULL, NULL };
+static dispatch128Functions_s g_dispatch128 = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
 
 static const dispatch128Functions_s k_dispatch128[NB_DISPATCHES] = {
-        /* scalar */ { XXHL128_default_scalar, XXHL128_seed_scalar, XXHL128_secret_scalar, XXH3_128bits_update_scalar },
-        /* sse2   */ { XXHL128_default_sse2,   XXHL128_seed_sse2,   XXHL128_secret_sse2,   XXH3_128bits_update_sse2 },
-        /* avx2   */ { XXHL128_default_avx2,   XXHL128_seed_avx2,   XXHL128_secret_avx2,   XXH3_128bits_update_avx2 },
-        /* avx512 */ { XXHL128_default_avx512, XXHL128_seed_avx512, XXHL128_secret_avx512, XXH3_128bits_update_avx512 }
+        /* scalar */ { XXHL128_default_scalar, XXHL128_seed_scalar, XXHL128_secret_scalar, XXH3_128bits_update_scalar, XXHL128_copy_scalar, XXHL128_vec_scalar, XXHL_dual_scalar, XXH3_dual_update_scalar },
+        /* sse2   */ { XXHL128_default_sse2,   XXHL128_seed_sse2,   XXHL128_secret_sse2,   XXH3_128bits_update_sse2, XXHL128_copy_sse2, XXHL128_vec_sse2, XXHL_dual_sse2, XXH3_dual_update_sse2 },
+        /* avx2   */ { XXHL128_default_avx2,   XXHL128_seed_avx2,   XXHL128_secret_avx2,   XXH3_128bits_update_avx2, XXHL128_copy_avx2, XXHL128_vec_avx2, XXHL_dual_avx2, XXH3_dual_update_avx2 },
+        /* avx512 */ { XXHL128_default_avx512, XXHL128_seed_avx512, XXHL128_secret_avx512, XXH3_128bits_update_avx512, XXHL128_copy_avx512, XXHL128_vec_avx512, XXHL_dual_avx512, XXH3_dual_update_avx512 }
+};
+
+typedef XXH32_hash_t (*XXH_dispatchx86_hash32)(const void*, size_t, XXH32_hash_t);
+
+typedef XXH_errorcode (*XXH_dispatchx86_update32)(XXH32_state_t*, const void*, size_t);
+
+typedef struct {
+    XXH_dispatchx86_hash32   hash;
+    XXH_dispatchx86_update32 update;
+} dispatch32Functions_s;
+
+static dispatch32Functions_s g_dispatch32 = { NULL, NULL };
+
+/* AVX512 uses the AVX2 kernel: 512-bit products don't make chains any shorter */
+static const dispatch32Functions_s k_dispatch32[NB_DISPATCHES] = {
+        /* scalar */ { XXH32,      XXH32_update },
+        /* sse2   */ { XXH32,      XXH32_update },
+        /* avx2   */ { XXH32_avx2, XXH32_update_avx2 },
+        /* avx512 */ { XXH32_avx2, XXH32_update_avx2 }
+};
+
+typedef void (*XXH_dispatchx86_batch32)(XXH32_hash_t*, const void*, size_t, size_t, XXH32_hash_t);
+
+typedef XXH_errorcode (*XXH_dispatchx86_lanesUpdate32)(XXH32_lanesState_t*, const void* const*, size_t);
+
+typedef void (*XXH_dispatchx86_batch64)(XXH64_hash_t*, const void*, size_t, size_t, XXH64_hash_t);
+
+typedef XXH_errorcode (*XXH_dispatchx86_lanesUpdate64)(XXH64_lanesState_t*, const void* const*, size_t);
+
+typedef struct {
+    XXH_dispatchx86_batch32       batch32;
+    XXH_dispatchx86_lanesUpdate32 update32;
+    XXH_dispatchx86_batch64       batch64;
+    XXH_dispatchx86_lanesUpdate64 update64;
+} dispatchLanesFunctions_s;
+
+static dispatchLanesFunctions_s g_dispatchLanes = { NULL, NULL, NULL, NULL };
+
+static const dispatchLanesFunctions_s k_dispatchLanes[NB_DISPATCHES] = {
+        /* scalar */ { XXH32_batch_loop,   XXH32_lanes_update_scalar, XXH64_batch_loop,   XXH64_lanes_update_scalar },
+        /* sse2   */ { XXH32_batch_loop,   XXH32_lanes_update_scalar, XXH64_batch_loop,   XXH64_lanes_update_scalar },
+        /* avx2   */ { XXH32_batch_avx2,   XXH32_lanes_update_avx2,   XXH64_batch_loop,   XXH64_lanes_update_scalar },
+        /* avx512 */ { XXH32_batch_avx512, XXH32_lanes_update_avx512, XXH64_batch_avx512, XXH64_lanes_update_avx512 }
+};
+
+typedef void (*XXH3_dispatchx86_batch_u32)(XXH64_hash_t*, const XXH32_hash_t*, size_t, XXH64_hash_t);
+
+typedef void (*XXH3_dispatchx86_batch_u64)(XXH64_hash_t*, const XXH64_hash_t*, size_t, XXH64_hash_t);
+
+typedef void (*XXH3_dispatchx86_batch_u128)(XXH64_hash_t*, const XXH128_hash_t*, size_t, XXH64_hash_t);
+
+typedef struct {
+    XXH3_dispatchx86_batch_u32  batch_u32;
+    XXH3_dispatchx86_batch_u64  batch_u64;
+    XXH3_dispatchx86_batch_u128 batch_u128;
+} dispatchIntFunctions_s;
+
+static dispatchIntFunctions_s g_dispatchInt = { NULL, NULL, NULL };
+
+static const dispatchIntFunctions_s k_dispatchInt[NB_DISPATCHES] = {
+        /* scalar */ { XXH3_hash_u32_batch_scalar, XXH3_hash_u64_batch_scalar, XXH3_hash_u128_batch_scalar },
+        /* sse2   */ { XXH3_hash_u32_batch_scalar, XXH3_hash_u64_batch_scalar, XXH3_hash_u128_batch_scalar },
+        /* avx2   */ { XXH3_hash_u32_batch_avx2,   XXH3_hash_u64_batch_avx2,   XXH3_hash_u128_batch_scalar },
+        /* avx512 */ { XXH3_hash_u32_batch_avx512, XXH3_hash_u64_batch_avx512, XXH3_hash_u128_batch_avx512 }
 };
 
 static void setDispatch(void)
@@ -598,6 +1061,9 @@ static void setDispatch(void)
 #endif
     g_dispatch = k_dispatch[vecID];
     g_dispatch128 = k_dispatch128[vecID];
+    g_dispatch32 = k_dispatch32[vecID];
+    g_dispatchLanes = k_dispatchLanes[vecID];
+    g_dispatchInt = k_dispatchInt[vecID];
 }
 
 
@@ -645,6 +1111,16 @@ XXH64_hash_t XXH3_64bits_withSecret_dispatch(const void* input, size_t len, cons
     return XXH3_64bits_internal(input, len, 0, secret, secretLen, XXH3_hashLong_64b_withSecret_selection);
 }
 
+XXH64_hash_t XXH3_64bits_withSecretandSeed_dispatch(const void* input, size_t len, const void* secret, size_t secretLen, XXH64_hash_t seed)
+{
+    return XXH3_64bits_withSecretandSeed_internal(input, len, secret, secretLen, seed, XXH3_hashLong_64b_withSecret_selection);
+}
+
+XXH64_hash_t XXH3_64bits_withSeededContext_dispatch(const void* input, size_t len, const XXH3_seededContext_t* ctx)
+{
+    return XXH3_64bits_withSecretandSeed_dispatch(input, len, ctx->secret, sizeof(ctx->secret), ctx->seed);
+}
+
 XXH_errorcode
 XXH3_64bits_update_dispatch(XXH3_state_t* state, const void* input, size_t len)
 {
@@ -652,6 +1128,121 @@ XXH3_64bits_update_dispatch(XXH3_state_t* state, const void* input, size_t len)
     return g_dispatch.update(state, (const xxh_u8*)input, len);
 }
 
+void XXH3_64bits_withSeed_batch_dispatch(XXH64_hash_t* dst, const void* keys, size_t keySize, size_t nbKeys, XXH64_hash_t seed)
+{
+    if (keySize == 0 || keySize > XXH3_MIDSIZE_MAX) {
+        /* no lane kernel involved */
+        XXH3_64bits_batch_internal(dst, keys, keySize, nbKeys, seed, XXH3_hashShort_x8_scalar, XXH3_hashLong_64b_withSeed_selection);
+        return;
+    }
+    if (g_dispatch.batch64 == NULL) setDispatch();
+    g_dispatch.batch64(dst, keys, keySize, nbKeys, seed);
+}
+
+void XXH3_64bits_batch_dispatch(XXH64_hash_t* dst, const void* keys, size_t keySize, size_t nbKeys)
+{
+    XXH3_64bits_withSeed_batch_dispatch(dst, keys, keySize, nbKeys, 0);
+}
+
+void XXH3_64bits_withSeeds_dispatch(XXH64_hash_t* dst, const void* input, size_t len, const XXH64_hash_t* seeds, size_t nbSeeds)
+{
+    if (g_dispatch.seeds64 == NULL) setDispatch();
+    g_dispatch.seeds64(dst, input, len, seeds, nbSeeds);
+}
+
+void XXH3_64bits_gather_dispatch(XXH64_hash_t* dst, const void* const* keys, const size_t* lengths, size_t nbKeys)
+{
+    XXH3_64bits_gather_internal(dst, keys, lengths, nbKeys, 0, XXH3_hashLong_64b_defaultSecret_selection);
+}
+
+void XXH3_64bits_withSeed_gather_dispatch(XXH64_hash_t* dst, const void* const* keys, const size_t* lengths, size_t nbKeys, XXH64_hash_t seed)
+{
+    XXH3_64bits_gather_internal(dst, keys, lengths, nbKeys, seed, XXH3_hashLong_64b_withSeed_selection);
+}
+
+XXH_errorcode XXH3_64bits_partition_dispatch(XXH64_hash_t* hashes, XXH32_hash_t* partitions, size_t* histogram,
+                                             const void* keys, size_t keySize, size_t nbKeys, unsigned partitionBits)
+{
+    return XXH3_64bits_partition_internal(hashes, partitions, histogram, keys, keySize, nbKeys,
+                                          0, partitionBits, XXH3_64bits_withSeed_batch_dispatch);
+}
+
+XXH_errorcode XXH3_64bits_withSeed_partition_dispatch(XXH64_hash_t* hashes, XXH32_hash_t* partitions, size_t* histogram,
+                                                      const void* keys, size_t keySize, size_t nbKeys,
+                                                      XXH64_hash_t seed, unsigned partitionBits)
+{
+    return XXH3_64bits_partition_internal(hashes, partitions, histogram, keys, keySize, nbKeys,
+                                          seed, partitionBits, XXH3_64bits_withSeed_batch_dispatch);
+}
+
+XXH_errorcode XXH3_64bits_partition_varlen_dispatch(XXH64_hash_t* hashes, XXH32_hash_t* partitions, size_t* histogram,
+                                                    const void* data, const size_t* offsets, size_t nbKeys, unsigned partitionBits)
+{
+    return XXH3_64bits_partition_varlen_internal(hashes, partitions, histogram, data, offsets, nbKeys,
+                                                 0, partitionBits, XXH3_hashLong_64b_defaultSecret_selection);
+}
+
+XXH_errorcode XXH3_64bits_withSeed_partition_varlen_dispatch(XXH64_hash_t* hashes, XXH32_hash_t* partitions, size_t* histogram,
+                                                             const void* data, const size_t* offsets, size_t nbKeys,
+                                                             XXH64_hash_t seed, unsigned partitionBits)
+{
+    return XXH3_64bits_partition_varlen_internal(hashes, partitions, histogram, data, offsets, nbKeys,
+                                                 seed, partitionBits, XXH3_hashLong_64b_withSeed_selection);
+}
+
+void XXH3_64bits_column_dispatch(XXH64_hash_t* dst, const void* data, const size_t* offsets,
+                                 const unsigned char* validity, const XXH64_hash_t* seeds, size_t nbRows)
+{
+    XXH3_64bits_column_internal(dst, data, offsets, sizeof(size_t), validity, seeds, 0, nbRows, XXH3_hashLong_64b_withSeed_selection);
+}
+
+void XXH3_64bits_column32_dispatch(XXH64_hash_t* dst, const void* data, const XXH32_hash_t* offsets,
+                                   const unsigned char* validity, const XXH64_hash_t* seeds, size_t nbRows)
+{
+    XXH3_64bits_column_internal(dst, data, offsets, 4, validity, seeds, 0, nbRows, XXH3_hashLong_64b_withSeed_selection);
+}
+
+void XXH3_64bits_columns_dispatch(XXH64_hash_t* dst, const XXH3_column_t* columns, size_t nbColumns,
+                                  size_t nbRows, XXH64_hash_t seed)
+{
+    XXH3_64bits_columns_internal(dst, columns, nbColumns, nbRows, seed, XXH3_hashLong_64b_withSeed_selection);
+}
+
+/* ====    XXH3 integer batch public functions    ==== */
+
+void XXH3_hash_u32_withSeed_batch_dispatch(XXH64_hash_t* dst, const XXH32_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
+{
+    if (g_dispatchInt.batch_u32 == NULL) setDispatch();
+    g_dispatchInt.batch_u32(dst, keys, nbKeys, seed);
+}
+
+void XXH3_hash_u32_batch_dispatch(XXH64_hash_t* dst, const XXH32_hash_t* keys, size_t nbKeys)
+{
+    XXH3_hash_u32_withSeed_batch_dispatch(dst, keys, nbKeys, 0);
+}
+
+void XXH3_hash_u64_withSeed_batch_dispatch(XXH64_hash_t* dst, const XXH64_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
+{
+    if (g_dispatchInt.batch_u64 == NULL) setDispatch();
+    g_dispatchInt.batch_u64(dst, keys, nbKeys, seed);
+}
+
+void XXH3_hash_u64_batch_dispatch(XXH64_hash_t* dst, const XXH64_hash_t* keys, size_t nbKeys)
+{
+    XXH3_hash_u64_withSeed_batch_dispatch(dst, keys, nbKeys, 0);
+}
+
+void XXH3_hash_u128_withSeed_batch_dispatch(XXH64_hash_t* dst, const XXH128_hash_t* keys, size_t nbKeys, XXH64_hash_t seed)
+{
+    if (g_dispatchInt.batch_u128 == NULL) setDispatch();
+    g_dispatchInt.batch_u128(dst, keys, nbKeys, seed);
+}
+
+void XXH3_hash_u128_batch_dispatch(XXH64_hash_t* dst, const XXH128_hash_t* keys, size_t nbKeys)
+{
+    XXH3_hash_u128_withSeed_batch_dispatch(dst, keys, nbKeys, 0);
+}
+
 
 /* ====    XXH128 public functions    ==== */
 
@@ -697,9 +1288,261 @@ XXH128_hash_t XXH3_128bits_withSecret_dispatch(const void* input, size_t len, co
     return XXH3_128bits_internal(input, len, 0, secret, secretLen, XXH3_hashLong_128b_withSecret_selection);
 }
 
+XXH128_hash_t XXH3_128bits_withSecretandSeed_dispatch(const void* input, size_t len, const void* secret, size_t secretLen, XXH64_hash_t seed)
+{
+    return XXH3_128bits_withSecretandSeed_internal(input, len, secret, secretLen, seed, XXH3_hashLong_128b_withSecret_selection);
+}
+
+XXH128_hash_t XXH3_128bits_withSeededContext_dispatch(const void* input, size_t len, const XXH3_seededContext_t* ctx)
+{
+    return XXH3_128bits_withSecretandSeed_dispatch(input, len, ctx->secret, sizeof(ctx->secret), ctx->seed);
+}
+
 XXH_errorcode
 XXH3_128bits_update_dispatch(XXH3_state_t* state, const void* input, size_t len)
 {
     if (g_dispatch128.update == NULL) setDispatch();
     return g_dispatch128.update(state, (const xxh_u8*)input, len);
 }
+
+XXH128_hash_t XXH3_128bits_tree_dispatch(const void* input, size_t len, XXH64_hash_t seed, const XXH3_treePool_t* pool)
+{
+    return XXH3_128bits_tree_internal(input, len, seed, pool, XXH3_128bits_withSeed_dispatch, XXH3_128bits_update_dispatch);
+}
+
+XXH_errorcode
+XXH3_128bits_tree_update_dispatch(XXH3_treeState_t* state, const void* input, size_t len)
+{
+    return XXH3_128bits_tree_update_internal(state, (const xxh_u8*)input, len,
+                                             XXH3_128bits_withSeed_dispatch, XXH3_128bits_update_dispatch);
+}
+
+XXH_errorcode XXH3_merkle_build_dispatch(XXH3_merkle_t* tree, const void* data, size_t len)
+{
+    return XXH3_merkle_build_internal(tree, data, len, XXH3_128bits_withSeed_dispatch);
+}
+
+XXH_errorcode XXH3_merkle_append_dispatch(XXH3_merkle_t* tree, const void* leaf, size_t leafLen)
+{
+    return XXH3_merkle_append_internal(tree, leaf, leafLen, XXH3_128bits_withSeed_dispatch);
+}
+
+XXH_errorcode XXH3_merkle_updateLeaf_dispatch(XXH3_merkle_t* tree, size_t leafNb, const void* leaf, size_t leafLen)
+{
+    return XXH3_merkle_updateLeaf_internal(tree, leafNb, leaf, leafLen, XXH3_128bits_withSeed_dispatch);
+}
+
+XXH_errorcode XXH3_merkle_updateLeaves_dispatch(XXH3_merkle_t* tree, size_t firstLeaf, const void* data, size_t len)
+{
+    return XXH3_merkle_updateLeaves_internal(tree, firstLeaf, data, len, XXH3_128bits_withSeed_dispatch);
+}
+
+static XXH64_hash_t
+XXH3_hashLong_64b_copy_selection(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len, XXH3_copyMode_e mode)
+{
+    if (g_dispatch.hashLong64_copy == NULL) setDispatch();
+    return g_dispatch.hashLong64_copy(dst, input, len, mode);
+}
+
+XXH64_hash_t XXH3_64bits_copy_dispatch(void* dst, const void* src, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_64bits_copy_internal(dst, src, len, mode, XXH3_hashLong_64b_copy_selection);
+}
+
+static XXH128_hash_t
+XXH3_hashLong_128b_copy_selection(void* XXH_RESTRICT dst, const void* XXH_RESTRICT input, size_t len, XXH3_copyMode_e mode)
+{
+    if (g_dispatch128.hashLong128_copy == NULL) setDispatch();
+    return g_dispatch128.hashLong128_copy(dst, input, len, mode);
+}
+
+XXH128_hash_t XXH3_128bits_copy_dispatch(void* dst, const void* src, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_128bits_copy_internal(dst, src, len, mode, XXH3_hashLong_128b_copy_selection);
+}
+
+XXH_errorcode
+XXH3_64bits_update_copy_dispatch(XXH3_state_t* state, void* dst, const void* src, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_update_copy(state, dst, (const xxh_u8*)src, len, mode, XXH3_64bits_update_dispatch);
+}
+
+XXH_errorcode
+XXH3_128bits_update_copy_dispatch(XXH3_state_t* state, void* dst, const void* src, size_t len, XXH3_copyMode_e mode)
+{
+    return XXH3_update_copy(state, dst, (const xxh_u8*)src, len, mode, XXH3_128bits_update_dispatch);
+}
+
+XXH64_hash_t XXH3_64bits_cstr_dispatch(const char* s)
+{
+    return XXH3_64bits_cstr_internal(s, 0, XXH3_64bits_withSeed_dispatch, XXH3_64bits_update_dispatch);
+}
+
+XXH64_hash_t XXH3_64bits_cstr_withSeed_dispatch(const char* s, XXH64_hash_t seed)
+{
+    return XXH3_64bits_cstr_internal(s, seed, XXH3_64bits_withSeed_dispatch, XXH3_64bits_update_dispatch);
+}
+
+XXH128_hash_t XXH3_128bits_cstr_dispatch(const char* s)
+{
+    return XXH3_128bits_cstr_internal(s, 0, XXH3_128bits_withSeed_dispatch, XXH3_128bits_update_dispatch);
+}
+
+XXH128_hash_t XXH3_128bits_cstr_withSeed_dispatch(const char* s, XXH64_hash_t seed)
+{
+    return XXH3_128bits_cstr_internal(s, seed, XXH3_128bits_withSeed_dispatch, XXH3_128bits_update_dispatch);
+}
+
+XXH64_hash_t XXH3_64bits_lowercase_dispatch(const void* input, size_t len)
+{
+    return XXH3_64bits_lowercase_internal(input, len, 0, XXH3_64bits_withSeed_dispatch, XXH3_64bits_update_dispatch);
+}
+
+XXH64_hash_t XXH3_64bits_lowercase_withSeed_dispatch(const void* input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_64bits_lowercase_internal(input, len, seed, XXH3_64bits_withSeed_dispatch, XXH3_64bits_update_dispatch);
+}
+
+XXH_errorcode XXH3_64bits_update_lowercase_dispatch(XXH3_state_t* state, const void* input, size_t len)
+{
+    return XXH3_update_lowercase_internal(state, input, len, XXH3_64bits_update_dispatch);
+}
+
+XXH128_hash_t XXH3_128bits_lowercase_dispatch(const void* input, size_t len)
+{
+    return XXH3_128bits_lowercase_internal(input, len, 0, XXH3_128bits_withSeed_dispatch, XXH3_128bits_update_dispatch);
+}
+
+XXH128_hash_t XXH3_128bits_lowercase_withSeed_dispatch(const void* input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_128bits_lowercase_internal(input, len, seed, XXH3_128bits_withSeed_dispatch, XXH3_128bits_update_dispatch);
+}
+
+XXH_errorcode XXH3_128bits_update_lowercase_dispatch(XXH3_state_t* state, const void* input, size_t len)
+{
+    return XXH3_update_lowercase_internal(state, input, len, XXH3_128bits_update_dispatch);
+}
+
+XXH_errorcode XXH3_set_add_dispatch(XXH3_set_t* set, const void* element, size_t len)
+{
+    return XXH3_set_add_internal(set, element, len, XXH3_128bits_withSeed_dispatch);
+}
+
+XXH_errorcode XXH3_set_remove_dispatch(XXH3_set_t* set, const void* element, size_t len)
+{
+    return XXH3_set_remove_internal(set, element, len, XXH3_128bits_withSeed_dispatch);
+}
+
+XXH_errorcode XXH3_set_addBatch_dispatch(XXH3_set_t* set, const void* elements, size_t elementSize, size_t nbElements)
+{
+    return XXH3_set_addBatch_internal(set, elements, elementSize, nbElements, XXH3_128bits_withSeed_dispatch);
+}
+
+XXH_errorcode XXH3_set_addGather_dispatch(XXH3_set_t* set, const void* const* elements, const size_t* lengths, size_t nbElements)
+{
+    return XXH3_set_addGather_internal(set, elements, lengths, nbElements, XXH3_128bits_withSeed_dispatch);
+}
+
+static XXH64_hash_t
+XXH3_hashLong_64b_vec_selection(const XXH3_iovec_t* iov, size_t iovcnt, size_t len, XXH64_hash_t seed)
+{
+    if (g_dispatch.hashLong64_vec == NULL) setDispatch();
+    return g_dispatch.hashLong64_vec(iov, iovcnt, len, seed);
+}
+
+XXH64_hash_t XXH3_64bits_vec_dispatch(const XXH3_iovec_t* iov, size_t iovcnt)
+{
+    return XXH3_64bits_vec_internal(iov, iovcnt, 0, XXH3_hashLong_64b_vec_selection);
+}
+
+XXH64_hash_t XXH3_64bits_withSeed_vec_dispatch(const XXH3_iovec_t* iov, size_t iovcnt, XXH64_hash_t seed)
+{
+    return XXH3_64bits_vec_internal(iov, iovcnt, seed, XXH3_hashLong_64b_vec_selection);
+}
+
+static XXH128_hash_t
+XXH3_hashLong_128b_vec_selection(const XXH3_iovec_t* iov, size_t iovcnt, size_t len, XXH64_hash_t seed)
+{
+    if (g_dispatch128.hashLong128_vec == NULL) setDispatch();
+    return g_dispatch128.hashLong128_vec(iov, iovcnt, len, seed);
+}
+
+XXH128_hash_t XXH3_128bits_vec_dispatch(const XXH3_iovec_t* iov, size_t iovcnt)
+{
+    return XXH3_128bits_vec_internal(iov, iovcnt, 0, XXH3_hashLong_128b_vec_selection);
+}
+
+XXH128_hash_t XXH3_128bits_withSeed_vec_dispatch(const XXH3_iovec_t* iov, size_t iovcnt, XXH64_hash_t seed)
+{
+    return XXH3_128bits_vec_internal(iov, iovcnt, seed, XXH3_hashLong_128b_vec_selection);
+}
+
+static XXH3_dualHash_t
+XXH3_hashLong_dual_selection(const xxh_u8* XXH_RESTRICT input, size_t len, XXH64_hash_t seed)
+{
+    if (g_dispatch128.hashLongDual == NULL) setDispatch();
+    return g_dispatch128.hashLongDual(input, len, seed);
+}
+
+XXH3_dualHash_t XXH3_dual_dispatch(const void* input, size_t len)
+{
+    return XXH3_dual_internal(input, len, 0, XXH3_hashLong_dual_selection);
+}
+
+XXH3_dualHash_t XXH3_dual_withSeed_dispatch(const void* input, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_dual_internal(input, len, seed, XXH3_hashLong_dual_selection);
+}
+
+XXH_errorcode
+XXH3_dual_update_dispatch(XXH3_dualState_t* state, const void* input, size_t len)
+{
+    if (g_dispatch128.updateDual == NULL) setDispatch();
+    return g_dispatch128.updateDual(state, input, len);
+}
+
+
+/* ====    XXH32 public functions    ==== */
+
+/* below this size, the latency of the first products outweighs the gain */
+#define XXH32_DISPATCH_MIN 1024
+
+XXH32_hash_t XXH32_dispatch(const void* input, size_t len, XXH32_hash_t seed)
+{
+    if (len < XXH32_DISPATCH_MIN) return XXH32(input, len, seed);
+    if (g_dispatch32.hash == NULL) setDispatch();
+    return g_dispatch32.hash(input, len, seed);
+}
+
+XXH_errorcode XXH32_update_dispatch(XXH32_state_t* state, const void* input, size_t len)
+{
+    if (len < XXH32_DISPATCH_MIN) return XXH32_update(state, input, len);
+    if (g_dispatch32.update == NULL) setDispatch();
+    return g_dispatch32.update(state, input, len);
+}
+
+/* ====    XXH32 and XXH64 multi-lane public functions    ==== */
+
+void XXH32_batch_dispatch(XXH32_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs, XXH32_hash_t seed)
+{
+    if (g_dispatchLanes.batch32 == NULL) setDispatch();
+    g_dispatchLanes.batch32(dst, inputs, inputSize, nbInputs, seed);
+}
+
+XXH_errorcode XXH32_lanes_update_dispatch(XXH32_lanesState_t* state, const void* const* inputs, size_t len)
+{
+    if (g_dispatchLanes.update32 == NULL) setDispatch();
+    return g_dispatchLanes.update32(state, inputs, len);
+}
+
+void XXH64_batch_dispatch(XXH64_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs, XXH64_hash_t seed)
+{
+    if (g_dispatchLanes.batch64 == NULL) setDispatch();
+    g_dispatchLanes.batch64(dst, inputs, inputSize, nbInputs, seed);
+}
+
+XXH_errorcode XXH64_lanes_update_dispatch(XXH64_lanesState_t* state, const void* const* inputs, size_t len)
+{
+    if (g_dispatchLanes.update64 == NULL) setDispatch();
+    return g_dispatchLanes.update64(state, inputs, len);
+}
@@ -45,12 +45,73 @@ extern "C" {
 XXH_PUBLIC_API XXH64_hash_t  XXH3_64bits_dispatch(const void* input, size_t len);
 XXH_PUBLIC_API XXH64_hash_t  XXH3_64bits_withSeed_dispatch(const void* input, size_t len, XXH64_hash_t seed);
 XXH_PUBLIC_API XXH64_hash_t  XXH3_64bits_withSecret_dispatch(const void* input, size_t len, const void* secret, size_t secretLen);
+XXH_PUBLIC_API XXH64_hash_t  XXH3_64bits_withSecretandSeed_dispatch(const void* input, size_t len, const void* secret, size_t secretLen, XXH64_hash_t seed);
+XXH_PUBLIC_API XXH64_hash_t  XXH3_64bits_withSeededContext_dispatch(const void* input, size_t len, const XXH3_seededContext_t* ctx);
 XXH_PUBLIC_API XXH_errorcode XXH3_64bits_update_dispatch(XXH3_state_t* state, const void* input, size_t len);
+XXH_PUBLIC_API XXH64_hash_t  XXH3_64bits_copy_dispatch(void* dst, const void* src, size_t len, XXH3_copyMode_e mode);
+XXH_PUBLIC_API XXH_errorcode XXH3_64bits_update_copy_dispatch(XXH3_state_t* state, void* dst, const void* src, size_t len, XXH3_copyMode_e mode);
+XXH_PUBLIC_API XXH64_hash_t  XXH3_64bits_cstr_dispatch(const char* s);
+XXH_PUBLIC_API XXH64_hash_t  XXH3_64bits_cstr_withSeed_dispatch(const char* s, XXH64_hash_t seed);
+XXH_PUBLIC_API XXH64_hash_t  XXH3_64bits_lowercase_dispatch(const void* input, size_t len);
+XXH_PUBLIC_API XXH64_hash_t  XXH3_64bits_lowercase_withSeed_dispatch(const void* input, size_t len, XXH64_hash_t seed);
+XXH_PUBLIC_API XXH_errorcode XXH3_64bits_update_lowercase_dispatch(XXH3_state_t* state, const void* input, size_t len);
+XXH_PUBLIC_API XXH64_hash_t  XXH3_64bits_vec_dispatch(const XXH3_iovec_t* iov, size_t iovcnt);
+XXH_PUBLIC_API XXH64_hash_t  XXH3_64bits_withSeed_vec_dispatch(const XXH3_iovec_t* iov, size_t iovcnt, XXH64_hash_t seed);
+XXH_PUBLIC_API void XXH3_64bits_batch_dispatch(XXH64_hash_t* dst, const void* keys, size_t keySize, size_t nbKeys);
+XXH_PUBLIC_API void XXH3_64bits_withSeed_batch_dispatch(XXH64_hash_t* dst, const void* keys, size_t keySize, size_t nbKeys, XXH64_hash_t seed);
+XXH_PUBLIC_API void XXH3_64bits_gather_dispatch(XXH64_hash_t* dst, const void* const* keys, const size_t* lengths, size_t nbKeys);
+XXH_PUBLIC_API void XXH3_64bits_withSeed_gather_dispatch(XXH64_hash_t* dst, const void* const* keys, const size_t* lengths, size_t nbKeys, XXH64_hash_t seed);
+XXH_PUBLIC_API void XXH3_64bits_withSeeds_dispatch(XXH64_hash_t* dst, const void* input, size_t len, const XXH64_hash_t* seeds, size_t nbSeeds);
+XXH_PUBLIC_API XXH_errorcode XXH3_64bits_partition_dispatch(XXH64_hash_t* hashes, XXH32_hash_t* partitions, size_t* histogram, const void* keys, size_t keySize, size_t nbKeys, unsigned partitionBits);
+XXH_PUBLIC_API XXH_errorcode XXH3_64bits_withSeed_partition_dispatch(XXH64_hash_t* hashes, XXH32_hash_t* partitions, size_t* histogram, const void* keys, size_t keySize, size_t nbKeys, XXH64_hash_t seed, unsigned partitionBits);
+XXH_PUBLIC_API XXH_errorcode XXH3_64bits_partition_varlen_dispatch(XXH64_hash_t* hashes, XXH32_hash_t* partitions, size_t* histogram, const void* data, const size_t* offsets, size_t nbKeys, unsigned partitionBits);
+XXH_PUBLIC_API XXH_errorcode XXH3_64bits_withSeed_partition_varlen_dispatch(XXH64_hash_t* hashes, XXH32_hash_t* partitions, size_t* histogram, const void* data, const size_t* offsets, size_t nbKeys, XXH64_hash_t seed, unsigned partitionBits);
+XXH_PUBLIC_API void XXH3_64bits_column_dispatch(XXH64_hash_t* dst, const void* data, const size_t* offsets, const unsigned char* validity, const XXH64_hash_t* seeds, size_t nbRows);
+XXH_PUBLIC_API void XXH3_64bits_column32_dispatch(XXH64_hash_t* dst, const void* data, const XXH32_hash_t* offsets, const unsigned char* validity, const XXH64_hash_t* seeds, size_t nbRows);
+XXH_PUBLIC_API void XXH3_64bits_columns_dispatch(XXH64_hash_t* dst, const XXH3_column_t* columns, size_t nbColumns, size_t nbRows, XXH64_hash_t seed);
+XXH_PUBLIC_API void XXH3_hash_u32_batch_dispatch(XXH64_hash_t* dst, const XXH32_hash_t* keys, size_t nbKeys);
+XXH_PUBLIC_API void XXH3_hash_u32_withSeed_batch_dispatch(XXH64_hash_t* dst, const XXH32_hash_t* keys, size_t nbKeys, XXH64_hash_t seed);
+XXH_PUBLIC_API void XXH3_hash_u64_batch_dispatch(XXH64_hash_t* dst, const XXH64_hash_t* keys, size_t nbKeys);
+XXH_PUBLIC_API void XXH3_hash_u64_withSeed_batch_dispatch(XXH64_hash_t* dst, const XXH64_hash_t* keys, size_t nbKeys, XXH64_hash_t seed);
+XXH_PUBLIC_API void XXH3_hash_u128_batch_dispatch(XXH64_hash_t* dst, const XXH128_hash_t* keys, size_t nbKeys);
+XXH_PUBLIC_API void XXH3_hash_u128_withSeed_batch_dispatch(XXH64_hash_t* dst, const XXH128_hash_t* keys, size_t nbKeys, XXH64_hash_t seed);
 
 XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_dispatch(const void* input, size_t len);
 XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_withSeed_dispatch(const void* input, size_t len, XXH64_hash_t seed);
 XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_withSecret_dispatch(const void* input, size_t len, const void* secret, size_t secretLen);
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_withSecretandSeed_dispatch(const void* input, size_t len, const void* secret, size_t secretLen, XXH64_hash_t seed);
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_withSeededContext_dispatch(const void* input, size_t len, const XXH3_seededContext_t* ctx);
 XXH_PUBLIC_API XXH_errorcode XXH3_128bits_update_dispatch(XXH3_state_t* state, const void* input, size_t len);
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_copy_dispatch(void* dst, const void* src, size_t len, XXH3_copyMode_e mode);
+XXH_PUBLIC_API XXH_errorcode XXH3_128bits_update_copy_dispatch(XXH3_state_t* state, void* dst, const void* src, size_t len, XXH3_copyMode_e mode);
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_cstr_dispatch(const char* s);
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_cstr_withSeed_dispatch(const char* s, XXH64_hash_t seed);
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_lowercase_dispatch(const void* input, size_t len);
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_lowercase_withSeed_dispatch(const void* input, size_t len, XXH64_hash_t seed);
+XXH_PUBLIC_API XXH_errorcode XXH3_128bits_update_lowercase_dispatch(XXH3_state_t* state, const void* input, size_t len);
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_vec_dispatch(const XXH3_iovec_t* iov, size_t iovcnt);
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_withSeed_vec_dispatch(const XXH3_iovec_t* iov, size_t iovcnt, XXH64_hash_t seed);
+XXH_PUBLIC_API XXH128_hash_t XXH3_128bits_tree_dispatch(const void* input, size_t len, XXH64_hash_t seed, const XXH3_treePool_t* pool);
+XXH_PUBLIC_API XXH_errorcode XXH3_128bits_tree_update_dispatch(XXH3_treeState_t* state, const void* input, size_t len);
+XXH_PUBLIC_API XXH_errorcode XXH3_merkle_build_dispatch(XXH3_merkle_t* tree, const void* data, size_t len);
+XXH_PUBLIC_API XXH_errorcode XXH3_merkle_append_dispatch(XXH3_merkle_t* tree, const void* leaf, size_t leafLen);
+XXH_PUBLIC_API XXH_errorcode XXH3_merkle_updateLeaf_dispatch(XXH3_merkle_t* tree, size_t leafNb, const void* leaf, size_t leafLen);
+XXH_PUBLIC_API XXH_errorcode XXH3_merkle_updateLeaves_dispatch(XXH3_merkle_t* tree, size_t firstLeaf, const void* data, size_t len);
+XXH_PUBLIC_API XXH_errorcode XXH3_set_add_dispatch(XXH3_set_t* set, const void* element, size_t len);
+XXH_PUBLIC_API XXH_errorcode XXH3_set_remove_dispatch(XXH3_set_t* set, const void* element, size_t len);
+XXH_PUBLIC_API XXH_errorcode XXH3_set_addBatch_dispatch(XXH3_set_t* set, const void* elements, size_t elementSize, size_t nbElements);
+XXH_PUBLIC_API XXH_errorcode XXH3_set_addGather_dispatch(XXH3_set_t* set, const void* const* elements, const size_t* lengths, size_t nbElements);
+
+XXH_PUBLIC_API XXH3_dualHash_t XXH3_dual_dispatch(const void* input, size_t len);
+XXH_PUBLIC_API XXH3_dualHash_t XXH3_dual_withSeed_dispatch(const void* input, size_t len, XXH64_hash_t seed);
+XXH_PUBLIC_API XXH_errorcode   XXH3_dual_update_dispatch(XXH3_dualState_t* state, const void* input, size_t len);
+
+XXH_PUBLIC_API XXH32_hash_t XXH32_dispatch(const void* input, size_t len, XXH32_hash_t seed);
+XXH_PUBLIC_API XXH_errorcode XXH32_update_dispatch(XXH32_state_t* state, const void* input, size_t len);
+XXH_PUBLIC_API void XXH32_batch_dispatch(XXH32_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs, XXH32_hash_t seed);
+XXH_PUBLIC_API XXH_errorcode XXH32_lanes_update_dispatch(XXH32_lanesState_t* state, const void* const* inputs, size_t len);
+XXH_PUBLIC_API void XXH64_batch_dispatch(XXH64_hash_t* dst, const void* inputs, size_t inputSize, size_t nbInputs, XXH64_hash_t seed);
+XXH_PUBLIC_API XXH_errorcode XXH64_lanes_update_dispatch(XXH64_lanesState_t* state, const void* const* inputs, size_t len);
 
 
 /* automatic replacement of XXH3 functions.
@@ -63,8 +124,66 @@ XXH_PUBLIC_API XXH_errorcode XXH3_128bits_update_dispatch(XXH3_state_t* state, c
 # define XXH3_64bits_withSeed XXH3_64bits_withSeed_dispatch
 # undef  XXH3_64bits_withSecret
 # define XXH3_64bits_withSecret XXH3_64bits_withSecret_dispatch
+# undef  XXH3_64bits_withSecretandSeed
+# define XXH3_64bits_withSecretandSeed XXH3_64bits_withSecretandSeed_dispatch
+# undef  XXH3_64bits_withSeededContext
+# define XXH3_64bits_withSeededContext XXH3_64bits_withSeededContext_dispatch
 # undef  XXH3_64bits_update
 # define XXH3_64bits_update XXH3_64bits_update_dispatch
+# undef  XXH3_64bits_copy
+# define XXH3_64bits_copy XXH3_64bits_copy_dispatch
+# undef  XXH3_64bits_update_copy
+# define XXH3_64bits_update_copy XXH3_64bits_update_copy_dispatch
+# undef  XXH3_64bits_cstr
+# define XXH3_64bits_cstr XXH3_64bits_cstr_dispatch
+# undef  XXH3_64bits_cstr_withSeed
+# define XXH3_64bits_cstr_withSeed XXH3_64bits_cstr_withSeed_dispatch
+# undef  XXH3_64bits_lowercase
+# define XXH3_64bits_lowercase XXH3_64bits_lowercase_dispatch
+# undef  XXH3_64bits_lowercase_withSeed
+# define XXH3_64bits_lowercase_withSeed XXH3_64bits_lowercase_withSeed_dispatch
+# undef  XXH3_64bits_update_lowercase
+# define XXH3_64bits_update_lowercase XXH3_64bits_update_lowercase_dispatch
+# undef  XXH3_64bits_vec
+# define XXH3_64bits_vec XXH3_64bits_vec_dispatch
+# undef  XXH3_64bits_withSeed_vec
+# define XXH3_64bits_withSeed_vec XXH3_64bits_withSeed_vec_dispatch
+# undef  XXH3_64bits_batch
+# define XXH3_64bits_batch XXH3_64bits_batch_dispatch
+# undef  XXH3_64bits_withSeed_batch
+# define XXH3_64bits_withSeed_batch XXH3_64bits_withSeed_batch_dispatch
+# undef  XXH3_64bits_gather
+# define XXH3_64bits_gather XXH3_64bits_gather_dispatch
+# undef  XXH3_64bits_withSeed_gather
+# define XXH3_64bits_withSeed_gather XXH3_64bits_withSeed_gather_dispatch
+# undef  XXH3_64bits_withSeeds
+# define XXH3_64bits_withSeeds XXH3_64bits_withSeeds_dispatch
+# undef  XXH3_64bits_partition
+# define XXH3_64bits_partition XXH3_64bits_partition_dispatch
+# undef  XXH3_64bits_withSeed_partition
+# define XXH3_64bits_withSeed_partition XXH3_64bits_withSeed_partition_dispatch
+# undef  XXH3_64bits_partition_varlen
+# define XXH3_64bits_partition_varlen XXH3_64bits_partition_varlen_dispatch
+# undef  XXH3_64bits_withSeed_partition_varlen
+# define XXH3_64bits_withSeed_partition_varlen XXH3_64bits_withSeed_partition_varlen_dispatch
+# undef  XXH3_64bits_column
+# define XXH3_64bits_column XXH3_64bits_column_dispatch
+# undef  XXH3_64bits_column32
+# define XXH3_64bits_column32 XXH3_64bits_column32_dispatch
+# undef  XXH3_64bits_columns
+# define XXH3_64bits_columns XXH3_64bits_columns_dispatch
+# undef  XXH3_hash_u32_batch
+# define XXH3_hash_u32_batch XXH3_hash_u32_batch_dispatch
+# undef  XXH3_hash_u32_withSeed_batch
+# define XXH3_hash_u32_withSeed_batch XXH3_hash_u32_withSeed_batch_dispatch
+# undef  XXH3_hash_u64_batch
+# define XXH3_hash_u64_batch XXH3_hash_u64_batch_dispatch
+# undef  XXH3_hash_u64_withSeed_batch
+# define XXH3_hash_u64_withSeed_batch XXH3_hash_u64_withSeed_batch_dispatch
+# undef  XXH3_hash_u128_batch
+# define XXH3_hash_u128_batch XXH3_hash_u128_batch_dispatch
+# undef  XXH3_hash_u128_withSeed_batch
+# define XXH3_hash_u128_withSeed_batch XXH3_hash_u128_withSeed_batch_dispatch
 
 # undef  XXH128
 # define XXH128 XXH3_128bits_withSeed_dispatch
@@ -75,8 +194,70 @@ XXH_PUBLIC_API XXH_errorcode XXH3_128bits_update_dispatch(XXH3_state_t* state, c
 # define XXH3_128bits_withSeed XXH3_128bits_withSeed_dispatch
 # undef  XXH3_128bits_withSecret
 # define XXH3_128bits_withSecret XXH3_128bits_withSecret_dispatch
+# undef  XXH3_128bits_withSecretandSeed
+# define XXH3_128bits_withSecretandSeed XXH3_128bits_withSecretandSeed_dispatch
+# undef  XXH3_128bits_withSeededContext
+# define XXH3_128bits_withSeededContext XXH3_128bits_withSeededContext_dispatch
 # undef  XXH3_128bits_update
 # define XXH3_128bits_update XXH3_128bits_update_dispatch
+# undef  XXH3_128bits_copy
+# define XXH3_128bits_copy XXH3_128bits_copy_dispatch
+# undef  XXH3_128bits_update_copy
+# define XXH3_128bits_update_copy XXH3_128bits_update_copy_dispatch
+# undef  XXH3_128bits_cstr
+# define XXH3_128bits_cstr XXH3_128bits_cstr_dispatch
+# undef  XXH3_128bits_cstr_withSeed
+# define XXH3_128bits_cstr_withSeed XXH3_128bits_cstr_withSeed_dispatch
+# undef  XXH3_128bits_lowercase
+# define XXH3_128bits_lowercase XXH3_128bits_lowercase_dispatch
+# undef  XXH3_128bits_lowercase_withSeed
+# define XXH3_128bits_lowercase_withSeed XXH3_128bits_lowercase_withSeed_dispatch
+# undef  XXH3_128bits_update_lowercase
+# define XXH3_128bits_update_lowercase XXH3_128bits_update_lowercase_dispatch
+# undef  XXH3_128bits_vec
+# define XXH3_128bits_vec XXH3_128bits_vec_dispatch
+# undef  XXH3_128bits_withSeed_vec
+# define XXH3_128bits_withSeed_vec XXH3_128bits_withSeed_vec_dispatch
+# undef  XXH3_128bits_tree
+# define XXH3_128bits_tree XXH3_128bits_tree_dispatch
+# undef  XXH3_128bits_tree_update
+# define XXH3_128bits_tree_update XXH3_128bits_tree_update_dispatch
+# undef  XXH3_merkle_build
+# define XXH3_merkle_build XXH3_merkle_build_dispatch
+# undef  XXH3_merkle_append
+# define XXH3_merkle_append XXH3_merkle_append_dispatch
+# undef  XXH3_merkle_updateLeaf
+# define XXH3_merkle_updateLeaf XXH3_merkle_updateLeaf_dispatch
+# undef  XXH3_merkle_updateLeaves
+# define XXH3_merkle_updateLeaves XXH3_merkle_updateLeaves_dispatch
+# undef  XXH3_set_add
+# define XXH3_set_add XXH3_set_add_dispatch
+# undef  XXH3_set_remove
+# define XXH3_set_remove XXH3_set_remove_dispatch
+# undef  XXH3_set_addBatch
+# define XXH3_set_addBatch XXH3_set_addBatch_dispatch
+# undef  XXH3_set_addGather
+# define XXH3_set_addGather XXH3_set_addGather_dispatch
+
+# undef  XXH3_dual
+# define XXH3_dual XXH3_dual_dispatch
+# undef  XXH3_dual_withSeed
+# define XXH3_dual_withSeed XXH3_dual_withSeed_dispatch
+# undef  XXH3_dual_update
+# define XXH3_dual_update XXH3_dual_update_dispatch
+
+# undef  XXH32
+# define XXH32 XXH32_dispatch
+# undef  XXH32_update
+# define XXH32_update XXH32_update_dispatch
+# undef  XXH32_batch
+# define XXH32_batch XXH32_batch_dispatch
+# undef  XXH32_lanes_update
+# define XXH32_lanes_update XXH32_lanes_update_dispatch
+# undef  XXH64_batch
+# define XXH64_batch XXH64_batch_dispatch
+# undef  XXH64_lanes_update
+# define XXH64_lanes_update XXH64_lanes_update_dispatch
 
 #endif /* XXH_DISPATCH_DISABLE_REPLACE */
 
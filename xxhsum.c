@@ -129,6 +129,17 @@ static __inline int IS_CONSOLE(FILE* stdStream) {
 #  define S_ISREG(x) (((x) & S_IFMT) == S_IFREG)
 #endif
 
+/* SEEK_DATA and SEEK_HOLE let xxhsum skip the holes of sparse files */
+#if (PLATFORM_POSIX_VERSION >= 200112L) && defined(__linux__) && !defined(SEEK_DATA)
+#  define SEEK_DATA 3   /* hidden by _POSIX_C_SOURCE, supported since Linux 3.1 */
+#  define SEEK_HOLE 4
+#endif
+#if (PLATFORM_POSIX_VERSION >= 200112L) && defined(SEEK_DATA) && defined(SEEK_HOLE)
+#  define XSUM_SPARSE_FILES 1
+#else
+#  define XSUM_SPARSE_FILES 0
+#endif
+
 /* Unicode helpers for Windows to make UTF-8 act as it should. */
 #ifdef _WIN32
 /*
@@ -953,6 +964,13 @@ static void BMK_testXXH32(const void* data, size_t len, U32 seed, U32 Nresult)
     (void)XXH32_update(state, data, len);
     BMK_checkResult32(XXH32_digest(state), Nresult);
 
+    if (len>0) {   /* first byte buffered, then the rest */
+        (void)XXH32_reset(state, seed);
+        (void)XXH32_update(state, data, 1);
+        (void)XXH32_update(state, ((const char*)data)+1, len-1);
+        BMK_checkResult32(XXH32_digest(state), Nresult);
+    }
+
     (void)XXH32_reset(state, seed);
     for (pos=0; pos<len; pos++)
         (void)XXH32_update(state, ((const char*)data)+pos, 1);
@@ -1003,6 +1021,18 @@ void BMK_testXXH3(const void* data, size_t len, U64 seed, U64 Nresult)
         BMK_checkResult64(Dresult, Nresult);
     }
 
+    /* check that a seeded context produces same result as the seed */
+    {   XXH3_seededContext_t ctx;
+        XXH3_state_t* const state = XXH3_createState();
+        assert(state != NULL);
+        (void)XXH3_initSeededContext(&ctx, seed);
+        BMK_checkResult64(XXH3_64bits_withSeededContext(data, len, &ctx), Nresult);
+        (void)XXH3_64bits_reset_withSeededContext(state, &ctx);
+        (void)XXH3_64bits_update(state, data, len);
+        BMK_checkResult64(XXH3_64bits_digest(state), Nresult);
+        XXH3_freeState(state);
+    }
+
     /* streaming API test */
     {   XXH3_state_t* const state = XXH3_createState();
         assert(state != NULL);
@@ -1074,6 +1104,91 @@ void BMK_testXXH3_withSecret(const void* data, size_t len, const void* secret, s
     }
 }
 
+/* compares the secret and seed variants against XXH3_*_withSeed() and XXH3_*_withSecret() */
+void BMK_testXXH3_withSecretandSeed(const void* data, size_t len, const void* secret, size_t secretSize, U64 seed)
+{
+    int const useSeed = (len <= 240);  /* XXH3_MIDSIZE_MAX */
+    U64 const Nresult = useSeed ? XXH3_64bits_withSeed(data, len, seed)
+                                : XXH3_64bits_withSecret(data, len, secret, secretSize);
+    XXH128_hash_t const Nresult128 = useSeed ? XXH3_128bits_withSeed(data, len, seed)
+                                             : XXH3_128bits_withSecret(data, len, secret, secretSize);
+    if (len>0) assert(data != NULL);
+
+    BMK_checkResult64(XXH3_64bits_withSecretandSeed(data, len, secret, secretSize, seed), Nresult);
+    BMK_checkResult128(XXH3_128bits_withSecretandSeed(data, len, secret, secretSize, seed), Nresult128);
+
+    /* streaming API test */
+    {   XXH3_state_t* const state = XXH3_createState();
+        assert(state != NULL);
+        (void)XXH3_64bits_reset_withSecretandSeed(state, secret, secretSize, seed);
+        (void)XXH3_64bits_update(state, data, len);
+        BMK_checkResult64(XXH3_64bits_digest(state), Nresult);
+
+        /* random ingestion */
+        {   size_t p = 0;
+            (void)XXH3_128bits_reset_withSecretandSeed(state, secret, secretSize, seed);
+            while (p < len) {
+                size_t const modulo = len > 2 ? len : 2;
+                size_t l = (size_t)(BMK_rand()) % modulo;
+                if (p + l > len) l = len - p;
+                (void)XXH3_128bits_update(state, (const char*)data+p, l);
+                p += l;
+            }
+            BMK_checkResult128(XXH3_128bits_digest(state), Nresult128);
+        }
+        XXH3_freeState(state);
+    }
+}
+
+#define BATCH_NBKEYS_MAX 9
+
+/* compares the batch API against one XXH3_64bits_withSeed() per key */
+void BMK_testXXH3_batch(const void* keys, size_t keySize, size_t nbKeys, U64 seed)
+{
+    U64 hashes[BATCH_NBKEYS_MAX];
+    size_t n;
+    assert(nbKeys <= BATCH_NBKEYS_MAX);
+    if (keySize * nbKeys > 0) assert(keys != NULL);
+
+    XXH3_64bits_withSeed_batch(hashes, keys, keySize, nbKeys, seed);
+    for (n = 0; n < nbKeys; n++) {
+        U64 const Nresult = XXH3_64bits_withSeed((const U8*)keys + n*keySize, keySize, seed);
+        BMK_checkResult64(hashes[n], Nresult);
+    }
+
+    /* check that the no-seed variant produces same result as seed==0 */
+    if (seed == 0) {
+        XXH3_64bits_batch(hashes, keys, keySize, nbKeys);
+        for (n = 0; n < nbKeys; n++) {
+            U64 const Nresult = XXH3_64bits((const U8*)keys + n*keySize, keySize);
+            BMK_checkResult64(hashes[n], Nresult);
+    }   }
+}
+
+#define GATHER_NBKEYS 40
+
+/* compares the gather API against one XXH3_64bits_withSeed() per key */
+void BMK_testXXH3_gather(const void* const* keys, const size_t* lengths, size_t nbKeys, U64 seed)
+{
+    U64 hashes[GATHER_NBKEYS];
+    size_t n;
+    assert(nbKeys <= GATHER_NBKEYS);
+
+    XXH3_64bits_withSeed_gather(hashes, keys, lengths, nbKeys, seed);
+    for (n = 0; n < nbKeys; n++) {
+        U64 const Nresult = XXH3_64bits_withSeed(keys[n], lengths[n], seed);
+        BMK_checkResult64(hashes[n], Nresult);
+    }
+
+    /* check that the no-seed variant produces same result as seed==0 */
+    if (seed == 0) {
+        XXH3_64bits_gather(hashes, keys, lengths, nbKeys);
+        for (n = 0; n < nbKeys; n++) {
+            U64 const Nresult = XXH3_64bits(keys[n], lengths[n]);
+            BMK_checkResult64(hashes[n], Nresult);
+    }   }
+}
+
 void BMK_testXXH128(const void* data, size_t len, U64 seed, XXH128_hash_t Nresult)
 {
     {   XXH128_hash_t const Dresult = XXH3_128bits_withSeed(data, len, seed);
@@ -1091,6 +1206,18 @@ void BMK_testXXH128(const void* data, size_t len, U64 seed, XXH128_hash_t Nresul
         BMK_checkResult128(Dresult, Nresult);
     }
 
+    /* check that a seeded context produces same result as the seed */
+    {   XXH3_seededContext_t ctx;
+        XXH3_state_t* const state = XXH3_createState();
+        assert(state != NULL);
+        (void)XXH3_initSeededContext(&ctx, seed);
+        BMK_checkResult128(XXH3_128bits_withSeededContext(data, len, &ctx), Nresult);
+        (void)XXH3_128bits_reset_withSeededContext(state, &ctx);
+        (void)XXH3_128bits_update(state, data, len);
+        BMK_checkResult128(XXH3_128bits_digest(state), Nresult);
+        XXH3_freeState(state);
+    }
+
     /* streaming API test */
     {   XXH3_state_t *state = XXH3_createState();
         assert(state != NULL);
@@ -1163,6 +1290,1031 @@ void BMK_testXXH128_withSecret(const void* data, size_t len, const void* secret,
     }
 }
 
+/* XXH3-T, computed leaf by leaf as described in doc/xxhash_spec.md */
+static XXH128_hash_t BMK_XXH3_tree_reference(const U8* data, size_t len, U64 seed)
+{
+    XXH3_state_t* const root = XXH3_createState();
+    U8 footer[16];
+    size_t pos = 0;
+    int i;
+    assert(root != NULL);
+    (void)XXH3_128bits_reset_withSeed(root, seed);
+    while (pos < len) {
+        size_t const leafSize = (len - pos < XXH3_TREE_LEAF_SIZE) ? len - pos : XXH3_TREE_LEAF_SIZE;
+        XXH128_canonical_t digest;
+        XXH128_canonicalFromHash(&digest, XXH3_128bits_withSeed(data + pos, leafSize, seed));
+        (void)XXH3_128bits_update(root, &digest, sizeof(digest));
+        pos += leafSize;
+    }
+    for (i = 0; i < 8; i++) {
+        footer[i]     = (U8)((U64)len >> (8*i));
+        footer[8 + i] = (U8)((U64)XXH3_TREE_LEAF_SIZE >> (8*i));
+    }
+    (void)XXH3_128bits_update(root, footer, sizeof(footer));
+    {   XXH128_hash_t const h128 = XXH3_128bits_digest(root);
+        XXH3_freeState(root);
+        return h128;
+    }
+}
+
+/* runs jobs backwards, and counts calls into `poolCtx` */
+static void BMK_reverseParallelFor(void* poolCtx, XXH3_treeJob_f job, void* jobCtx, size_t nbJobs)
+{
+    (*(unsigned*)poolCtx)++;
+    while (nbJobs > 0) {
+        nbJobs--;
+        job(jobCtx, nbJobs);
+    }
+}
+
+void BMK_testXXH3_tree(const void* data, size_t len, U64 seed, XXH128_hash_t Nresult)
+{
+    unsigned nbPoolCalls = 0;
+    XXH3_treePool_t callerPool;
+    XXH3_treePool_t threadPool;
+    callerPool.parallelFor = BMK_reverseParallelFor;
+    callerPool.poolCtx = &nbPoolCalls;
+    callerPool.nbThreads = 0;
+    threadPool.parallelFor = NULL;
+    threadPool.poolCtx = NULL;
+    threadPool.nbThreads = 4;
+    if (len>0) assert(data != NULL);
+
+    BMK_checkResult128(BMK_XXH3_tree_reference((const U8*)data, len, seed), Nresult);
+    BMK_checkResult128(XXH3_128bits_tree(data, len, seed, NULL), Nresult);
+    BMK_checkResult128(XXH3_128bits_tree(data, len, seed, &threadPool), Nresult);
+    BMK_checkResult128(XXH3_128bits_tree(data, len, seed, &callerPool), Nresult);
+    if (len >= 2 * XXH3_TREE_LEAF_SIZE) assert(nbPoolCalls > 0);
+
+    /* streaming API test */
+    {   XXH3_treeState_t* const state = XXH3_createTreeState();
+        assert(state != NULL);
+        (void)XXH3_128bits_tree_reset(state, seed, &callerPool);
+        (void)XXH3_128bits_tree_update(state, data, len);
+        BMK_checkResult128(XXH3_128bits_tree_digest(state), Nresult);
+
+        /* random ingestion, across leaf boundaries */
+        {   size_t p = 0;
+            (void)XXH3_128bits_tree_reset(state, seed, &threadPool);
+            while (p < len) {
+                size_t l = (size_t)(BMK_rand()) % (2 * XXH3_TREE_LEAF_SIZE);
+                if (p + l > len) l = len - p;
+                (void)XXH3_128bits_tree_update(state, (const char*)data+p, l);
+                p += l;
+            }
+            BMK_checkResult128(XXH3_128bits_tree_digest(state), Nresult);
+        }
+        XXH3_freeTreeState(state);
+    }
+}
+
+/* Merkle tree hash of leaves [first, last), computed recursively as in RFC 6962 */
+static XXH128_hash_t BMK_merkle_reference(const U8* data, size_t len, size_t leafSize,
+                                          size_t first, size_t last, U64 seed)
+{
+    if (last - first == 1) {
+        size_t const start = first * leafSize;
+        size_t const leafLen = (len - start < leafSize) ? len - start : leafSize;
+        return XXH3_128bits_withSeed(data + start, leafLen, seed);
+    }
+    {   size_t split = 1;
+        XXH128_canonical_t pair[2];
+        while (2 * split < last - first) split *= 2;
+        XXH128_canonicalFromHash(&pair[0], BMK_merkle_reference(data, len, leafSize, first, first + split, seed));
+        XXH128_canonicalFromHash(&pair[1], BMK_merkle_reference(data, len, leafSize, first + split, last, seed));
+        return XXH3_128bits_withSeed(pair, sizeof(pair), seed ^ 0x9E3779B185EBCA87ULL);
+    }
+}
+
+#define MERKLE_NBLEAVES_MAX 40
+
+/* compares build, append and updates against the reference, for every prefix of `data` */
+void BMK_testXXH3_merkle(U8* data, size_t len, size_t leafSize, U64 seed, XXH128_hash_t Nresult)
+{
+    XXH128_canonical_t nodes[XXH3_MERKLE_NB_NODES(MERKLE_NBLEAVES_MAX)];
+    size_t const nbLeaves = (len + leafSize - 1) / leafSize;
+    XXH3_merkle_t tree;
+    size_t n;
+    assert(nbLeaves <= MERKLE_NBLEAVES_MAX);
+
+    (void)XXH3_merkle_init(&tree, nodes, XXH3_MERKLE_NB_NODES(nbLeaves), 0, leafSize, seed);
+    (void)XXH3_merkle_build(&tree, data, len);
+    BMK_checkResult128(XXH3_merkle_root(&tree), Nresult);
+    if (nbLeaves > 0) BMK_checkResult128(BMK_merkle_reference(data, len, leafSize, 0, nbLeaves, seed), Nresult);
+
+    /* append, leaf by leaf */
+    (void)XXH3_merkle_init(&tree, nodes, XXH3_MERKLE_NB_NODES(nbLeaves), 0, leafSize, seed);
+    BMK_checkResult128(XXH3_merkle_root(&tree), XXH3_128bits_withSeed(NULL, 0, seed));
+    for (n = 0; n < nbLeaves; n++) {
+        size_t const leafLen = (len - n*leafSize < leafSize) ? len - n*leafSize : leafSize;
+        (void)XXH3_merkle_append(&tree, data + n*leafSize, leafLen);
+        BMK_checkResult128(XXH3_merkle_root(&tree),
+                           BMK_merkle_reference(data, n*leafSize + leafLen, leafSize, 0, n+1, seed));
+    }
+    BMK_checkResult128(XXH3_merkle_root(&tree), Nresult);
+    if (XXH3_merkle_append(&tree, data, leafSize) != XXH_ERROR) BMK_checkResult128(XXH3_merkle_root(&tree), Nresult);
+
+    /* the nodes can be reopened as is */
+    (void)XXH3_merkle_init(&tree, nodes, XXH3_MERKLE_NB_NODES(nbLeaves), nbLeaves, leafSize, seed);
+    BMK_checkResult128(XXH3_merkle_root(&tree), Nresult);
+
+    /* a failed build leaves the tree as it was */
+    if (nbLeaves > 1) {
+        if (XXH3_merkle_build(&tree, NULL, leafSize) != XXH_ERROR) {
+            DISPLAY("\rError: XXH3_merkle_build accepted NULL data \n");
+            exit(1);
+        }
+        BMK_checkResult128(XXH3_merkle_root(&tree), Nresult);
+    }
+
+    /* modify each leaf in place, then 3 consecutive leaves at once */
+    for (n = 0; n < nbLeaves; n++) {
+        size_t const leafLen = (len - n*leafSize < leafSize) ? len - n*leafSize : leafSize;
+        data[n*leafSize] ^= 0x5A;
+        (void)XXH3_merkle_updateLeaf(&tree, n, data + n*leafSize, leafLen);
+        BMK_checkResult128(XXH3_merkle_root(&tree), BMK_merkle_reference(data, len, leafSize, 0, nbLeaves, seed));
+        data[n*leafSize] ^= 0x5A;
+        (void)XXH3_merkle_updateLeaf(&tree, n, data + n*leafSize, leafLen);
+    }
+    BMK_checkResult128(XXH3_merkle_root(&tree), Nresult);
+    if (nbLeaves >= 4) {
+        size_t const first = nbLeaves - 4;
+        data[first*leafSize] ^= 0x5A;
+        data[(first+2)*leafSize] ^= 0x5A;
+        (void)XXH3_merkle_updateLeaves(&tree, first, data + first*leafSize, len - first*leafSize);
+        BMK_checkResult128(XXH3_merkle_root(&tree), BMK_merkle_reference(data, len, leafSize, 0, nbLeaves, seed));
+        data[first*leafSize] ^= 0x5A;
+        data[(first+2)*leafSize] ^= 0x5A;
+        (void)XXH3_merkle_updateLeaves(&tree, first, data + first*leafSize, 3*leafSize);
+        BMK_checkResult128(XXH3_merkle_root(&tree), BMK_merkle_reference(data, len, leafSize, 0, nbLeaves, seed));
+        (void)XXH3_merkle_updateLeaf(&tree, nbLeaves-1, data + (nbLeaves-1)*leafSize, len - (nbLeaves-1)*leafSize);
+        BMK_checkResult128(XXH3_merkle_root(&tree), Nresult);
+    }
+}
+
+/* the copy variants must return the same hash as XXH3, and an exact copy of `src` */
+void BMK_testXXH3_copy(const U8* src, size_t len, U8* dst)
+{
+    XXH64_hash_t const Dresult = XXH3_64bits(src, len);
+    XXH128_hash_t const Nresult = XXH3_128bits(src, len);
+    XXH3_copyMode_e const modes[2] = { XXH3_copy_cached, XXH3_copy_nonTemporal };
+    int m;
+
+    for (m = 0; m < 2; m++) {
+        memset(dst, 0, len);
+        BMK_checkResult64(XXH3_64bits_copy(dst, src, len, modes[m]), Dresult);
+        BMK_checkResult64(XXH3_64bits(dst, len), Dresult);   /* dst is a copy of src */
+        memset(dst, 0, len);
+        BMK_checkResult128(XXH3_128bits_copy(dst, src, len, modes[m]), Nresult);
+        BMK_checkResult64(XXH3_64bits(dst, len), Dresult);
+
+        /* streaming, in segments of varying sizes */
+        {   XXH3_state_t* const state = XXH3_createState();
+            size_t pos, segSize = 1;
+            assert(state != NULL);
+            memset(dst, 0, len);
+            (void)XXH3_64bits_reset(state);
+            for (pos = 0; pos < len; pos += segSize, segSize = segSize * 7 + 3) {
+                size_t const n = (len - pos < segSize) ? len - pos : segSize;
+                (void)XXH3_64bits_update_copy(state, dst + pos, src + pos, n, modes[m]);
+            }
+            BMK_checkResult64(XXH3_64bits_digest(state), Dresult);
+            BMK_checkResult64(XXH3_64bits(dst, len), Dresult);
+            memset(dst, 0, len);
+            (void)XXH3_128bits_reset(state);
+            (void)XXH3_128bits_update_copy(state, dst, src, len, modes[m]);
+            BMK_checkResult128(XXH3_128bits_digest(state), Nresult);
+            BMK_checkResult64(XXH3_64bits(dst, len), Dresult);
+            XXH3_freeState(state);
+    }   }
+}
+
+#define VEC_NBFRAGS_MAX 64
+
+/* hashes `data` cut into fragments of `fragSizes[]`, repeated, and compares with XXH3 on the whole */
+static void BMK_testXXH3_vecCuts(const U8* data, size_t len, U64 seed, const size_t* fragSizes, size_t nbSizes)
+{
+    XXH3_iovec_t iov[VEC_NBFRAGS_MAX];
+    size_t iovcnt = 0, pos = 0;
+    while (pos < len || iovcnt == 0) {
+        size_t const size = (len - pos < fragSizes[iovcnt % nbSizes]) ? len - pos : fragSizes[iovcnt % nbSizes];
+        assert(iovcnt < VEC_NBFRAGS_MAX - 1);
+        iov[iovcnt].ptr = data + pos;
+        iov[iovcnt].len = (iovcnt == VEC_NBFRAGS_MAX - 2) ? len - pos : size;
+        pos += iov[iovcnt].len;
+        iovcnt++;
+    }
+    iov[iovcnt].ptr = NULL;   /* trailing empty fragment */
+    iov[iovcnt].len = 0;
+    iovcnt++;
+
+    BMK_checkResult64(XXH3_64bits_withSeed_vec(iov, iovcnt, seed), XXH3_64bits_withSeed(data, len, seed));
+    BMK_checkResult128(XXH3_128bits_withSeed_vec(iov, iovcnt, seed), XXH3_128bits_withSeed(data, len, seed));
+    if (seed == 0) {
+        BMK_checkResult64(XXH3_64bits_vec(iov, iovcnt), XXH3_64bits(data, len));
+        BMK_checkResult128(XXH3_128bits_vec(iov, iovcnt), XXH3_128bits(data, len));
+    }
+}
+
+/* a single fragment, fragments straddling stripes and blocks, and a short last fragment */
+void BMK_testXXH3_vec(const U8* data, size_t len, U64 seed)
+{
+    static const size_t whole[] = { (size_t)-1 };
+    static const size_t uneven[] = { 0, 1, 63, 7, 64, 130, 1000, 5 };
+    static const size_t wide[] = { 1500, 3 };
+    BMK_checkResult64(XXH3_64bits_withSeed_vec(NULL, 0, seed), XXH3_64bits_withSeed(NULL, 0, seed));
+    BMK_testXXH3_vecCuts(data, len, seed, whole, 1);
+    BMK_testXXH3_vecCuts(data, len, seed, uneven, sizeof(uneven) / sizeof(uneven[0]));
+    BMK_testXXH3_vecCuts(data, len, seed, wide, sizeof(wide) / sizeof(wide[0]));
+}
+
+/* updateZeros() must be indistinguishable from update() on zeros, before and after more input */
+void BMK_testXXH3_updateZeros(const U8* data, size_t prefixLen, const U8* zeros, size_t nbZeros, U64 seed)
+{
+    XXH3_state_t* const ref = XXH3_createState();
+    XXH3_state_t* const state = XXH3_createState();
+    assert(ref != NULL && state != NULL);
+    /* the states are compared as a whole, stale buffer content included */
+    memset(ref, 0, sizeof(*ref));
+    memset(state, 0, sizeof(*state));
+
+    (void)XXH3_64bits_reset_withSeed(ref, seed);
+    (void)XXH3_64bits_reset_withSeed(state, seed);
+    (void)XXH3_64bits_update(ref, data, prefixLen);
+    (void)XXH3_64bits_update(state, data, prefixLen);
+    (void)XXH3_64bits_update(ref, zeros, nbZeros);
+    (void)XXH3_64bits_updateZeros(state, nbZeros);
+    if (memcmp(state, ref, sizeof(*state))) {
+        DISPLAY("\rError: XXH3 state differs after %u zeros (prefix %u) \n", (unsigned)nbZeros, (unsigned)prefixLen);
+        exit(1);
+    }
+    BMK_checkResult64(XXH3_64bits_digest(state), XXH3_64bits_digest(ref));
+    (void)XXH3_64bits_update(ref, data, 17);
+    (void)XXH3_64bits_update(state, data, 17);
+    BMK_checkResult64(XXH3_64bits_digest(state), XXH3_64bits_digest(ref));
+
+    (void)XXH3_128bits_reset_withSeed(ref, seed);
+    (void)XXH3_128bits_reset_withSeed(state, seed);
+    (void)XXH3_128bits_update(ref, data, prefixLen);
+    (void)XXH3_128bits_update(state, data, prefixLen);
+    (void)XXH3_128bits_update(ref, zeros, nbZeros);
+    (void)XXH3_128bits_updateZeros(state, nbZeros);
+    if (memcmp(state, ref, sizeof(*state))) {
+        DISPLAY("\rError: XXH3 state differs after %u zeros (prefix %u) \n", (unsigned)nbZeros, (unsigned)prefixLen);
+        exit(1);
+    }
+    BMK_checkResult128(XXH3_128bits_digest(state), XXH3_128bits_digest(ref));
+    (void)XXH3_128bits_update(ref, data, 17);
+    (void)XXH3_128bits_update(state, data, 17);
+    BMK_checkResult128(XXH3_128bits_digest(state), XXH3_128bits_digest(ref));
+
+    XXH3_freeState(state);
+    XXH3_freeState(ref);
+}
+
+#define SEEDS_NB 19
+
+/* compares the multi-seed API against one XXH3_64bits_withSeed() per seed */
+void BMK_testXXH3_withSeeds(const void* data, size_t len)
+{
+    U64 seeds[SEEDS_NB];
+    U64 hashes[SEEDS_NB];
+    size_t nbSeeds, n;
+
+    /* seed 0 takes the default secret, repeated seeds must not interfere */
+    seeds[0] = 0;
+    seeds[1] = PRIME64;
+    seeds[2] = PRIME64;
+    for (n = 3; n < SEEDS_NB; n++) seeds[n] = seeds[n-1] * PRIME32 + n;
+
+    /* partial groups, one group, and several groups */
+    for (nbSeeds = 0; nbSeeds <= SEEDS_NB; nbSeeds += (nbSeeds < 9) ? 1 : SEEDS_NB - 9) {
+        XXH3_64bits_withSeeds(hashes, data, len, seeds, nbSeeds);
+        for (n = 0; n < nbSeeds; n++) {
+            BMK_checkResult64(hashes[n], XXH3_64bits_withSeed(data, len, seeds[n]));
+    }   }
+}
+
+/* compares the dual-width API against XXH3_64bits_withSeed() and XXH3_128bits_withSeed() */
+void BMK_testXXH3_dual(const void* data, size_t len, U64 seed)
+{
+    U64 const Nresult64 = XXH3_64bits_withSeed(data, len, seed);
+    XXH128_hash_t const Nresult128 = XXH3_128bits_withSeed(data, len, seed);
+
+    {   XXH3_dualHash_t const h = XXH3_dual_withSeed(data, len, seed);
+        BMK_checkResult64(h.h64, Nresult64);
+        BMK_checkResult128(h.h128, Nresult128);
+    }
+    if (seed == 0) {
+        XXH3_dualHash_t const h = XXH3_dual(data, len);
+        BMK_checkResult64(h.h64, Nresult64);
+        BMK_checkResult128(h.h128, Nresult128);
+    }
+
+    /* streaming, in segments of varying sizes, digesting along the way */
+    {   XXH3_dualState_t* const state = XXH3_createDualState();
+        size_t pos = 0, segment = 1;
+        assert(state != NULL);
+        if (seed == 0) (void)XXH3_dual_reset(state);
+        else (void)XXH3_dual_reset_withSeed(state, seed);
+        while (pos < len) {
+            size_t const chunk = (segment < len - pos) ? segment : len - pos;
+            (void)XXH3_dual_update(state, (const U8*)data + pos, chunk);
+            pos += chunk;
+            segment = segment * 3 + 7;
+            {   XXH3_dualHash_t const h = XXH3_dual_digest(state);
+                BMK_checkResult64(h.h64, XXH3_64bits_withSeed(data, pos, seed));
+                BMK_checkResult128(h.h128, XXH3_128bits_withSeed(data, pos, seed));
+        }   }
+        {   XXH3_dualHash_t const h = XXH3_dual_digest(state);
+            BMK_checkResult64(h.h64, Nresult64);
+            BMK_checkResult128(h.h128, Nresult128);
+        }
+        XXH3_freeDualState(state);
+    }
+}
+
+/* resets @state as the test case requires: seed, external secret, or default */
+static void BMK_resetXXH3(XXH3_state_t* state, int is128, U64 seed, const void* secret, size_t secretSize)
+{
+    if (secret != NULL) {
+        if (is128) (void)XXH3_128bits_reset_withSecret(state, secret, secretSize);
+        else (void)XXH3_64bits_reset_withSecret(state, secret, secretSize);
+    } else if (seed != 0) {
+        if (is128) (void)XXH3_128bits_reset_withSeed(state, seed);
+        else (void)XXH3_64bits_reset_withSeed(state, seed);
+    } else {
+        if (is128) (void)XXH3_128bits_reset(state);
+        else (void)XXH3_64bits_reset(state);
+    }
+}
+
+/* tells whether @state was left as filled with 0xA5 */
+static int BMK_isUntouched(const XXH3_state_t* state)
+{
+    const U8* const p = (const U8*)state;
+    size_t i;
+    for (i = 0; i < sizeof(*state); i++) if (p[i] != 0xA5) return 0;
+    return 1;
+}
+
+/* packs a stream after @splitPos bytes, unpacks it into another state, and finishes there */
+void BMK_testXXH3_packState(const U8* data, size_t len, size_t splitPos, U64 seed, const void* secret, size_t secretSize)
+{
+    XXH3_state_t* const state = XXH3_createState();
+    XXH3_state_t* const resumed = XXH3_createState();
+    U8 packed[XXH3_PACKEDSTATE_SIZE_MAX];
+    U8 corrupted[XXH3_PACKEDSTATE_SIZE_MAX];
+    size_t const nbStripesPerBlock = ((secret != NULL ? secretSize : XXH3_SECRET_DEFAULT_SIZE) - 64) / 8;
+    size_t i;
+    int is128;
+    assert(state != NULL && resumed != NULL);
+    assert(splitPos <= len);
+
+    for (is128 = 0; is128 <= 1; is128++) {
+        size_t packedSize;
+        BMK_resetXXH3(state, is128, seed, secret, secretSize);
+        (void)(is128 ? XXH3_128bits_update(state, data, splitPos) : XXH3_64bits_update(state, data, splitPos));
+        packedSize = is128 ? XXH3_128bits_packState(packed, sizeof(packed), state)
+                           : XXH3_64bits_packState(packed, sizeof(packed), state);
+        if ( packedSize != ((splitPos > 240) ? 156 : 28 + splitPos)
+          || (is128 ? XXH3_128bits_packState(packed, packedSize - 1, state)
+                    : XXH3_64bits_packState(packed, packedSize - 1, state)) != 0
+          /* the secret must be provided exactly when the state references one */
+          || XXH3_unpackState(resumed, packed, packedSize, (secret != NULL) ? NULL : data, 136) != XXH_ERROR ) {
+            DISPLAY("\rError: XXH3 packed state of %u bytes is invalid (split at %u) \n",
+                    (unsigned)packedSize, (unsigned)splitPos);
+            exit(1);
+        }
+
+        /* a state with a full block of stripes is rejected, without touching the destination */
+        memset(resumed, 0xA5, sizeof(*resumed));
+        memcpy(corrupted, packed, packedSize);
+        for (i = 0; i < 4; i++) corrupted[4 + i] = (U8)(nbStripesPerBlock >> (8 * i));
+        if ( XXH3_unpackState(resumed, corrupted, packedSize, secret, secretSize) != XXH_ERROR
+          || XXH3_unpackState(resumed, packed, packedSize - 1, secret, secretSize) != XXH_ERROR
+          || !BMK_isUntouched(resumed) ) {
+            DISPLAY("\rError: XXH3_unpackState accepted an invalid state (split at %u) \n", (unsigned)splitPos);
+            exit(1);
+        }
+
+        if (XXH3_unpackState(resumed, packed, packedSize, secret, secretSize) != XXH_OK) {
+            DISPLAY("\rError: XXH3_unpackState failed (split at %u) \n", (unsigned)splitPos);
+            exit(1);
+        }
+        if (is128) {
+            BMK_checkResult128(XXH3_128bits_digest(resumed), XXH3_128bits_digest(state));
+            (void)XXH3_128bits_update(resumed, data + splitPos, len - splitPos);
+            BMK_checkResult128(XXH3_128bits_digest(resumed),
+                               secret ? XXH3_128bits_withSecret(data, len, secret, secretSize)
+                                      : XXH3_128bits_withSeed(data, len, seed));
+        } else {
+            BMK_checkResult64(XXH3_64bits_digest(resumed), XXH3_64bits_digest(state));
+            (void)XXH3_64bits_update(resumed, data + splitPos, len - splitPos);
+            BMK_checkResult64(XXH3_64bits_digest(resumed),
+                              secret ? XXH3_64bits_withSecret(data, len, secret, secretSize)
+                                     : XXH3_64bits_withSeed(data, len, seed));
+        }
+    }
+    XXH3_freeState(resumed);
+    XXH3_freeState(state);
+}
+
+/* saves XXH32 and XXH64 streams after @splitPos bytes, and finishes them from the saved states */
+void BMK_testXXH_saveState(const U8* data, size_t len, size_t splitPos, U64 seed)
+{
+    XXH32_state_t state32, resumed32;
+    XXH64_state_t state64, resumed64;
+    U8 saved[XXH64_SAVEDSTATE_SIZE];
+    assert(splitPos <= len);
+
+    (void)XXH32_reset(&state32, (U32)seed);
+    (void)XXH32_update(&state32, data, splitPos);
+    if ( XXH32_saveState(saved, XXH32_SAVEDSTATE_SIZE - 1, &state32) != 0
+      || XXH32_saveState(saved, sizeof(saved), NULL) != 0
+      || XXH32_saveState(saved, sizeof(saved), &state32) != XXH32_SAVEDSTATE_SIZE
+      || XXH64_loadState(&resumed64, saved, XXH64_SAVEDSTATE_SIZE) != XXH_ERROR
+      || XXH32_loadState(&resumed32, saved, XXH32_SAVEDSTATE_SIZE) != XXH_OK ) {
+        DISPLAY("\rError: XXH32 saved state is invalid (split at %u) \n", (unsigned)splitPos);
+        exit(1);
+    }
+    BMK_checkResult32(XXH32_digest(&resumed32), XXH32_digest(&state32));
+    (void)XXH32_update(&resumed32, data + splitPos, len - splitPos);
+    BMK_checkResult32(XXH32_digest(&resumed32), XXH32(data, len, (U32)seed));
+
+    (void)XXH64_reset(&state64, seed);
+    (void)XXH64_update(&state64, data, splitPos);
+    if ( XXH64_saveState(saved, XXH64_SAVEDSTATE_SIZE - 1, &state64) != 0
+      || XXH64_saveState(saved, sizeof(saved), NULL) != 0
+      || XXH64_saveState(saved, sizeof(saved), &state64) != XXH64_SAVEDSTATE_SIZE
+      || XXH32_loadState(&resumed32, saved, XXH32_SAVEDSTATE_SIZE) != XXH_ERROR
+      || XXH64_loadState(&resumed64, saved, XXH64_SAVEDSTATE_SIZE) != XXH_OK ) {
+        DISPLAY("\rError: XXH64 saved state is invalid (split at %u) \n", (unsigned)splitPos);
+        exit(1);
+    }
+    BMK_checkResult64(XXH64_digest(&resumed64), XXH64_digest(&state64));
+    (void)XXH64_update(&resumed64, data + splitPos, len - splitPos);
+    BMK_checkResult64(XXH64_digest(&resumed64), XXH64(data, len, seed));
+}
+
+/* saves an XXH3 stream after @splitPos bytes, loads it into another state, and finishes there */
+void BMK_testXXH3_saveState(const U8* data, size_t len, size_t splitPos, U64 seed, const void* secret, size_t secretSize)
+{
+    XXH3_state_t* const state = XXH3_createState();
+    XXH3_state_t* const resumed = XXH3_createState();
+    U8 saved[XXH3_SAVEDSTATE_SIZE_MAX];
+    U8 corrupted[XXH3_SAVEDSTATE_SIZE_MAX];
+    size_t const nbStripesPerBlock = ((secret != NULL ? secretSize : XXH3_SECRET_DEFAULT_SIZE) - 64) / 8;
+    size_t i;
+    int is128;
+    assert(state != NULL && resumed != NULL);
+    assert(splitPos <= len);
+
+    for (is128 = 0; is128 <= 1; is128++) {
+        size_t savedSize;
+        BMK_resetXXH3(state, is128, seed, secret, secretSize);
+        (void)(is128 ? XXH3_128bits_update(state, data, splitPos) : XXH3_64bits_update(state, data, splitPos));
+        savedSize = XXH3_saveState(saved, sizeof(saved), state);
+        if ( savedSize < 160 || savedSize > XXH3_SAVEDSTATE_SIZE_MAX
+          || XXH3_saveState(saved, savedSize - 1, state) != 0
+          || XXH3_saveState(saved, sizeof(saved), NULL) != 0
+          || XXH3_loadState(resumed, saved, savedSize - 1, secret, secretSize) != XXH_ERROR
+          /* the secret must be provided exactly when the state references one */
+          || XXH3_loadState(resumed, saved, savedSize, (secret != NULL) ? NULL : data, 136) != XXH_ERROR ) {
+            DISPLAY("\rError: XXH3 saved state of %u bytes is invalid (split at %u) \n",
+                    (unsigned)savedSize, (unsigned)splitPos);
+            exit(1);
+        }
+
+        /* a state with a full block of stripes is rejected, without touching the destination */
+        memset(resumed, 0xA5, sizeof(*resumed));
+        memcpy(corrupted, saved, savedSize);
+        for (i = 0; i < 4; i++) corrupted[8 + i] = (U8)(nbStripesPerBlock >> (8 * i));
+        if ( XXH3_loadState(resumed, corrupted, savedSize, secret, secretSize) != XXH_ERROR
+          || XXH3_loadState(resumed, saved, savedSize - 1, secret, secretSize) != XXH_ERROR
+          || !BMK_isUntouched(resumed) ) {
+            DISPLAY("\rError: XXH3_loadState accepted an invalid state (split at %u) \n", (unsigned)splitPos);
+            exit(1);
+        }
+
+        if (XXH3_loadState(resumed, saved, savedSize, secret, secretSize) != XXH_OK) {
+            DISPLAY("\rError: XXH3_loadState failed (split at %u) \n", (unsigned)splitPos);
+            exit(1);
+        }
+        if (is128) {
+            BMK_checkResult128(XXH3_128bits_digest(resumed), XXH3_128bits_digest(state));
+            (void)XXH3_128bits_update(resumed, data + splitPos, len - splitPos);
+            BMK_checkResult128(XXH3_128bits_digest(resumed),
+                               secret ? XXH3_128bits_withSecret(data, len, secret, secretSize)
+                                      : XXH3_128bits_withSeed(data, len, seed));
+        } else {
+            BMK_checkResult64(XXH3_64bits_digest(resumed), XXH3_64bits_digest(state));
+            (void)XXH3_64bits_update(resumed, data + splitPos, len - splitPos);
+            BMK_checkResult64(XXH3_64bits_digest(resumed),
+                              secret ? XXH3_64bits_withSecret(data, len, secret, secretSize)
+                                     : XXH3_64bits_withSeed(data, len, seed));
+        }
+    }
+    XXH3_freeState(resumed);
+    XXH3_freeState(state);
+}
+
+/* states initialized in caller-provided storage, at various alignments */
+void BMK_testStaticStates(const U8* data, size_t len)
+{
+    static U8 workspace[sizeof(XXH3_state_t) + 128 + 8];
+    size_t offset;
+
+    for (offset = 0; offset <= 8; offset += 3) {
+        U8* const ws = workspace + offset;
+        size_t const wsSize = sizeof(workspace) - offset;
+        XXH32_state_t* s32;
+        XXH64_state_t* s64;
+        XXH3_state_t* s3;
+
+        memset(workspace, 0xA5, sizeof(workspace));
+        s32 = XXH32_initStaticState(ws, wsSize);
+        if (s32 == NULL || (size_t)s32 % XXH32_alignofState() != 0) {
+            DISPLAY("\rError: XXH32_initStaticState failed (offset %u) \n", (unsigned)offset);
+            exit(1);
+        }
+        (void)XXH32_update(s32, data, len);
+        BMK_checkResult32(XXH32_digest(s32), XXH32(data, len, 0));
+
+        memset(workspace, 0xA5, sizeof(workspace));
+        s64 = XXH64_initStaticState(ws, wsSize);
+        if (s64 == NULL || (size_t)s64 % XXH64_alignofState() != 0) {
+            DISPLAY("\rError: XXH64_initStaticState failed (offset %u) \n", (unsigned)offset);
+            exit(1);
+        }
+        (void)XXH64_update(s64, data, len);
+        BMK_checkResult64(XXH64_digest(s64), XXH64(data, len, 0));
+
+        memset(workspace, 0xA5, sizeof(workspace));
+        s3 = XXH3_initStaticState(ws, wsSize);
+        if (s3 == NULL || (size_t)s3 % XXH3_alignofState() != 0) {
+            DISPLAY("\rError: XXH3_initStaticState failed (offset %u) \n", (unsigned)offset);
+            exit(1);
+        }
+        (void)XXH3_64bits_update(s3, data, len);
+        BMK_checkResult64(XXH3_64bits_digest(s3), XXH3_64bits(data, len));
+    }
+
+    /* too small, once aligned */
+    {   size_t const misalign = (0 - (size_t)workspace) % XXH3_alignofState();
+        if ( XXH3_initStaticState(workspace + misalign, XXH3_sizeofState() - 1) != NULL
+          || XXH3_initStaticState(workspace + misalign + 1, XXH3_sizeofState() + 62) != NULL
+          || XXH3_initStaticState(workspace + misalign + 1, XXH3_sizeofState() + 63) == NULL
+          || XXH64_initStaticState(workspace, XXH64_sizeofState() - 1) != NULL
+          || XXH32_initStaticState(NULL, XXH32_sizeofState()) != NULL ) {
+            DISPLAY("\rError: initStaticState() accepted a workspace which is too small \n");
+            exit(1);
+    }   }
+}
+
+/* feeds @nbRecords records of typed fields, and compares with the update of their little-endian bytes */
+void BMK_testXXH3_append(size_t nbRecords, U64 seed)
+{
+    XXH3_state_t state, appended;
+    int is128;
+    for (is128 = 0; is128 <= 1; is128++) {
+        size_t n;
+        BMK_resetXXH3(&state, is128, seed, NULL, 0);
+        BMK_resetXXH3(&appended, is128, seed, NULL, 0);
+        for (n = 0; n < nbRecords; n++) {
+            U32 const v32 = (U32)(n * PRIME32);
+            U64 const v64 = n * PRIME64;
+            U8 record[15];
+            size_t i;
+            for (i = 0; i < 4; i++) record[i] = (U8)(v32 >> (8*i));
+            for (i = 0; i < 8; i++) record[4+i] = (U8)(v64 >> (8*i));
+            record[12] = (U8)n;
+            record[13] = (U8)(v32 >> 3);
+            record[14] = (U8)(v32 >> 11);
+            if (is128) {
+                (void)XXH3_128bits_update(&state, record, sizeof(record));
+                (void)XXH3_128bits_append_u32(&appended, v32);
+                (void)XXH3_128bits_append_u64(&appended, v64);
+                (void)XXH3_128bits_append_u8(&appended, (unsigned char)n);
+                (void)XXH3_128bits_append_u16(&appended, (unsigned short)((v32 >> 3) & 0xFFFF));
+            } else {
+                (void)XXH3_64bits_update(&state, record, sizeof(record));
+                (void)XXH3_64bits_append_u32(&appended, v32);
+                (void)XXH3_64bits_append_u64(&appended, v64);
+                (void)XXH3_64bits_append_u8(&appended, (unsigned char)n);
+                (void)XXH3_64bits_append_u16(&appended, (unsigned short)((v32 >> 3) & 0xFFFF));
+            }
+        }
+        if (is128) BMK_checkResult128(XXH3_128bits_digest(&appended), XXH3_128bits_digest(&state));
+        else BMK_checkResult64(XXH3_64bits_digest(&appended), XXH3_64bits_digest(&state));
+    }
+}
+
+/* streams @len bytes as a @prefix, then @chunk-sized updates, digesting along the way */
+void BMK_testXXH3_segments(const U8* data, size_t len, size_t prefix, size_t chunk)
+{
+    XXH3_state_t state;
+    int is128;
+    assert(prefix <= len && chunk > 0);
+    for (is128 = 0; is128 <= 1; is128++) {
+        size_t pos = prefix;
+        BMK_resetXXH3(&state, is128, PRIME64, NULL, 0);
+        (void)(is128 ? XXH3_128bits_update(&state, data, prefix) : XXH3_64bits_update(&state, data, prefix));
+        while (pos < len) {
+            size_t const l = (len - pos < chunk) ? len - pos : chunk;
+            (void)(is128 ? XXH3_128bits_update(&state, data + pos, l) : XXH3_64bits_update(&state, data + pos, l));
+            pos += l;
+            if (is128) BMK_checkResult128(XXH3_128bits_digest(&state), XXH3_128bits_withSeed(data, pos, PRIME64));
+            else BMK_checkResult64(XXH3_64bits_digest(&state), XXH3_64bits_withSeed(data, pos, PRIME64));
+        }
+    }
+}
+
+/* hashes a NUL-terminated string of @len characters, and compares with the hash of its first @len bytes */
+void BMK_testXXH3_cstr(const U8* data, size_t dataSize, size_t len, U64 seed)
+{
+    char* const s = (char*)malloc(len + 1);
+    size_t i;
+    if (s == NULL) {
+        DISPLAY("\rError: not enough memory for C string test \n");
+        exit(1);
+    }
+    for (i = 0; i < len; i++) s[i] = (char)(data[i % dataSize] | 1);
+    s[len] = 0;
+    BMK_checkResult64(XXH3_64bits_cstr_withSeed(s, seed), XXH3_64bits_withSeed(s, len, seed));
+    BMK_checkResult128(XXH3_128bits_cstr_withSeed(s, seed), XXH3_128bits_withSeed(s, len, seed));
+    if (seed == 0) {
+        BMK_checkResult64(XXH3_64bits_cstr(s), XXH3_64bits(s, len));
+        BMK_checkResult128(XXH3_128bits_cstr(s), XXH3_128bits(s, len));
+    }
+    free(s);
+}
+
+/* hashes @len bytes of mixed case, and compares with the hash of their lower case copy */
+void BMK_testXXH3_lowercase(const U8* data, size_t len, U64 seed)
+{
+    U8* const lower = (U8*)calloc(len + 1, 1);   /* never empty, always initialized */
+    XXH3_state_t state;
+    size_t i;
+    if (lower == NULL) {
+        DISPLAY("\rError: not enough memory for case-insensitive test \n");
+        exit(1);
+    }
+    for (i = 0; i < len; i++)
+        lower[i] = (U8)((data[i] >= 'A' && data[i] <= 'Z') ? data[i] - 'A' + 'a' : data[i]);
+    BMK_checkResult64(XXH3_64bits_lowercase_withSeed(data, len, seed), XXH3_64bits_withSeed(lower, len, seed));
+    BMK_checkResult128(XXH3_128bits_lowercase_withSeed(data, len, seed), XXH3_128bits_withSeed(lower, len, seed));
+    if (seed == 0) {
+        BMK_checkResult64(XXH3_64bits_lowercase(data, len), XXH3_64bits(lower, len));
+        BMK_checkResult128(XXH3_128bits_lowercase(data, len), XXH3_128bits(lower, len));
+    }
+    /* mixed with regular updates of already lower case input */
+    (void)XXH3_64bits_reset_withSeed(&state, seed);
+    (void)XXH3_64bits_update(&state, lower, len / 3);
+    (void)XXH3_64bits_update_lowercase(&state, data + len / 3, len - len / 3);
+    BMK_checkResult64(XXH3_64bits_digest(&state), XXH3_64bits_withSeed(lower, len, seed));
+    (void)XXH3_128bits_reset_withSeed(&state, seed);
+    (void)XXH3_128bits_update_lowercase(&state, data, len / 2);
+    (void)XXH3_128bits_update(&state, lower + len / 2, len - len / 2);
+    BMK_checkResult128(XXH3_128bits_digest(&state), XXH3_128bits_withSeed(lower, len, seed));
+    free(lower);
+}
+
+#define SET_NBELEMENTS_MAX 64
+
+/* the documented digest of @nbElements elements, whose 128-bit hashes add up to @sum */
+static XXH128_hash_t BMK_set_reference(XXH128_hash_t sum, U64 nbElements, U64 seed)
+{
+    U8 digestInput[24];
+    XXH64_canonical_t count;
+    XXH128_canonical_t canonicalSum;
+    XXH64_canonicalFromHash(&count, nbElements);
+    XXH128_canonicalFromHash(&canonicalSum, sum);
+    memcpy(digestInput, &count, sizeof(count));
+    memcpy(digestInput + 8, &canonicalSum, sizeof(canonicalSum));
+    return XXH3_128bits_withSeed(digestInput, sizeof(digestInput), seed ^ 0xC2B2AE3D27D4EB4FULL);
+}
+
+/* fingerprints @nbElements slices of @data in different orders, ways, and after removals */
+void BMK_testXXH3_set(const U8* data, size_t nbElements, size_t elementSize, U64 seed)
+{
+    const void* elements[SET_NBELEMENTS_MAX];
+    size_t lengths[SET_NBELEMENTS_MAX];
+    XXH128_hash_t sum = { 0, 0 };
+    XXH128_hash_t half = { 0, 0 };
+    XXH128_hash_t digest;
+    XXH3_set_t set, other;
+    size_t n;
+    assert(nbElements <= SET_NBELEMENTS_MAX);
+    for (n = 0; n < nbElements; n++) {
+        XXH128_hash_t h;
+        elements[n] = data + 5*n;
+        lengths[n] = (n * 37) % 300;
+        h = XXH3_128bits_withSeed(elements[n], lengths[n], seed);
+        sum.low64 += h.low64;
+        sum.high64 += h.high64 + (sum.low64 < h.low64);
+        if (n == nbElements / 2 - 1) half = sum;
+    }
+
+    /* any order gives the documented digest */
+    (void)XXH3_set_init(&set, seed);
+    for (n = 0; n < nbElements; n++) (void)XXH3_set_add(&set, elements[n], lengths[n]);
+    digest = XXH3_set_digest(&set);
+    BMK_checkResult128(digest, BMK_set_reference(sum, nbElements, seed));
+    (void)XXH3_set_init(&set, seed);
+    for (n = nbElements; n > 0; n--) (void)XXH3_set_add(&set, elements[n-1], lengths[n-1]);
+    BMK_checkResult128(XXH3_set_digest(&set), digest);
+    (void)XXH3_set_init(&set, seed);
+    (void)XXH3_set_addGather(&set, elements, lengths, nbElements);
+    BMK_checkResult128(XXH3_set_digest(&set), digest);
+
+    /* remove the second half, or merge two halves */
+    for (n = nbElements / 2; n < nbElements; n++) (void)XXH3_set_remove(&set, elements[n], lengths[n]);
+    BMK_checkResult128(XXH3_set_digest(&set), BMK_set_reference(half, nbElements / 2, seed));
+    (void)XXH3_set_init(&other, seed);
+    (void)XXH3_set_addGather(&other, elements + nbElements / 2, lengths + nbElements / 2, nbElements - nbElements / 2);
+    (void)XXH3_set_merge(&set, &other);
+    BMK_checkResult128(XXH3_set_digest(&set), digest);
+    (void)XXH3_set_init(&other, seed + 1);
+    if (XXH3_set_merge(&set, &other) != XXH_ERROR) {
+        DISPLAY("\rError: XXH3_set_merge() accepted sets of different seeds \n");
+        exit(1);
+    }
+    if ( XXH3_set_init(NULL, seed) != XXH_ERROR
+      || XXH3_set_add(NULL, lengths, 0) != XXH_ERROR
+      || XXH3_set_remove(NULL, lengths, 0) != XXH_ERROR
+      || XXH3_set_addBatch(NULL, lengths, 0, 0) != XXH_ERROR
+      || XXH3_set_addGather(NULL, elements, lengths, 0) != XXH_ERROR
+      || XXH3_set_merge(NULL, &other) != XXH_ERROR
+      || XXH3_set_merge(&set, NULL) != XXH_ERROR ) {
+        DISPLAY("\rError: XXH3 set functions accepted a NULL set \n");
+        exit(1);
+    }
+
+    /* elements are counted with their multiplicity */
+    if (nbElements > 0) (void)XXH3_set_add(&set, elements[0], lengths[0]);
+    for (n = 0; n < nbElements; n++) (void)XXH3_set_remove(&set, elements[n], lengths[n]);
+    if (nbElements > 0) {
+        XXH128_hash_t const h = XXH3_128bits_withSeed(elements[0], lengths[0], seed);
+        BMK_checkResult128(XXH3_set_digest(&set), BMK_set_reference(h, 1, seed));
+        (void)XXH3_set_remove(&set, elements[0], lengths[0]);
+    }
+    (void)XXH3_set_init(&other, seed);
+    BMK_checkResult128(XXH3_set_digest(&set), XXH3_set_digest(&other));
+
+    /* contiguous elements of the same size */
+    (void)XXH3_set_addBatch(&set, data, elementSize, nbElements);
+    (void)XXH3_set_init(&other, seed);
+    for (n = nbElements; n > 0; n--) (void)XXH3_set_add(&other, data + (n-1) * elementSize, elementSize);
+    BMK_checkResult128(XXH3_set_digest(&set), XXH3_set_digest(&other));
+}
+
+/* hashes @nbInputs slices of @data side by side, in batches and as lockstep streams */
+void BMK_testXXH_lanes(const U8* data, size_t dataSize, size_t inputSize, size_t nbInputs, U32 seed)
+{
+    static const size_t chunks[] = { 1, 5, 16, 33, 100 };
+    XXH32_hash_t h32[64];
+    XXH64_hash_t h64[64];
+    size_t const nbLanes = nbInputs < XXH_LANES_MAX ? nbInputs : XXH_LANES_MAX;
+    size_t n;
+    assert(nbInputs <= 64 && nbInputs * inputSize <= dataSize);
+    assert(7 * nbLanes + inputSize <= dataSize);
+
+    /* contiguous inputs of equal size */
+    XXH32_batch(h32, data, inputSize, nbInputs, seed);
+    XXH64_batch(h64, data, inputSize, nbInputs, seed);
+    for (n = 0; n < nbInputs; n++) {
+        BMK_checkResult32(h32[n], XXH32(data + n * inputSize, inputSize, seed));
+        BMK_checkResult64(h64[n], XXH64(data + n * inputSize, inputSize, seed));
+    }
+
+    /* overlapping streams, fed in chunks of varying sizes */
+    if (nbLanes > 0) {
+        const void* inputs[XXH_LANES_MAX];
+        XXH32_lanesState_t state32;
+        XXH64_lanesState_t state64;
+        size_t pos = 0, c = 0;
+        (void)XXH32_lanes_reset(&state32, nbLanes, seed);
+        (void)XXH64_lanes_reset(&state64, nbLanes, seed);
+        while (pos < inputSize) {
+            size_t const len = chunks[c++ % (sizeof(chunks) / sizeof(chunks[0]))];
+            size_t const chunkSize = len < inputSize - pos ? len : inputSize - pos;
+            for (n = 0; n < nbLanes; n++) inputs[n] = data + 7*n + pos;
+            (void)XXH32_lanes_update(&state32, inputs, chunkSize);
+            (void)XXH64_lanes_update(&state64, inputs, chunkSize);
+            pos += chunkSize;
+        }
+        XXH32_lanes_digest(&state32, h32);
+        XXH64_lanes_digest(&state64, h64);
+        for (n = 0; n < nbLanes; n++) {
+            BMK_checkResult32(h32[n], XXH32(data + 7*n, inputSize, seed));
+            BMK_checkResult64(h64[n], XXH64(data + 7*n, inputSize, seed));
+        }
+        if (XXH32_lanes_reset(&state32, 0, seed) != XXH_ERROR
+         || XXH64_lanes_reset(&state64, XXH_LANES_MAX + 1, seed) != XXH_ERROR) {
+            DISPLAY("\rError: XXH32_lanes_reset() accepted an invalid number of lanes \n");
+            exit(1);
+    }   }
+}
+
+/* partitions @nbKeys keys, fixed-width and variable-length, then scatters their row ids in 2 calls */
+void BMK_testXXH3_partition(const U8* data, size_t dataSize, size_t keySize, size_t nbKeys, unsigned bits, U64 seed)
+{
+    size_t const nbPartitions = (size_t)1 << bits;
+    size_t const half = nbKeys / 2;
+    XXH64_hash_t* const hashes = (XXH64_hash_t*)malloc((nbKeys + 1) * sizeof(XXH64_hash_t));
+    XXH32_hash_t* const partitions = (XXH32_hash_t*)malloc((nbKeys + 1) * sizeof(XXH32_hash_t));
+    XXH32_hash_t* const rowIdsBuffer = (XXH32_hash_t*)malloc((nbKeys + 3) * sizeof(XXH32_hash_t));
+    XXH32_hash_t* const rowIds = rowIdsBuffer + 3;   /* partial first line */
+    size_t* const offsets = (size_t*)malloc((nbKeys + 1) * sizeof(size_t));
+    size_t* const histogram = (size_t*)calloc(nbPartitions, sizeof(size_t));
+    size_t* const cursors = (size_t*)malloc(nbPartitions * sizeof(size_t));
+    size_t n, p, sum = 0;
+    if (!hashes || !partitions || !rowIdsBuffer || !offsets || !histogram || !cursors) {
+        DISPLAY("\rError: not enough memory for partition test \n");
+        exit(1);
+    }
+    assert(keySize * nbKeys <= dataSize);
+
+    /* fixed-width keys */
+    if (seed == 0) (void)XXH3_64bits_partition(hashes, partitions, histogram, data, keySize, nbKeys, bits);
+    else (void)XXH3_64bits_withSeed_partition(hashes, partitions, histogram, data, keySize, nbKeys, seed, bits);
+    for (n = 0; n < nbKeys; n++) {
+        BMK_checkResult64(hashes[n], XXH3_64bits_withSeed(data + n * keySize, keySize, seed));
+        BMK_checkResult32(partitions[n], bits ? (XXH32_hash_t)(hashes[n] >> (64 - bits)) : 0);
+        histogram[partitions[n]]--;
+    }
+    for (p = 0; p < nbPartitions; p++) BMK_checkResult64(histogram[p], 0);
+
+    /* variable-length keys, including empty and long ones */
+    offsets[0] = 0;
+    for (n = 0; n < nbKeys; n++) {
+        size_t const len = (n % 97 == 50) ? 250 : (n * 7) % 20;
+        offsets[n+1] = offsets[n] + (offsets[n] + len <= dataSize ? len : 0);
+    }
+    if (seed == 0) (void)XXH3_64bits_partition_varlen(hashes, partitions, histogram, data, offsets, nbKeys, bits);
+    else (void)XXH3_64bits_withSeed_partition_varlen(hashes, partitions, histogram, data, offsets, nbKeys, seed, bits);
+    for (n = 0; n < nbKeys; n++) {
+        BMK_checkResult64(hashes[n], XXH3_64bits_withSeed(data + offsets[n], offsets[n+1] - offsets[n], seed));
+        BMK_checkResult32(partitions[n], bits ? (XXH32_hash_t)(hashes[n] >> (64 - bits)) : 0);
+    }
+    for (p = 0; p < nbPartitions; p++) {
+        cursors[p] = sum;
+        sum += histogram[p];
+    }
+    BMK_checkResult64(sum, nbKeys);
+
+    /* row ids, grouped by partition, in row order within a partition */
+    (void)XXH3_partition_scatter(rowIds, cursors, partitions, half, 0, bits);
+    (void)XXH3_partition_scatter(rowIds, cursors, partitions + half, nbKeys - half, (XXH32_hash_t)half, bits);
+    for (p = 0, sum = 0; p < nbPartitions; p++) {
+        size_t const start = sum;
+        size_t i;
+        sum += histogram[p];
+        BMK_checkResult64(cursors[p], sum);
+        for (i = start; i < sum; i++) {
+            BMK_checkResult32(partitions[rowIds[i]], (XXH32_hash_t)p);
+            if (i > start && rowIds[i] <= rowIds[i-1]) {
+                DISPLAY("\rError: XXH3_partition_scatter() reordered rows of partition %u \n", (unsigned)p);
+                exit(1);
+    }   }   }
+
+    if (XXH3_64bits_partition(hashes, partitions, histogram, data, keySize, nbKeys, XXH3_PARTITION_BITS_MAX + 1) != XXH_ERROR
+     || XXH3_partition_scatter(rowIds, cursors, partitions, nbKeys, 0, XXH3_PARTITION_BITS_MAX + 1) != XXH_ERROR
+     || XXH3_partition_scatter(rowIds, cursors, partitions, nbKeys, 0, 64) != XXH_ERROR) {
+        DISPLAY("\rError: XXH3 partitioning accepted too many partition bits \n");
+        exit(1);
+    }
+    free(cursors);
+    free(histogram);
+    free(offsets);
+    free(rowIdsBuffer);
+    free(partitions);
+    free(hashes);
+}
+
+/* hashes a column of @nbRows rows of up to @maxLen bytes, with a few nulls, alone and chained with another column */
+void BMK_testXXH3_column(const U8* data, size_t dataSize, size_t nbRows, size_t maxLen, U64 seed)
+{
+    XXH64_hash_t* const hashes = (XXH64_hash_t*)malloc((nbRows + 1) * sizeof(XXH64_hash_t));
+    XXH64_hash_t* const seeds = (XXH64_hash_t*)malloc((nbRows + 1) * sizeof(XXH64_hash_t));
+    size_t* const offsets = (size_t*)malloc((nbRows + 1) * sizeof(size_t));
+    XXH32_hash_t* const offsets32 = (XXH32_hash_t*)malloc((nbRows + 1) * sizeof(XXH32_hash_t));
+    unsigned char* const validity = (unsigned char*)malloc(nbRows / 8 + 1);
+    XXH3_column_t columns[2];
+    size_t n;
+    if (!hashes || !seeds || !offsets || !offsets32 || !validity) {
+        DISPLAY("\rError: not enough memory for column test \n");
+        exit(1);
+    }
+
+    /* mostly up to maxLen, a few up to 300; equal lengths when maxLen is a power of 2 */
+    offsets[0] = 0;
+    for (n = 0; n < nbRows; n++) {
+        size_t const len = !(maxLen & (maxLen - 1)) ? maxLen
+                         : (n % 13 == 5) ? (n * 7) % 301 : (n * 37 + 11) % (maxLen + 1);
+        offsets[n+1] = offsets[n] + ((offsets[n] + len <= dataSize) ? len : 0);
+    }
+    for (n = 0; n <= nbRows; n++) offsets32[n] = (XXH32_hash_t)offsets[n];
+    for (n = 0; n <= nbRows; n++) seeds[n] = seed + n;
+    for (n = 0; n < nbRows / 8 + 1; n++) validity[n] = (unsigned char)~(1U << (n % 8));
+
+    /* per-row seeds, without and with nulls */
+    XXH3_64bits_column(hashes, data, offsets, NULL, seeds, nbRows);
+    for (n = 0; n < nbRows; n++)
+        BMK_checkResult64(hashes[n], XXH3_64bits_withSeed(data + offsets[n], offsets[n+1] - offsets[n], seeds[n]));
+    XXH3_64bits_column(hashes, data, offsets, validity, seeds, nbRows);
+    for (n = 0; n < nbRows; n++) {
+        XXH64_hash_t const h = ((validity[n / 8] >> (n % 8)) & 1)
+                             ? XXH3_64bits_withSeed(data + offsets[n], offsets[n+1] - offsets[n], seeds[n])
+                             : ~XXH3_64bits_withSeed(NULL, 0, seeds[n]);
+        BMK_checkResult64(hashes[n], h);
+    }
+    /* 32-bit offsets, in place */
+    XXH3_64bits_column32(seeds, data, offsets32, validity, seeds, nbRows);
+    for (n = 0; n < nbRows; n++) BMK_checkResult64(seeds[n], hashes[n]);
+
+    /* in place, chained with a second column of the same rows in reverse order,
+     * with 32-bit offsets, without seeds */
+    for (n = 0; n <= nbRows; n++) offsets32[n] = (XXH32_hash_t)(offsets[nbRows] - offsets[nbRows - n]);
+    columns[0].data = data; columns[0].offsets = offsets; columns[0].offsetSize = sizeof(size_t);
+    columns[0].validity = validity;
+    columns[1].data = data; columns[1].offsets = offsets32; columns[1].offsetSize = sizeof(XXH32_hash_t);
+    columns[1].validity = NULL;
+    XXH3_64bits_columns(hashes, columns, 2, nbRows, seed);
+    for (n = 0; n < nbRows; n++) {
+        XXH64_hash_t const h = ((validity[n / 8] >> (n % 8)) & 1)
+                             ? XXH3_64bits_withSeed(data + offsets[n], offsets[n+1] - offsets[n], seed)
+                             : ~XXH3_64bits_withSeed(NULL, 0, seed);
+        BMK_checkResult64(hashes[n], XXH3_64bits_withSeed(data + offsets32[n], offsets32[n+1] - offsets32[n], h));
+    }
+    XXH3_64bits_columns(hashes, columns, 0, nbRows, seed);
+    for (n = 0; n < nbRows; n++) BMK_checkResult64(hashes[n], seed);
+    if (seed == 0) {
+        XXH3_64bits_column(hashes, data, offsets, NULL, NULL, nbRows);
+        for (n = 0; n < nbRows; n++)
+            BMK_checkResult64(hashes[n], XXH3_64bits(data + offsets[n], offsets[n+1] - offsets[n]));
+    }
+    free(validity);
+    free(offsets32);
+    free(offsets);
+    free(seeds);
+    free(hashes);
+}
+
+/* hashes @nbKeys integers of each size read from @data, one by one and as arrays */
+void BMK_testXXH3_int(const U8* data, size_t dataSize, size_t nbKeys, U64 seed)
+{
+    XXH64_hash_t* const hashes = (XXH64_hash_t*)malloc((nbKeys + 1) * sizeof(XXH64_hash_t));
+    XXH32_hash_t* const keys32 = (XXH32_hash_t*)malloc((nbKeys + 1) * sizeof(XXH32_hash_t));
+    XXH64_hash_t* const keys64 = (XXH64_hash_t*)malloc((nbKeys + 1) * sizeof(XXH64_hash_t));
+    XXH128_hash_t* const keys128 = (XXH128_hash_t*)malloc((nbKeys + 1) * sizeof(XXH128_hash_t));
+    size_t n, i;
+    if (!hashes || !keys32 || !keys64 || !keys128) {
+        DISPLAY("\rError: not enough memory for integer test \n");
+        exit(1);
+    }
+    assert(nbKeys * 16 <= dataSize);
+
+    /* key n is made of the little-endian bytes at data + n * sizeof(key) */
+    for (n = 0; n <= nbKeys; n++) {
+        keys32[n] = 0; keys64[n] = 0; keys128[n].low64 = 0; keys128[n].high64 = 0;
+    }
+    for (n = 0; n < nbKeys; n++) {
+        for (i = 0; i < 4; i++) keys32[n] |= (XXH32_hash_t)data[4*n + i] << (8 * i);
+        for (i = 0; i < 8; i++) keys64[n] |= (XXH64_hash_t)data[8*n + i] << (8 * i);
+        for (i = 0; i < 8; i++) keys128[n].low64 |= (XXH64_hash_t)data[16*n + i] << (8 * i);
+        for (i = 0; i < 8; i++) keys128[n].high64 |= (XXH64_hash_t)data[16*n + 8 + i] << (8 * i);
+    }
+
+    for (n = 0; n < nbKeys; n++) {
+        BMK_checkResult64(XXH3_hash_u32_withSeed(keys32[n], seed), XXH3_64bits_withSeed(data + 4*n, 4, seed));
+        BMK_checkResult64(XXH3_hash_u64_withSeed(keys64[n], seed), XXH3_64bits_withSeed(data + 8*n, 8, seed));
+        BMK_checkResult64(XXH3_hash_u128_withSeed(keys128[n], seed), XXH3_64bits_withSeed(data + 16*n, 16, seed));
+    }
+    hashes[nbKeys] = 0;
+    XXH3_hash_u32_withSeed_batch(hashes, keys32, nbKeys, seed);
+    for (n = 0; n < nbKeys; n++) BMK_checkResult64(hashes[n], XXH3_64bits_withSeed(data + 4*n, 4, seed));
+    XXH3_hash_u64_withSeed_batch(hashes, keys64, nbKeys, seed);
+    for (n = 0; n < nbKeys; n++) BMK_checkResult64(hashes[n], XXH3_64bits_withSeed(data + 8*n, 8, seed));
+    XXH3_hash_u128_withSeed_batch(hashes, keys128, nbKeys, seed);
+    for (n = 0; n < nbKeys; n++) BMK_checkResult64(hashes[n], XXH3_64bits_withSeed(data + 16*n, 16, seed));
+    BMK_checkResult64(hashes[nbKeys], 0);   /* nothing written past the end */
+    if (seed == 0) {
+        XXH3_hash_u32_batch(hashes, keys32, nbKeys);
+        for (n = 0; n < nbKeys; n++) BMK_checkResult64(hashes[n], XXH3_hash_u32(keys32[n]));
+        XXH3_hash_u64_batch(hashes, keys64, nbKeys);
+        for (n = 0; n < nbKeys; n++) BMK_checkResult64(hashes[n], XXH3_hash_u64(keys64[n]));
+        XXH3_hash_u128_batch(hashes, keys128, nbKeys);
+        for (n = 0; n < nbKeys; n++) BMK_checkResult64(hashes[n], XXH3_hash_u128(keys128[n]));
+        for (n = 0; n < nbKeys; n++) BMK_checkResult64(hashes[n], XXH3_64bits(data + 16*n, 16));
+    }
+    free(keys128);
+    free(keys64);
+    free(keys32);
+    free(hashes);
+}
+
 #define SECRET_SAMPLE_NBBYTES 4
 typedef struct { U8 byte[SECRET_SAMPLE_NBBYTES]; } verifSample_t;
 
@@ -1209,6 +2361,8 @@ static void BMK_sanityCheck(void)
     BMK_testXXH32(sanityBuffer, 14, PRIME32, 0x6AF1D1FE);
     BMK_testXXH32(sanityBuffer,222, 0,       0x5BD11DBD);
     BMK_testXXH32(sanityBuffer,222, PRIME32, 0x58803C5F);
+    BMK_testXXH32(sanityBuffer,SANITY_BUFFER_SIZE, 0,       0x4C8A9773);
+    BMK_testXXH32(sanityBuffer,SANITY_BUFFER_SIZE, PRIME32, 0x6D5366F6);
 
     BMK_testXXH64(NULL        ,  0, 0,       0xEF46DB3751D8E999ULL);
     BMK_testXXH64(NULL        ,  0, PRIME32, 0xAC75FDA2929B17EFULL);
@@ -1269,6 +2423,46 @@ static void BMK_sanityCheck(void)
         BMK_testXXH3_withSecret(sanityBuffer,64*10*3, secret, secretSize, 0xD4989A002E9850ABULL);  /* exactly 3 full blocks, not a multiple of 256 */
     }
 
+    /* XXH3 with Secret and Seed: seed up to 240 bytes, secret beyond */
+    {   const void* const secret = sanityBuffer + 7;
+        const size_t secretSize = XXH3_SECRET_SIZE_MIN + 11;
+        static const size_t lengths[] = { 0, 1, 6, 12, 24, 48, 80, 195, 240, 241, 403, 512, 2048, 2367 };
+        size_t n;
+        for (n = 0; n < sizeof(lengths) / sizeof(lengths[0]); n++) {
+            const void* const data = lengths[n] ? sanityBuffer : NULL;
+            BMK_testXXH3_withSecretandSeed(data, lengths[n], secret, secretSize, 0);
+            BMK_testXXH3_withSecretandSeed(data, lengths[n], secret, secretSize, PRIME64);
+        }
+    }
+
+    /* XXH3 batch: every short length, full groups of 8 keys and partial ones */
+    {   size_t keySize;
+        for (keySize = 0; keySize <= 256; keySize++) {
+            size_t const nbKeys = keySize % BATCH_NBKEYS_MAX + 1;
+            assert(sizeof(sanityBuffer) >= 1 + keySize * BATCH_NBKEYS_MAX);
+            BMK_testXXH3_batch(sanityBuffer + 1, keySize, BATCH_NBKEYS_MAX, 0);
+            BMK_testXXH3_batch(sanityBuffer + 1, keySize, nbKeys, PRIME64);
+        }
+        BMK_testXXH3_batch(NULL,         0, 0, 0);
+        BMK_testXXH3_batch(sanityBuffer, 403, 5, PRIME64);  /* long keys */
+    }
+
+    /* XXH3 gather: keys of all length classes, interleaved, over several groups */
+    {   const void* keys[GATHER_NBKEYS];
+        size_t lengths[GATHER_NBKEYS];
+        size_t n;
+        for (n = 0; n < GATHER_NBKEYS; n++) {
+            lengths[n] = (n * 97) % 300;
+            keys[n] = lengths[n] ? sanityBuffer + (n * 41) % 64 : NULL;
+        }
+        lengths[7] = 2000;  /* long key */
+        keys[7] = sanityBuffer + 3;
+        BMK_testXXH3_gather(keys, lengths, GATHER_NBKEYS, 0);
+        BMK_testXXH3_gather(keys, lengths, GATHER_NBKEYS, PRIME64);
+        BMK_testXXH3_gather(keys + 1, lengths + 1, 5, PRIME32);
+        BMK_testXXH3_gather(NULL, NULL, 0, 0);
+    }
+
     /* XXH128 */
     {   XXH128_hash_t const expected = { 0x1F17545BCE1061F1ULL, 0x07FD4E968E916AE1ULL };
         BMK_testXXH128(NULL,           0, 0,     expected);         /* empty string */
@@ -1369,6 +2563,215 @@ static void BMK_sanityCheck(void)
     }
 
 
+    /* XXH3-T: empty, single leaf, and leaves finishing on and off a leaf boundary */
+    {   size_t const treeBufferSize = 3 * XXH3_TREE_LEAF_SIZE + 1000;
+        U8* const treeBuffer = (U8*)malloc(treeBufferSize);
+        assert(treeBuffer != NULL);
+        BMK_fillTestBuffer(treeBuffer, treeBufferSize);
+        {   XXH128_hash_t const expected = { 0x85C409BC534D2C9BULL, 0x07394E87FDE842DAULL };
+            BMK_testXXH3_tree(NULL, 0, 0, expected);
+        }
+        {   XXH128_hash_t const expected = { 0xF9AFC887E11A67B2ULL, 0x3F88AC8505E1866CULL };
+            BMK_testXXH3_tree(treeBuffer, 2367, PRIME64, expected);
+        }
+        {   XXH128_hash_t const expected = { 0x31B0E4C7B9393391ULL, 0xC39165DD8C3D49B0ULL };
+            BMK_testXXH3_tree(treeBuffer, 2 * XXH3_TREE_LEAF_SIZE, 0, expected);
+        }
+        {   XXH128_hash_t const expected = { 0x6D64E152405E46FAULL, 0x4C00D778C9582E87ULL };
+            BMK_testXXH3_tree(treeBuffer, treeBufferSize, PRIME64, expected);
+        }
+        free(treeBuffer);
+    }
+
+
+    /* XXH3 Merkle tree: empty, a single leaf, a power of 2 of leaves, and uneven ones */
+    {   XXH128_hash_t const expected = { 0x1F17545BCE1061F1ULL, 0x07FD4E968E916AE1ULL };
+        BMK_testXXH3_merkle(sanityBuffer,    0, 64, 0, expected);
+    }
+    {   XXH128_hash_t const expected = { 0x6BFD0C5DFCDEBD54ULL, 0x2247FD24E5F07409ULL };
+        BMK_testXXH3_merkle(sanityBuffer,   50, 64, PRIME64, expected);
+    }
+    {   XXH128_hash_t const expected = { 0xAC3D6AAA09A5573BULL, 0xC77F7D1D9C90AC2CULL };
+        BMK_testXXH3_merkle(sanityBuffer, 2048, 64, 0, expected);
+    }
+    {   XXH128_hash_t const expected = { 0xD7044305B6C9856DULL, 0x1E86E9B22FDEF141ULL };
+        BMK_testXXH3_merkle(sanityBuffer, 2367, 64, PRIME64, expected);
+    }
+    {   XXH128_hash_t const expected = { 0x0233A580CD2A8F2DULL, 0x9595E3CF8D124947ULL };
+        BMK_testXXH3_merkle(sanityBuffer, 2367, 300, 0, expected);
+    }
+
+
+    /* XXH3 copy: short, mid-size, and long inputs spanning several chunks, to an unaligned destination */
+    {   size_t const copyBufferSize = 3 * 8192 + 2367;
+        U8* const copySrc = (U8*)malloc(copyBufferSize);
+        U8* const copyDst = (U8*)malloc(copyBufferSize + 1);
+        assert(copySrc != NULL && copyDst != NULL);
+        BMK_fillTestBuffer(copySrc, copyBufferSize);
+        BMK_testXXH3_copy(copySrc, 0, copyDst + 1);
+        BMK_testXXH3_copy(copySrc, 1, copyDst + 1);
+        BMK_testXXH3_copy(copySrc, 240, copyDst + 1);
+        BMK_testXXH3_copy(copySrc, 241, copyDst + 1);
+        BMK_testXXH3_copy(copySrc, 2367, copyDst);
+        BMK_testXXH3_copy(copySrc + 3, copyBufferSize - 3, copyDst + 1);
+        free(copyDst);
+        free(copySrc);
+    }
+
+
+    /* XXH3 scatter-gather: short, mid-size and long concatenations */
+    BMK_testXXH3_vec(sanityBuffer,    0, 0);
+    BMK_testXXH3_vec(sanityBuffer,    1, PRIME64);
+    BMK_testXXH3_vec(sanityBuffer,  100, 0);
+    BMK_testXXH3_vec(sanityBuffer,  240, PRIME64);
+    BMK_testXXH3_vec(sanityBuffer,  241, 0);
+    BMK_testXXH3_vec(sanityBuffer, 2048, PRIME64);
+    BMK_testXXH3_vec(sanityBuffer, 2367, 0);
+    BMK_testXXH3_vec(sanityBuffer, 2367, PRIME64);
+
+
+    /* XXH3 zero runs: within the internal buffer, across it, and over several blocks */
+    {   static const size_t zeroRuns[] = { 0, 1, 100, 255, 256, 257, 1000, 1024, 5000, 70000 };
+        static const size_t prefixes[] = { 0, 13, 200, 256, 2367 };
+        size_t const nbZerosMax = 70000;
+        U8* const zeros = (U8*)calloc(nbZerosMax, 1);
+        size_t z, p;
+        assert(zeros != NULL);
+        for (z = 0; z < sizeof(zeroRuns) / sizeof(zeroRuns[0]); z++) {
+            for (p = 0; p < sizeof(prefixes) / sizeof(prefixes[0]); p++) {
+                BMK_testXXH3_updateZeros(sanityBuffer, prefixes[p], zeros, zeroRuns[z], (p & 1) ? PRIME64 : 0);
+        }   }
+        free(zeros);
+    }
+
+    /* XXH3 multi-seed: every length class of the short kernel, and long inputs */
+    {   static const size_t lengths[] = { 0, 1, 3, 4, 8, 9, 16, 17, 100, 128, 129, 240, 241, 1024, 2048, 2367 };
+        size_t l;
+        for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            BMK_testXXH3_withSeeds(sanityBuffer, lengths[l]);
+    }   }
+
+    /* XXH3 dual-width: short inputs, partial and full blocks, with and without seed */
+    {   static const size_t lengths[] = { 0, 1, 16, 17, 128, 129, 240, 241, 1024, 1087, 2048, 2367 };
+        size_t l;
+        for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            BMK_testXXH3_dual(sanityBuffer, lengths[l], 0);
+            BMK_testXXH3_dual(sanityBuffer, lengths[l], PRIME64);
+    }   }
+
+    /* XXH3 packed states: short, buffered, and past full blocks */
+    {   static const size_t splits[] = { 0, 1, 100, 240, 241, 255, 256, 257, 300, 1024, 1087, 2000, 2367 };
+        size_t n;
+        for (n = 0; n < sizeof(splits) / sizeof(splits[0]); n++) {
+            BMK_testXXH3_packState(sanityBuffer, SANITY_BUFFER_SIZE, splits[n], 0, NULL, 0);
+            BMK_testXXH3_packState(sanityBuffer, SANITY_BUFFER_SIZE, splits[n], PRIME64, NULL, 0);
+            BMK_testXXH3_packState(sanityBuffer, SANITY_BUFFER_SIZE, splits[n], 0, sanityBuffer + 7, XXH3_SECRET_SIZE_MIN + 11);
+            BMK_testXXH3_packState(sanityBuffer, splits[n], splits[n], PRIME64, NULL, 0);
+    }   }
+
+    /* streaming by stripe-aligned and unaligned chunks, past block boundaries */
+    {   static const size_t prefixes[] = { 0, 1, 63, 64, 250, 256, 300 };
+        static const size_t chunks[] = { 64, 100, 320, 1024, 1088 };
+        size_t p, c;
+        for (p = 0; p < sizeof(prefixes) / sizeof(prefixes[0]); p++)
+            for (c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++)
+                BMK_testXXH3_segments(sanityBuffer, SANITY_BUFFER_SIZE, prefixes[p], chunks[c]);
+    }
+
+    /* typed appends: short, and across buffer flushes and blocks */
+    {   static const size_t nbRecords[] = { 0, 1, 16, 17, 18, 200 };
+        size_t n;
+        for (n = 0; n < sizeof(nbRecords) / sizeof(nbRecords[0]); n++) {
+            BMK_testXXH3_append(nbRecords[n], 0);
+            BMK_testXXH3_append(nbRecords[n], PRIME64);
+    }   }
+
+    /* NUL-terminated strings: short, and across the streamed chunks */
+    {   static const size_t lengths[] = { 0, 1, 16, 17, 240, 241, 4096, 8191, 8192, 8193, 16384, 20000 };
+        size_t l;
+        for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            BMK_testXXH3_cstr(sanityBuffer, SANITY_BUFFER_SIZE, lengths[l], 0);
+            BMK_testXXH3_cstr(sanityBuffer, SANITY_BUFFER_SIZE, lengths[l], PRIME64);
+    }   }
+
+    /* ASCII case-insensitive hashing: every byte value, short and streamed */
+    {   static const size_t lengths[] = { 0, 1, 3, 16, 17, 128, 129, 240, 241, 1024, SANITY_BUFFER_SIZE };
+        size_t l;
+        for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            BMK_testXXH3_lowercase(sanityBuffer, lengths[l], 0);
+            BMK_testXXH3_lowercase(sanityBuffer, lengths[l], PRIME64);
+    }   }
+
+    /* set digests: empty, small and large elements */
+    {   static const size_t nbElements[] = { 0, 1, 2, 7, SET_NBELEMENTS_MAX };
+        static const size_t elementSizes[] = { 0, 4, 241, 241, 33 };   /* all within sanityBuffer */
+        size_t n;
+        for (n = 0; n < sizeof(nbElements) / sizeof(nbElements[0]); n++) {
+            BMK_testXXH3_set(sanityBuffer, nbElements[n], elementSizes[n], 0);
+            BMK_testXXH3_set(sanityBuffer, nbElements[n], elementSizes[n], PRIME64);
+    }   }
+
+    /* multi-lane XXH32 and XXH64: partial groups, stripe boundaries, and tails */
+    {   static const size_t inputSizes[] = { 0, 1, 15, 16, 17, 31, 33, 64, 100, 1000, 2200 };
+        static const size_t nbInputs[]   = { 1, 7, 16, 17, 33,  8, 16, 20,  17,    2,    1 };
+        size_t n;
+        for (n = 0; n < sizeof(inputSizes) / sizeof(inputSizes[0]); n++) {
+            BMK_testXXH_lanes(sanityBuffer, SANITY_BUFFER_SIZE, inputSizes[n], nbInputs[n], 0);
+            BMK_testXXH_lanes(sanityBuffer, SANITY_BUFFER_SIZE, inputSizes[n], nbInputs[n], PRIME32);
+    }   }
+
+    /* hash partitioning: no partition, direct and staged scatters, empty and long keys */
+    {   size_t const partitionBufferSize = 24000;
+        U8* const partitionBuffer = (U8*)malloc(partitionBufferSize);
+        assert(partitionBuffer != NULL);
+        BMK_fillTestBuffer(partitionBuffer, partitionBufferSize);
+        BMK_testXXH3_partition(partitionBuffer, partitionBufferSize,   4, 1000,  0, 0);
+        BMK_testXXH3_partition(partitionBuffer, partitionBufferSize,   8, 3000,  6, PRIME64);
+        BMK_testXXH3_partition(partitionBuffer, partitionBufferSize,   4, 6000,  7, 0);
+        BMK_testXXH3_partition(partitionBuffer, partitionBufferSize,   0,   10,  3, PRIME64);
+        BMK_testXXH3_partition(partitionBuffer, partitionBufferSize,  17,  300, 16, 0);
+        BMK_testXXH3_partition(partitionBuffer, partitionBufferSize, 300,   20,  4, PRIME64);
+        free(partitionBuffer);
+    }
+
+    /* columnar hashing: sorted and in-order micro-batches, single length class, partial last batch */
+    {   size_t const columnBufferSize = 24000;
+        U8* const columnBuffer = (U8*)malloc(columnBufferSize);
+        assert(columnBuffer != NULL);
+        BMK_fillTestBuffer(columnBuffer, columnBufferSize);
+        BMK_testXXH3_column(columnBuffer, columnBufferSize,   0,  20, 0);
+        BMK_testXXH3_column(columnBuffer, columnBufferSize,   1,  20, PRIME64);
+        BMK_testXXH3_column(columnBuffer, columnBufferSize, 300,  20, 0);
+        BMK_testXXH3_column(columnBuffer, columnBufferSize, 200, 300, PRIME64);
+        BMK_testXXH3_column(columnBuffer, columnBufferSize, 130,   8, PRIME32);
+        BMK_testXXH3_column(columnBuffer, columnBufferSize, 100,  64, 0);
+        free(columnBuffer);
+    }
+
+    /* integer keys: full and partial groups of 8 */
+    {   static const size_t nbKeys[] = { 0, 1, 7, 8, 9, 100 };
+        size_t n;
+        for (n = 0; n < sizeof(nbKeys) / sizeof(nbKeys[0]); n++) {
+            BMK_testXXH3_int(sanityBuffer, SANITY_BUFFER_SIZE, nbKeys[n], 0);
+            BMK_testXXH3_int(sanityBuffer, SANITY_BUFFER_SIZE, nbKeys[n], PRIME64);
+    }   }
+
+    /* caller-provided storage */
+    BMK_testStaticStates(sanityBuffer, SANITY_BUFFER_SIZE);
+
+    /* saved states: inside and past the internal buffers */
+    {   static const size_t splits[] = { 0, 1, 15, 16, 31, 32, 33, 100, 240, 241, 256, 257, 300, 1024, 1087, 2000, 2367 };
+        size_t n;
+        for (n = 0; n < sizeof(splits) / sizeof(splits[0]); n++) {
+            BMK_testXXH_saveState(sanityBuffer, SANITY_BUFFER_SIZE, splits[n], 0);
+            BMK_testXXH_saveState(sanityBuffer, SANITY_BUFFER_SIZE, splits[n], PRIME64);
+            BMK_testXXH3_saveState(sanityBuffer, SANITY_BUFFER_SIZE, splits[n], 0, NULL, 0);
+            BMK_testXXH3_saveState(sanityBuffer, SANITY_BUFFER_SIZE, splits[n], PRIME64, NULL, 0);
+            BMK_testXXH3_saveState(sanityBuffer, SANITY_BUFFER_SIZE, splits[n], 0, sanityBuffer + 7, XXH3_SECRET_SIZE_MIN + 11);
+            BMK_testXXH3_saveState(sanityBuffer, splits[n], splits[n], PRIME64, NULL, 0);
+    }   }
+
+
     /* secret generator */
     {   verifSample_t const expected = { { 0xB8, 0x26, 0x83, 0x7E } };
         BMK_testSecretGenerator(NULL, 0, expected);
@@ -1418,10 +2821,88 @@ typedef union {
     XXH128_hash_t xxh128;
 } Multihash;
 
+/*
+ * Position in a file being hashed, and bounds of its current data region.
+ * Holes are only looked for in regular files with fewer blocks than their size.
+ */
+typedef struct {
+    int sparse;
+    U64 pos;
+    U64 dataEnd;
+    U64 fileSize;
+} XSUM_sparseCursor;
+
+static void XSUM_sparseInit(XSUM_sparseCursor* cursor, FILE* inFile)
+{
+    memset(cursor, 0, sizeof(*cursor));
+#if XSUM_SPARSE_FILES
+    {   struct stat st;
+        if (fstat(fileno(inFile), &st) == 0
+          && S_ISREG(st.st_mode)
+          && (U64)st.st_blocks * 512 < (U64)st.st_size
+          && ftello(inFile) == 0) {
+            cursor->sparse = 1;
+            cursor->fileSize = (U64)st.st_size;
+    }   }
+#else
+    (void)inFile;
+#endif
+}
+
+/*
+ * At the end of a data region, finds the next one, and moves `inFile` to it.
+ * Returns the size of the hole skipped, which reads as zeros.
+ * Falls back to reading everything if the file system can't tell.
+ */
+static U64 XSUM_sparseSkipHole(XSUM_sparseCursor* cursor, FILE* inFile)
+{
+#if XSUM_SPARSE_FILES
+    if (cursor->sparse && cursor->pos == cursor->dataEnd) {
+        int const fd = fileno(inFile);
+        off_t data = lseek(fd, (off_t)cursor->pos, SEEK_DATA);
+        off_t hole = (off_t)cursor->fileSize;
+        if (data < 0 && errno == ENXIO) data = (off_t)cursor->fileSize;   /* trailing hole */
+        if (data >= 0 && (U64)data < cursor->pos) data = -1;
+        if (data >= 0 && (U64)data < cursor->fileSize) {
+            hole = lseek(fd, data, SEEK_HOLE);
+            if (hole <= data) data = -1;   /* no progress */
+        }
+        if (data < 0 || fseeko(inFile, data, SEEK_SET) != 0) {
+            cursor->sparse = 0;
+            if (fseeko(inFile, (off_t)cursor->pos, SEEK_SET) != 0) {
+                DISPLAY("Error: a failure occurred reading the input file.\n");
+                exit(1);
+            }
+            return 0;
+        }
+        {   U64 const holeSize = (U64)data - cursor->pos;
+            cursor->pos = (U64)data;
+            cursor->dataEnd = (U64)hole;
+            return holeSize;
+    }   }
+#else
+    (void)cursor; (void)inFile;
+#endif
+    return 0;
+}
+
+static size_t XSUM_sparseRead(XSUM_sparseCursor* cursor, FILE* inFile, void* buffer, size_t blockSize)
+{
+    size_t toRead = blockSize;
+    size_t readSize;
+    if (cursor->sparse && cursor->dataEnd - cursor->pos < toRead)
+        toRead = (size_t)(cursor->dataEnd - cursor->pos);
+    readSize = fread(buffer, 1, toRead, inFile);
+    cursor->pos += readSize;
+    return readSize;
+}
+
 /*
  * XSUM_hashStream:
  * Reads data from `inFile`, generating an incremental hash of type hashType,
  * using `buffer` of size `blockSize` for temporary storage.
+ * Holes of sparse files are not read: XXH128 skips them arithmetically,
+ * XXH32 and XXH64 are fed zeros from `buffer`.
  */
 static Multihash
 XSUM_hashStream(FILE* inFile,
@@ -1431,15 +2912,47 @@ XSUM_hashStream(FILE* inFile,
     XXH32_state_t state32;
     XXH64_state_t state64;
     XXH3_state_t state128;
+    XSUM_sparseCursor cursor;
 
     /* Init */
     (void)XXH32_reset(&state32, XXHSUM32_DEFAULT_SEED);
     (void)XXH64_reset(&state64, XXHSUM64_DEFAULT_SEED);
     (void)XXH3_128bits_reset(&state128);
+    XSUM_sparseInit(&cursor, inFile);
 
     /* Load file & update hash */
     {   size_t readSize;
-        while ((readSize = fread(buffer, 1, blockSize, inFile)) > 0) {
+        U64 holeSize;
+        for (;;) {
+            /* holes read as zeros */
+            holeSize = XSUM_sparseSkipHole(&cursor, inFile);
+            if (holeSize > 0 && hashType != algo_xxh128)
+                memset(buffer, 0, (holeSize < blockSize) ? (size_t)holeSize : blockSize);
+            while (holeSize > 0) {
+                size_t const runMax = (hashType == algo_xxh128) ? (size_t)-1 : blockSize;
+                size_t const runSize = (holeSize < runMax) ? (size_t)holeSize : runMax;
+                switch(hashType)
+                {
+                case algo_xxh32:
+                    (void)XXH32_update(&state32, buffer, runSize);
+                    break;
+                case algo_xxh64:
+                    (void)XXH64_update(&state64, buffer, runSize);
+                    break;
+                case algo_xxh128:
+                    (void)XXH3_128bits_updateZeros(&state128, runSize);
+                    break;
+                default:
+                    assert(0);
+                }
+                holeSize -= runSize;
+            }
+
+            readSize = XSUM_sparseRead(&cursor, inFile, buffer, blockSize);
+            if (readSize == 0) {
+                if (cursor.sparse && cursor.pos == cursor.dataEnd && cursor.pos < cursor.fileSize) continue;
+                break;
+            }
             switch(hashType)
             {
             case algo_xxh32: